@@ -11,6 +11,15 @@
  * @property {number} minTileSize - Minimum tile dimension (default: 50mm)
  */
 
+// Radial rotations per angle-list message; progress is reported per batch
+const RADIAL_ANGLES_PER_MESSAGE = 4;
+
+// Scanline length of a radial toolpath: the worker's strip spans the terrain in X at gridStep
+function radialPointsPerLine(terrainBounds, xStep, gridStep) {
+    const stripWidth = Math.ceil((terrainBounds.max.x - terrainBounds.min.x) / gridStep) + 1;
+    return Math.ceil(stripWidth / xStep);
+}
+
 /**
  * Main class for rasterizing geometry and generating toolpaths using WebGPU
  * Manages WebGPU worker lifecycle and provides async API for conversions
@@ -22,6 +31,8 @@ export class RasterPath {
         this.isInitialized = false;
         this.messageHandlers = new Map();
         this.messageId = 0;
+        this.nextStreamId = 0;
+        this.nextJobId = 0;
         this.deviceCapabilities = null;
 
         // Configuration with defaults
@@ -31,7 +42,7 @@ export class RasterPath {
             tileOverlapMM: config.tileOverlapMM ?? 10,
             autoTiling: config.autoTiling ?? true,
             minTileSize: config.minTileSize ?? 50,
-            parallelWorkers: config.parallelWorkers ?? 4, // Number of workers for radial mode
+            parallelWorkers: config.parallelWorkers ?? 4, // Number of workers for radial mode and tiled planar toolpaths
         };
     }
 
@@ -178,19 +189,35 @@ export class RasterPath {
     }
 
     /**
-     * Convert STL buffer to point mesh
-     * @param {ArrayBuffer} stlBuffer - Binary STL data
+     * Parse an STL file (binary or ASCII) in the worker
+     * An ArrayBuffer is transferred to the worker and detached; a ReadableStream is forwarded chunk by chunk
+     * as it is read, so the whole file never has to be held on this thread. Concurrent parses are independent;
+     * if the stream errors it is cancelled and the promise rejects.
+     * @param {ArrayBuffer|ReadableStream<Uint8Array>} stlSource - STL data
+     * @returns {Promise<{triangles: Float32Array, triangleCount: number, bounds: object}>}
+     */
+    async parseSTL(stlSource) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return this._sendSTL(stlSource, null, 'stl-parsed');
+    }
+
+    /**
+     * Convert STL to point mesh: parses in the worker (see parseSTL()) and rasterizes there without a round trip
+     * @param {ArrayBuffer|ReadableStream<Uint8Array>} stlBuffer - STL data (an ArrayBuffer is detached)
      * @param {number} stepSize - Grid resolution (e.g., 0.05)
      * @param {number} filterMode - 0 for max Z (terrain), 1 for min Z (tool)
      * @param {object} boundsOverride - Optional bounding box {min: {x, y, z}, max: {x, y, z}}
      * @returns {Promise<{positions: Float32Array, pointCount: number, bounds: object}>}
      */
     async rasterizeSTL(stlBuffer, stepSize, filterMode = 0, boundsOverride = null) {
-        // Parse STL to triangles
-        const triangles = this._parseSTL(stlBuffer);
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
 
-        // Rasterize the mesh
-        return this.rasterizeMesh(triangles, stepSize, filterMode, boundsOverride);
+        return this._sendSTL(stlBuffer, { stepSize, filterMode, boundsOverride }, 'rasterize-complete');
     }
 
     /**
@@ -201,15 +228,41 @@ export class RasterPath {
      * @param {number} yStep - Y-axis step size
      * @param {number} zFloor - Z floor value
      * @param {number} gridStep - Grid resolution
-     * @param {object} options - Optional settings {onProgress: (percent, info) => {}}
+     * @param {object} options - Optional settings {onProgress: (percent, info) => {}, terrainBounds, simplifyTolerance, rest, rasterAngle}
      * @returns {Promise<{pathData: Float32Array, numScanlines: number, pointsPerLine: number, generationTime: number}>}
+     *
+     * With simplifyTolerance (mm) set, collinear runs are removed on the GPU before readback and the result is
+     * {vertices, lineOffsets, vertexCount, numScanlines, pointsPerLine, generationTime} instead of pathData:
+     * vertices holds (pointIdx, z) pairs and scanline s owns vertices [lineOffsets[s], lineOffsets[s + 1]).
+     *
+     * When the worker pool is initialized and the page is cross-origin isolated, tiled jobs are spread
+     * across the pool and pathData is backed by a SharedArrayBuffer.
+     *
+     * Rest machining: rest = {previous: {pathData, numScanlines, pointsPerLine, toolPositions, xStep, yStep}, threshold}
+     * or {useStock: true, threshold} keeps only samples where this tool would still remove more than threshold (mm)
+     * of the material left by the previous toolpath (or the stock model). The result is in the simplified layout
+     * (simplifyTolerance defaults to 0) with NaN vertices where the tool lifts out between rest regions.
+     *
+     * rasterAngle (degrees from +X towards +Y) samples the same heightmap along rotated scanlines; the result adds
+     * {rasterAngle, sampleOrigin, scanDirection, stepDirection} so sample (i, s) lies at grid position
+     * sampleOrigin + i * xStep * scanDirection + s * yStep * stepDirection. An array of angles (e.g. [0, 90] for
+     * cross-hatch) shares one terrain upload and resolves to {passes: [...]}. Angled passes run on the primary
+     * worker in row bands (never shared across the pool) and cannot be combined with rest or simplifyTolerance.
      */
     async generatePlanarToolpath(terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, options = {}) {
         if (!this.isInitialized) {
             throw new Error('RasterPath not initialized. Call init() first.');
         }
 
-        const { onProgress, terrainBounds } = options;
+        const { onProgress, terrainBounds, simplifyTolerance = null, rest = null, rasterAngle = null } = options;
+        if (rasterAngle !== null && (rest || simplifyTolerance !== null)) {
+            throw new Error('rasterAngle cannot be combined with rest or simplifyTolerance');
+        }
+
+        // Tiles can only be shared across the pool when SharedArrayBuffer is available
+        const shareTiles = !rest && rasterAngle === null && this.workerPool.length > 1 &&
+            typeof SharedArrayBuffer !== 'undefined' &&
+            globalThis.crossOriginIsolated === true;
 
         return new Promise((resolve, reject) => {
             // Set up progress handler if callback provided
@@ -225,18 +278,524 @@ export class RasterPath {
                 if (onProgress) {
                     this.messageHandlers.delete('toolpath-progress');
                 }
-                resolve(data);
+                if (data.error) {
+                    reject(new Error(data.error));
+                } else if (data.tiledJob) {
+                    this._runToolpathTilesParallel(data.tiledJob, onProgress).then(resolve, reject);
+                } else {
+                    resolve(data);
+                }
             };
 
             this._sendMessage(
                 'generate-toolpath',
-                { terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds },
+                { terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds, shareTiles, simplifyTolerance, rest, rasterAngle },
                 'toolpath-complete',
                 handler
             );
         });
     }
 
+    /**
+     * Generate planar toolpaths for several tools over the same terrain
+     * Sparse tools are concatenated and evaluated in a single dispatch against one terrain upload
+     * (e.g. roughing + finishing + rest passes)
+     * @param {Float32Array} terrainPositions - Terrain point cloud positions
+     * @param {Array<{toolPositions: Float32Array, xStep: number, yStep: number, zFloor: number}>} tools - Per-tool settings
+     * @param {number} gridStep - Grid resolution (shared by terrain and all tools)
+     * @param {object} options - Optional settings {terrainBounds}
+     * @returns {Promise<Array<{pathData: Float32Array, numScanlines: number, pointsPerLine: number, generationTime: number}>>}
+     */
+    async generateToolpathBatch(terrainPositions, tools, gridStep, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        const { terrainBounds } = options;
+
+        return new Promise((resolve, reject) => {
+            const handler = (data) => {
+                resolve(data.results);
+            };
+
+            this._sendMessage(
+                'generate-toolpath-batch',
+                { terrainPositions, tools, gridStep, terrainBounds },
+                'toolpath-batch-complete',
+                handler
+            );
+        });
+    }
+
+    /**
+     * Generate planar toolpath directly from a terrain mesh
+     * Rasterizes the terrain and runs the toolpath pass in a single GPU submission, so the
+     * heightmap is never read back or posted between threads unless requested
+     * @param {Float32Array} terrainTriangles - Unindexed terrain triangles (9 floats per triangle)
+     * @param {Float32Array} toolPositions - Tool raster (sparse XYZ from rasterizeMesh with filterMode 1)
+     * @param {number} xStep - X-axis step size
+     * @param {number} yStep - Y-axis step size
+     * @param {number} zFloor - Z floor value
+     * @param {number} gridStep - Grid resolution
+     * @param {object} options - Optional settings {terrainBounds, returnHeightmap: false}
+     * @returns {Promise<{pathData: Float32Array, numScanlines: number, pointsPerLine: number, generationTime: number, terrain?: object}>}
+     */
+    async generateToolpathFromMesh(terrainTriangles, toolPositions, xStep, yStep, zFloor, gridStep, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        const { terrainBounds = null, returnHeightmap = false } = options;
+
+        return new Promise((resolve, reject) => {
+            const handler = (data) => {
+                resolve(data);
+            };
+
+            this._sendMessage(
+                'generate-toolpath-from-mesh',
+                { triangles: terrainTriangles, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds, returnHeightmap },
+                'toolpath-from-mesh-complete',
+                handler
+            );
+        });
+    }
+
+    /**
+     * Generate an adaptively sampled planar toolpath
+     * Scanlines are probed coarsely, then only intervals that deviate from a straight line by more
+     * than the tolerance are refined, so flat regions collapse to a few vertices
+     * @param {Float32Array} terrainPositions - Terrain point cloud positions (dense)
+     * @param {Float32Array} toolPositions - Tool point cloud positions
+     * @param {number} xStep - X-axis step size
+     * @param {number} yStep - Y-axis step size
+     * @param {number} zFloor - Z floor value
+     * @param {number} gridStep - Grid resolution
+     * @param {number} tolerance - Maximum Z deviation (mm) of the polyline from the dense toolpath
+     * @param {object} options - Settings {terrainBounds (required), coarseStride: 16}
+     * @returns {Promise<{vertices: Float32Array, lineOffsets: Uint32Array, numScanlines: number, pointsPerLine: number, vertexCount: number, probeCount: number, generationTime: number}>}
+     *   vertices holds (pointIdx, z) pairs; scanline s owns vertices [lineOffsets[s], lineOffsets[s + 1])
+     */
+    async generateAdaptiveToolpath(terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, tolerance, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        const { terrainBounds, coarseStride } = options;
+
+        return new Promise((resolve, reject) => {
+            const handler = (data) => {
+                resolve(data);
+            };
+
+            this._sendMessage(
+                'generate-adaptive-toolpath',
+                { terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds, tolerance, coarseStride },
+                'adaptive-toolpath-complete',
+                handler
+            );
+        });
+    }
+
+    /**
+     * Generate Z-level (waterline) zig-zag roughing passes for a list of layer heights
+     * The tool offset surface is computed once on the GPU and every layer is extracted from it in
+     * the same batched job, so the terrain is neither re-rasterized nor re-uploaded per layer
+     * @param {Float32Array} terrainPositions - Terrain point cloud positions (dense)
+     * @param {Float32Array} toolPositions - Tool point cloud positions
+     * @param {number} xStep - Sampling step along each pass
+     * @param {number} yStep - Stepover between passes
+     * @param {number} gridStep - Grid resolution
+     * @param {Array<number>} zLevels - Layer heights (tool tip Z), typically from the top down
+     * @param {object} options - Settings {terrainBounds (required), allowance: 0}
+     * @returns {Promise<{segments: Uint32Array, segmentOffsets: Uint32Array, segmentCount: number, zLevels: Float32Array, numScanlines: number, pointsPerLine: number, generationTime: number}>}
+     *   segments holds (start, end) sample index pairs in cut order (odd scanlines reversed);
+     *   layer k, scanline s owns segments [segmentOffsets[k * numScanlines + s], segmentOffsets[k * numScanlines + s + 1])
+     */
+    async generateZLevelRoughing(terrainPositions, toolPositions, xStep, yStep, gridStep, zLevels, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        const { terrainBounds, allowance = 0 } = options;
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage(
+                'generate-zlevel-roughing',
+                { terrainPositions, toolPositions, xStep, yStep, gridStep, zLevels: Array.from(zLevels), terrainBounds, allowance },
+                'zlevel-roughing-complete',
+                handler
+            );
+        });
+    }
+
+    /**
+     * Create the stock model: a heightmap kept on the GPU that simulated toolpaths cut into
+     * Replaces any existing stock. Cells without material hold -1e10.
+     * @param {object} bounds - Stock bounding box {min: {x,y,z}, max: {x,y,z}}
+     * @param {number} gridStep - Grid resolution, must match the toolpaths simulated against it
+     * @param {object} options - {shape: 'box'|'cylinder', radius, heights}
+     *   'box' is flat at bounds.max.z; 'cylinder' has the given radius about the X axis;
+     *   heights (Float32Array, width x height) starts from a previous stock instead
+     * @returns {Promise<{width: number, height: number, bandRows: number}>}
+     */
+    async createStock(bounds, gridStep, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage('stock-create', { bounds, gridStep, options }, 'stock-ready', handler);
+        });
+    }
+
+    /**
+     * Sweep the tool along a dense planar toolpath and remove the material it passes through
+     * @param {object} toolpath - Result of generateToolpath() {pathData, numScanlines, pointsPerLine}
+     * @param {Float32Array} toolPositions - Tool point cloud used to generate the toolpath
+     * @param {number} xStep - X-axis step size of the toolpath
+     * @param {number} yStep - Y-axis step size of the toolpath
+     * @param {object} pathOrigin - World XY of toolpath sample (0, 0), i.e. the terrain bounds min {x, y}
+     * @returns {Promise<{changedBands: number, bandRows: number, generationTime: number}>}
+     */
+    async simulateToolpath(toolpath, toolPositions, xStep, yStep, pathOrigin) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage(
+                'stock-simulate',
+                {
+                    pathData: toolpath.pathData,
+                    numScanlines: toolpath.numScanlines,
+                    pointsPerLine: toolpath.pointsPerLine,
+                    toolPositions, xStep, yStep, pathOrigin
+                },
+                'stock-simulated',
+                handler
+            );
+        });
+    }
+
+    /**
+     * Read the stock heightmap back
+     * @param {object} options - {dirtyOnly: true} - only return row bands changed since the last read
+     * @returns {Promise<{width: number, height: number, regions: Array<{rowStart: number, rowCount: number, heights: Float32Array}>}>}
+     */
+    async readStock(options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        const { dirtyOnly = true } = options;
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage('stock-read', { dirtyOnly }, 'stock-data', handler);
+        });
+    }
+
+    /**
+     * Release the stock model's GPU buffers
+     */
+    disposeStock() {
+        if (this.worker) {
+            this.worker.postMessage({ type: 'stock-dispose' });
+        }
+    }
+
+    /**
+     * Compute the full-resolution tool-center offset surface once and keep it on the GPU
+     * Scan patterns are then sampled from it with sampleOffsetSurface() instead of re-running the collision kernel.
+     * Replaces any existing offset surface.
+     * @param {Float32Array} terrainPositions - Terrain point cloud positions (dense)
+     * @param {Float32Array} toolPositions - Tool point cloud positions
+     * @param {number} zFloor - Z value where the tool is off the part
+     * @param {number} gridStep - Grid resolution
+     * @param {object} terrainBounds - Terrain bounding box {min: {x,y,z}, max: {x,y,z}}
+     * @returns {Promise<{width: number, height: number, generationTime: number}>}
+     */
+    async createOffsetSurface(terrainPositions, toolPositions, zFloor, gridStep, terrainBounds) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = (data) => {
+                resolve(data);
+            };
+
+            this._sendMessage(
+                'offset-surface-create',
+                { terrainPositions, toolPositions, zFloor, gridStep, terrainBounds },
+                'offset-surface-ready',
+                handler
+            );
+        });
+    }
+
+    /**
+     * Sample the resident offset surface (bilinear) with a scan pattern
+     * @param {object} pattern - {type: 'raster', xStep, yStep, rasterAngle} returns a planar toolpath in the same
+     *   layout as generatePlanarToolpath() with rasterAngle; {type: 'points', points} takes world XY pairs
+     *   (Float32Array) and returns {z: Float32Array}
+     * @returns {Promise<object>}
+     */
+    async sampleOffsetSurface(pattern) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = (data) => {
+                resolve(data);
+            };
+
+            this._sendMessage('offset-surface-sample', { pattern }, 'offset-surface-samples', handler);
+        });
+    }
+
+    /**
+     * Release the resident offset surface
+     */
+    disposeOffsetSurface() {
+        if (this.worker) {
+            this.worker.postMessage({ type: 'offset-surface-dispose' });
+        }
+    }
+
+    /**
+     * Keep a dense terrain on the GPU for queryToolZ()
+     * Replaces any previously loaded terrain.
+     * @param {Float32Array} terrainPositions - Terrain point cloud positions (dense)
+     * @param {number} gridStep - Grid resolution
+     * @param {object} terrainBounds - Terrain bounding box {min: {x,y,z}, max: {x,y,z}}
+     * @returns {Promise<{width: number, height: number}>}
+     */
+    async loadTerrain(terrainPositions, gridStep, terrainBounds) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage('terrain-load', { terrainPositions, gridStep, terrainBounds }, 'terrain-loaded', handler);
+        });
+    }
+
+    /**
+     * Drop-cutter query: tool-center Z at arbitrary XY positions against the loaded terrain, in one dispatch
+     * Off-grid positions take the highest of the surrounding grid tool centers, so they never gouge.
+     * @param {Float32Array|Array<Float32Array>} queries - World XY pairs, or an array of XY polylines
+     * @param {Float32Array} toolPositions - Tool point cloud positions
+     * @param {number} zFloor - Z value where the tool is off the part
+     * @param {object} options - {maxSegmentLength} densifies polylines so no segment is longer (mm)
+     * @returns {Promise<Float32Array|Array<Float32Array>>} Z per point, or XYZ triples per polyline
+     */
+    async queryToolZ(queries, toolPositions, zFloor, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = (data) => {
+                if (data.error) {
+                    reject(new Error(data.error));
+                } else {
+                    resolve(data.z || data.polylines);
+                }
+            };
+
+            this._sendMessage('tool-z-query', { queries, toolPositions, zFloor, options }, 'tool-z-result', handler);
+        });
+    }
+
+    /**
+     * Generate a spiral, rectangular pocket or contour toolpath over the terrain loaded with loadTerrain()
+     * Samples are produced in cut order and evaluated in one dispatch. The pocket's loops are insets of rect;
+     * the contour's loops are offsets of the part outline, offset inside it and then every stepover further in.
+     * @param {object} pattern - {type: 'spiral', pitch, spacing, center: {x, y}, radius},
+     *   {type: 'pocket', stepover, spacing, rect: {min: {x, y}, max: {x, y}}} or
+     *   {type: 'contour', stepover, spacing, offset} (mm)
+     * @param {Float32Array} toolPositions - Tool point cloud positions
+     * @param {number} zFloor - Z value where the tool is off the part
+     * @returns {Promise<{polylines: Array<Float32Array>, pointCount: number, generationTime: number}>}
+     */
+    async generatePatternToolpath(pattern, toolPositions, zFloor) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage('generate-pattern-toolpath', { pattern, toolPositions, zFloor }, 'pattern-toolpath-complete', handler);
+        });
+    }
+
+    /**
+     * Release the terrain loaded with loadTerrain()
+     */
+    disposeTerrain() {
+        if (this.worker) {
+            this.worker.postMessage({ type: 'terrain-dispose' });
+        }
+    }
+
+    /**
+     * Stream a planar toolpath as G-code (or raw binary rows) while it is generated
+     * The worker produces one band of scanlines per pull, so memory stays flat regardless of job size
+     * @param {Float32Array} terrainPositions - Terrain point cloud positions (dense)
+     * @param {Float32Array} toolPositions - Tool point cloud positions
+     * @param {number} xStep - X-axis step size
+     * @param {number} yStep - Y-axis step size
+     * @param {number} zFloor - Z floor value
+     * @param {number} gridStep - Grid resolution
+     * @param {object} options - Settings {terrainBounds (required), format: 'gcode'|'binary', chunkScanlines: 64,
+     *   simplifyTolerance, feedRate, safeZ, decimals: 3}
+     * @returns {Promise<{stream: ReadableStream<Uint8Array>, numScanlines: number, pointsPerLine: number}>}
+     */
+    async streamPlanarToolpath(terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return this._openToolpathStream({
+            mode: 'planar',
+            terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep,
+            ...options
+        });
+    }
+
+    /**
+     * Stream a radial toolpath as G-code with A-axis words (or raw binary rows) while it is generated
+     * Rotations are rasterized and scanned in the worker a batch at a time as the stream is read
+     * @param {Float32Array} terrainTriangles - Terrain mesh triangles
+     * @param {Float32Array} toolPositions - Tool raster (sparse XYZ)
+     * @param {number} xRotationStep - Degrees between each rotation
+     * @param {number} xStep - Sampling step along X-axis
+     * @param {number} zFloor - Z floor value for out-of-bounds
+     * @param {number} gridStep - Rasterization resolution
+     * @param {object} terrainBounds - Terrain bounding box {min: {x,y,z}, max: {x,y,z}}
+     * @param {object} options - Settings {format: 'gcode'|'binary', chunkAngles: 8, feedRate, safeZ, decimals: 3}
+     * @returns {Promise<{stream: ReadableStream<Uint8Array>, numRotations: number, pointsPerLine: number}>}
+     */
+    async streamRadialToolpath(terrainTriangles, toolPositions, xRotationStep, xStep, zFloor, gridStep, terrainBounds, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return this._openToolpathStream({
+            mode: 'radial',
+            triangles: terrainTriangles, toolPositions, xRotationStep, xStep, zFloor, gridStep, terrainBounds,
+            ...options
+        });
+    }
+
+    /**
+     * Open a pull-driven toolpath stream on the primary worker
+     * Internal method - each pull requests exactly one chunk, which gives backpressure end to end
+     */
+    async _openToolpathStream(startData) {
+        // Replies are routed by stream id, so several streams can be open at once
+        const streamId = this.nextStreamId++;
+        const info = await new Promise((resolve) => {
+            this._sendMessage('toolpath-stream-start', { ...startData, streamId }, 'toolpath-stream-ready', resolve);
+        });
+        if (info.error) {
+            throw new Error(info.error);
+        }
+        delete info.streamId;
+
+        const stream = new ReadableStream({
+            pull: (controller) => new Promise((resolve) => {
+                this._sendMessage('toolpath-stream-pull', { streamId }, 'toolpath-stream-chunk', (data) => {
+                    if (data.error) {
+                        controller.error(new Error(data.error));
+                    } else {
+                        if (data.chunk) {
+                            controller.enqueue(data.chunk);
+                        }
+                        if (data.done) {
+                            controller.close();
+                        }
+                    }
+                    resolve();
+                });
+            }),
+            cancel: () => {
+                this.worker.postMessage({ type: 'toolpath-stream-cancel', data: { streamId } });
+            }
+        }, { highWaterMark: 1 });
+
+        return { stream, ...info };
+    }
+
+    /**
+     * Rasterize a mesh into an unwrapped (X, angle) radius map about the X axis and keep it on the GPU
+     * One dispatch casts rays outward from the axis; generateCylindricalToolpath() then collides any number of
+     * rotations and tools against it. Matches strip rasterization for cross sections that are star-shaped
+     * about the axis. Replaces any previous map.
+     * @param {Float32Array} terrainTriangles - Mesh triangles
+     * @param {number} gridStep - Resolution along X
+     * @param {object} terrainBounds - Mesh bounding box {min: {x,y,z}, max: {x,y,z}}
+     * @param {object} options - {angleStep} in degrees (default: about one grid step of arc at the largest radius)
+     * @returns {Promise<{width: number, angleCount: number, angleStep: number, generationTime: number}>}
+     */
+    async createCylinderMap(terrainTriangles, gridStep, terrainBounds, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage('cylinder-map-create', { triangles: terrainTriangles, gridStep, terrainBounds, options }, 'cylinder-map-ready', handler);
+        });
+    }
+
+    /**
+     * Radial toolpath from the map created with createCylinderMap(), all rotations in one dispatch
+     * @param {Float32Array} toolPositions - Tool raster (sparse XYZ), at the map's grid step
+     * @param {number} xRotationStep - Degrees between each rotation
+     * @param {number} xStep - Sampling step along X-axis
+     * @param {number} zFloor - Z floor value for out-of-bounds
+     * @param {object} options - {helical}: one continuous path where X advances xStep grid cells per turn.
+     *   The result is then {pathData, helical, numPoints, turns, samplesPerTurn, rotationStepDegrees,
+     *   xAdvancePerTurn, xOrigin, generationTime}; point i sits at A = i * rotationStepDegrees and
+     *   X = xOrigin + i * xAdvancePerTurn / samplesPerTurn.
+     * @returns {Promise<{pathData: Float32Array, numRotations: number, pointsPerLine: number, rotationStepDegrees: number, generationTime: number}>}
+     */
+    async generateCylindricalToolpath(toolPositions, xRotationStep, xStep, zFloor, options = {}) {
+        if (!this.isInitialized) {
+            throw new Error('RasterPath not initialized. Call init() first.');
+        }
+
+        return new Promise((resolve, reject) => {
+            const handler = this._replyHandler(resolve, reject);
+
+            this._sendMessage('cylinder-toolpath', { toolPositions, xRotationStep, xStep, zFloor, options }, 'cylinder-toolpath-complete', handler);
+        });
+    }
+
+    /**
+     * Release the cylinder map created with createCylinderMap()
+     */
+    disposeCylinderMap() {
+        if (this.worker) {
+            this.worker.postMessage({ type: 'cylinder-map-dispose' });
+        }
+    }
+
     /**
      * Generate radial toolpath (lathe-like operation)
      * Rotates terrain around X-axis, generates scanline at each angle
@@ -249,6 +808,19 @@ export class RasterPath {
      * @param {object} terrainBounds - Terrain bounding box {min: {x,y,z}, max: {x,y,z}}
      * @param {object} options - Optional settings {onProgress: (percent, info) => {}}
      * @returns {Promise<{pathData: Float32Array, numRotations: number, pointsPerLine: number, rotationStepDegrees: number, generationTime: number}>}
+     * With the worker pool, angles are handed out in small batches as workers free up, and the result adds
+     * workerStats: [{worker, rotations, batches, busyTime}] (busyTime in ms). When the page is cross-origin
+     * isolated, pathData is backed by a SharedArrayBuffer the workers write into.
+     * Progress info carries {pathData, firstRow, rowCount}: those rows are final and can be consumed before
+     * the job completes.
+     * options.angularTolerance (mm) makes xRotationStep the coarse step: angles are bisected wherever
+     * neighbouring scanlines differ by more than the tolerance, down to options.minRotationStep (default
+     * xRotationStep / 16). Rows are then sorted by angle and the result adds angles: Float32Array (degrees).
+     * options.cylindrical collides against a cylindrical radius map, as generateCylindricalToolpath() does,
+     * instead of one strip rasterization per angle (options.cylinderAngleStep sets the map's angular
+     * resolution). The map is local to the job; one made with createCylinderMap() is left in place.
+     * options.helical implies cylindrical and returns one continuous 4th-axis wrap path (see
+     * generateCylindricalToolpath()).
      */
     async generateRadialToolpath(terrainTriangles, toolPositions, xRotationStep, xStep, zFloor, gridStep, terrainBounds, options = {}) {
         if (!this.isInitialized) {
@@ -274,6 +846,45 @@ export class RasterPath {
         console.log(`Generating radial toolpath: ${angles.length} rotations at ${xRotationStep}° steps`);
         console.log(`Tool radius: ${toolRadius.toFixed(2)}mm`);
 
+        // Adaptive refinement runs its rounds on the primary worker against one resident job
+        if (options.angularTolerance) {
+            const jobId = this.nextJobId++;
+            const radialJob = { jobId, triangles: terrainTriangles, toolPositions, xStep, zFloor, gridStep, terrainBounds };
+            let result;
+            try {
+                await new Promise((resolve, reject) => {
+                    this._sendMessage('radial-job-begin', radialJob, 'radial-job-ready', this._replyHandler(resolve, reject));
+                });
+                result = await new Promise((resolve, reject) => {
+                    this._sendMessage('radial-job-adaptive', {
+                        jobId,
+                        coarseStep: xRotationStep,
+                        minStep: options.minRotationStep ?? xRotationStep / 16,
+                        tolerance: options.angularTolerance
+                    }, 'radial-job-adaptive-complete', this._replyHandler(resolve, reject));
+                });
+            } finally {
+                this.worker.postMessage({ type: 'radial-job-end', data: { jobId } });
+            }
+
+            const generationTime = performance.now() - startTime;
+            console.log(`✅ Adaptive radial toolpath complete: ${result.numRotations} rotations × ${result.pointsPerLine} points in ${generationTime.toFixed(1)}ms`);
+            return { ...result, rotationStepDegrees: xRotationStep, generationTime };
+        }
+
+        // One cylindrical raster of the whole part, then every rotation in a single collision dispatch
+        // The worker uses a job-local map, so a map made with createCylinderMap() stays resident
+        if (options.cylindrical || options.helical) {
+            const result = await new Promise((resolve, reject) => {
+                this._sendMessage('cylinder-radial-toolpath', {
+                    triangles: terrainTriangles, toolPositions, xRotationStep, xStep, zFloor, gridStep, terrainBounds,
+                    options: { helical: options.helical, cylinderAngleStep: options.cylinderAngleStep }
+                }, 'cylinder-toolpath-complete', this._replyHandler(resolve, reject));
+            });
+            result.generationTime = performance.now() - startTime;
+            return result;
+        }
+
         // Use Phase 2A (parallel workers with GPU rotation)
         // Splits rotations across workers for excellent performance (5-6 seconds for 360 rotations)
         if (this.workerPool.length > 0 && angles.length >= 4) {
@@ -288,76 +899,41 @@ export class RasterPath {
 
         const { onProgress } = options;
 
-        // Process each rotation sequentially
-        const scanlines = [];
-        for (let i = 0; i < angles.length; i++) {
-            const angle = angles[i];
-
-            // Report progress
-            if (onProgress) {
-                const percent = Math.round(((i + 1) / angles.length) * 100);
-                onProgress(percent, { current: i + 1, total: angles.length, angle });
-            }
-
-            // 1. Rotate terrain triangles
-            const rotatedTriangles = this._rotateTrianglesAroundX(terrainTriangles, angle);
-
-            // 2. Define strip bounds (full X, narrow Y band, full Z)
-            const stripBounds = {
-                min: {
-                    x: terrainBounds.min.x,
-                    y: -toolRadius,
-                    z: terrainBounds.min.z
-                },
-                max: {
-                    x: terrainBounds.max.x,
-                    y: toolRadius,
-                    z: terrainBounds.max.z
-                }
-            };
-
-            // 3. Rasterize strip
-            const stripRaster = await this.rasterizeMesh(rotatedTriangles, gridStep, 0, stripBounds);
-
-            // 4. Generate scanline from strip
-            const scanlineData = await new Promise((resolve, reject) => {
-                const handler = (data) => {
-                    resolve(data);
-                };
+        // The primary worker keeps the mesh for the whole job and runs the rotations in batches
+        const jobId = this.nextJobId++;
+        const radialJob = { jobId, triangles: terrainTriangles, toolPositions, xStep, zFloor, gridStep, terrainBounds };
 
-                this._sendMessage(
-                    'generate-radial-scanline',
-                    {
-                        stripPositions: stripRaster.positions,
-                        stripBounds: stripRaster.bounds,
-                        toolPositions,
-                        xStep,
-                        zFloor,
-                        gridStep
-                    },
-                    'radial-scanline-complete',
-                    handler
-                );
+        // Batches are copied straight into the final buffer as they arrive
+        const pointsPerLine = radialPointsPerLine(terrainBounds, xStep, gridStep);
+        const pathData = new Float32Array(angles.length * pointsPerLine);
+        try {
+            await new Promise((resolve, reject) => {
+                this._sendMessage('radial-job-begin', radialJob, 'radial-job-ready', this._replyHandler(resolve, reject));
             });
 
-            scanlines.push(scanlineData.scanline);
+            for (let start = 0; start < angles.length; start += RADIAL_ANGLES_PER_MESSAGE) {
+                const batch = angles.slice(start, start + RADIAL_ANGLES_PER_MESSAGE);
+                const batchData = await new Promise((resolve, reject) => {
+                    this._sendMessage('radial-job-angles', { jobId, angles: batch }, 'radial-job-scanlines', this._replyHandler(resolve, reject));
+                });
+                pathData.set(batchData.scanlines, start * pointsPerLine);
 
-            if (i === 0) {
-                console.log(`  Scanline output: ${scanlineData.scanline.length} points`);
+                if (onProgress) {
+                    const current = start + batch.length;
+                    const percent = Math.round((current / angles.length) * 100);
+                    onProgress(percent, {
+                        current, total: angles.length, angle: batch[batch.length - 1],
+                        pathData, firstRow: start, rowCount: batch.length
+                    });
+                }
             }
+        } finally {
+            this.worker.postMessage({ type: 'radial-job-end', data: { jobId } });
         }
 
         const endTime = performance.now();
         const generationTime = endTime - startTime;
 
-        // Combine scanlines into single Float32Array
-        const pointsPerLine = scanlines[0].length;
-        console.log(`Total scanline output: ${pointsPerLine} points per line, ${angles.length} lines`);
-        const pathData = new Float32Array(angles.length * pointsPerLine);
-        for (let i = 0; i < scanlines.length; i++) {
-            pathData.set(scanlines[i], i * pointsPerLine);
-        }
-
         console.log(`✅ Radial toolpath complete: ${angles.length} rotations × ${pointsPerLine} points in ${generationTime.toFixed(1)}ms`);
 
         return {
@@ -374,73 +950,97 @@ export class RasterPath {
      * Internal method - called by generateRadialToolpath when worker pool is available
      */
     async _generateRadialToolpathParallel(terrainTriangles, toolPositions, angles, xStep, zFloor, gridStep, terrainBounds, toolRadius, xRotationStep, startTime, options = {}) {
-        const numWorkers = this.workerPool.length;
         const { onProgress } = options;
-
-        // Split angles across workers
-        const anglesPerWorker = Math.ceil(angles.length / numWorkers);
-        const workerTasks = [];
-
-        for (let workerIdx = 0; workerIdx < numWorkers; workerIdx++) {
-            const startIdx = workerIdx * anglesPerWorker;
-            const endIdx = Math.min(startIdx + anglesPerWorker, angles.length);
-            if (startIdx >= angles.length) break;
-
-            const workerAngles = angles.slice(startIdx, endIdx);
-            workerTasks.push({
-                workerIdx,
-                workerState: this.workerPool[workerIdx],
-                angles: workerAngles,
-                startIdx,
-                endIdx
-            });
+        const numWorkers = Math.min(this.workerPool.length, Math.ceil(angles.length / RADIAL_ANGLES_PER_MESSAGE));
+
+        console.log(`[RasterPath] Running ${angles.length} rotations across ${numWorkers} workers`);
+
+        // Each worker receives the mesh once per job: shared when the page is cross-origin isolated,
+        // otherwise as its own transferred copy. When shared, pathData is shared too and workers write
+        // their rows in place; otherwise each batch is copied in as it arrives.
+        const shareMesh = typeof SharedArrayBuffer !== 'undefined' && globalThis.crossOriginIsolated === true;
+        let sharedTriangles = null;
+        if (shareMesh) {
+            sharedTriangles = new Float32Array(new SharedArrayBuffer(terrainTriangles.byteLength));
+            sharedTriangles.set(terrainTriangles);
         }
 
-        console.log(`[RasterPath] Split ${angles.length} rotations across ${workerTasks.length} workers`);
+        const pointsPerLine = radialPointsPerLine(terrainBounds, xStep, gridStep);
+        const pathBytes = angles.length * pointsPerLine * 4;
+        const pathData = new Float32Array(shareMesh ? new SharedArrayBuffer(pathBytes) : new ArrayBuffer(pathBytes));
 
-        // Shared progress tracker (aggregate across all workers)
+        // Dynamic queue: each worker takes the next small batch of angles as soon as it finishes one,
+        // so angles with dense cross-sections don't leave the other workers idle behind a fixed partition
+        const jobId = this.nextJobId++;
+        let nextAngle = 0;
         let completedRotations = 0;
-        const progressCallback = onProgress ? (rotationsComplete) => {
-            completedRotations += rotationsComplete;
-            const percent = Math.round((completedRotations / angles.length) * 100);
-            onProgress(percent, { current: completedRotations, total: angles.length });
-        } : null;
-
-        // Process all worker tasks in parallel
-        const workerPromises = workerTasks.map(task =>
-            this._processWorkerRotations(
-                task.workerState,
-                task.workerIdx,
-                terrainTriangles,
-                toolPositions,
-                task.angles,
-                xStep,
-                zFloor,
-                gridStep,
-                terrainBounds,
-                toolRadius,
-                progressCallback
-            )
-        );
+        let failed = false;
+
+        const runWorker = async (workerState, workerIdx) => {
+            const stats = { worker: workerIdx, rotations: 0, batches: 0, busyTime: 0 };
+            const triangles = sharedTriangles || terrainTriangles.slice();
+            const radialJob = {
+                jobId, triangles, toolPositions, xStep, zFloor, gridStep, terrainBounds,
+                pathData: shareMesh ? pathData : null
+            };
+            const transfer = triangles.buffer instanceof ArrayBuffer ? [triangles.buffer] : [];
+
+            try {
+                const beginStart = performance.now();
+                await new Promise((resolve, reject) => {
+                    this._sendWorkerMessage(workerState, 'radial-job-begin', radialJob, 'radial-job-ready', this._replyHandler(resolve, reject), transfer);
+                });
+                stats.busyTime += performance.now() - beginStart;
+
+                while (!failed && nextAngle < angles.length) {
+                    const start = nextAngle;
+                    nextAngle = Math.min(start + RADIAL_ANGLES_PER_MESSAGE, angles.length);
+                    const batch = angles.slice(start, nextAngle);
+
+                    const batchStart = performance.now();
+                    const batchData = await new Promise((resolve, reject) => {
+                        this._sendWorkerMessage(workerState, 'radial-job-angles', { jobId, angles: batch, firstRow: start }, 'radial-job-scanlines', this._replyHandler(resolve, reject));
+                    });
+                    stats.busyTime += performance.now() - batchStart;
+                    stats.rotations += batch.length;
+                    stats.batches++;
+
+                    if (batchData.scanlines) {
+                        pathData.set(batchData.scanlines, start * pointsPerLine);
+                    }
 
-        // Wait for all workers to complete
-        const workerResults = await Promise.all(workerPromises);
+                    // Rows [firstRow, firstRow + rowCount) of pathData are final from here on
+                    completedRotations += batch.length;
+                    if (onProgress) {
+                        const percent = Math.round((completedRotations / angles.length) * 100);
+                        onProgress(percent, { current: completedRotations, total: angles.length, pathData, firstRow: start, rowCount: batch.length });
+                    }
+                }
+            } catch (error) {
+                // Stop the other workers after their current batch
+                failed = true;
+                throw error;
+            } finally {
+                workerState.worker.postMessage({ type: 'radial-job-end', data: { jobId } });
+            }
+            return stats;
+        };
 
-        // Combine results in correct order
-        const allScanlines = [];
-        for (const result of workerResults) {
-            allScanlines.push(...result.scanlines);
+        // Wait for every worker to release its radial job before reporting a failure
+        const outcomes = await Promise.allSettled(
+            this.workerPool.slice(0, numWorkers).map((workerState, workerIdx) => runWorker(workerState, workerIdx))
+        );
+        const failure = outcomes.find(outcome => outcome.status === 'rejected');
+        if (failure) {
+            throw failure.reason;
         }
+        const workerStats = outcomes.map(outcome => outcome.value);
 
         const endTime = performance.now();
         const generationTime = endTime - startTime;
 
-        // Combine scanlines into single Float32Array
-        const pointsPerLine = allScanlines[0].length;
-        console.log(`Total scanline output: ${pointsPerLine} points per line, ${angles.length} lines`);
-        const pathData = new Float32Array(angles.length * pointsPerLine);
-        for (let i = 0; i < allScanlines.length; i++) {
-            pathData.set(allScanlines[i], i * pointsPerLine);
+        for (const stats of workerStats) {
+            console.log(`[RasterPath]   Worker ${stats.worker}: ${stats.rotations} rotations in ${stats.batches} batches, busy ${stats.busyTime.toFixed(1)}ms`);
         }
 
         console.log(`✅ Radial toolpath complete (parallel): ${angles.length} rotations × ${pointsPerLine} points in ${generationTime.toFixed(1)}ms`);
@@ -450,81 +1050,73 @@ export class RasterPath {
             numRotations: angles.length,
             pointsPerLine,
             rotationStepDegrees: xRotationStep,
-            generationTime
+            generationTime,
+            workerStats
         };
     }
 
     /**
-     * Process rotations for a single worker
-     * Internal method - processes a subset of angles in one worker
+     * Run a shared tiled planar toolpath job across the worker pool
+     * Internal method - workers pull tiles from a shared queue and write their scanlines
+     * straight into the job's shared pathData
      */
-    async _processWorkerRotations(workerState, workerIdx, terrainTriangles, toolPositions, angles, xStep, zFloor, gridStep, terrainBounds, toolRadius, progressCallback = null) {
-        const scanlines = [];
-
-        for (let i = 0; i < angles.length; i++) {
-            const angle = angles[i];
-
-            // 1. Define strip bounds (narrow band for rasterization)
-            const stripBounds = {
-                min: {
-                    x: terrainBounds.min.x,
-                    y: -toolRadius,
-                    z: terrainBounds.min.z
-                },
-                max: {
-                    x: terrainBounds.max.x,
-                    y: toolRadius,
-                    z: terrainBounds.max.z
-                }
-            };
-
-            // 2. Rasterize strip using this worker (GPU will rotate triangles)
-            const stripRaster = await new Promise((resolve, reject) => {
-                const handler = (data) => resolve(data);
-                this._sendWorkerMessage(
-                    workerState,
-                    'rasterize',
-                    {
-                        triangles: terrainTriangles,  // Pass unrotated triangles
-                        stepSize: gridStep,
-                        filterMode: 0,
-                        isForTool: false,
-                        boundsOverride: stripBounds,
-                        rotationAngleDeg: angle  // GPU will apply rotation
-                    },
-                    'rasterize-complete',
-                    handler
-                );
-            });
+    async _runToolpathTilesParallel(tiledJob, onProgress = null) {
+        const startTime = performance.now();
+        const { tiles, pathData, numScanlines, pointsPerLine } = tiledJob;
+        const numWorkers = Math.min(this.workerPool.length, tiles.length);
 
-            // 4. Generate scanline from strip using this worker
-            const scanlineData = await new Promise((resolve, reject) => {
-                const handler = (data) => resolve(data);
-                this._sendWorkerMessage(
-                    workerState,
-                    'generate-radial-scanline',
-                    {
-                        stripPositions: stripRaster.positions,
-                        stripBounds: stripRaster.bounds,
-                        toolPositions,
-                        xStep,
-                        zFloor,
-                        gridStep
-                    },
-                    'radial-scanline-complete',
-                    handler
-                );
-            });
+        console.log(`[RasterPath] Running ${tiles.length} toolpath tiles across ${numWorkers} workers`);
 
-            scanlines.push(scanlineData.scanline);
+        // Dynamic queue: each worker takes the next tile as soon as it finishes one, so slow
+        // tiles (dense tool footprints, band uploads) don't stall a fixed partition
+        const jobId = this.nextJobId++;
+        let nextTile = 0;
+        let completedTiles = 0;
+        let failed = false;
 
-            // Report progress for this completed rotation
-            if (progressCallback) {
-                progressCallback(1);  // Report 1 rotation completed
+        const runWorker = async (workerState) => {
+            try {
+                await new Promise((resolve, reject) => {
+                    this._sendWorkerMessage(workerState, 'toolpath-tiles-begin', { ...tiledJob, jobId }, 'toolpath-tiles-ready', this._replyHandler(resolve, reject));
+                });
+
+                while (!failed && nextTile < tiles.length) {
+                    const tileIndex = nextTile++;
+                    await new Promise((resolve, reject) => {
+                        this._sendWorkerMessage(workerState, 'toolpath-tile', { jobId, tileIndex }, 'toolpath-tile-complete', this._replyHandler(resolve, reject));
+                    });
+
+                    completedTiles++;
+                    if (onProgress) {
+                        const percent = Math.round((completedTiles / tiles.length) * 100);
+                        onProgress(percent, { current: completedTiles, total: tiles.length, layer: tileIndex + 1 });
+                    }
+                }
+            } catch (error) {
+                // Stop the other workers after their current tile
+                failed = true;
+                throw error;
+            } finally {
+                workerState.worker.postMessage({ type: 'toolpath-tiles-end', data: { jobId } });
             }
+        };
+
+        // Wait for every worker to release its tile job before reporting a failure
+        const outcomes = await Promise.allSettled(this.workerPool.slice(0, numWorkers).map(runWorker));
+        const failure = outcomes.find(outcome => outcome.status === 'rejected');
+        if (failure) {
+            throw failure.reason;
         }
 
-        return { scanlines };
+        const generationTime = tiledJob.planTime + (performance.now() - startTime);
+        console.log(`✅ Tiled toolpath complete (parallel): ${numScanlines}×${pointsPerLine} in ${generationTime.toFixed(1)}ms`);
+
+        return {
+            pathData,
+            numScanlines,
+            pointsPerLine,
+            generationTime
+        };
     }
 
     /**
@@ -653,7 +1245,7 @@ export class RasterPath {
 
         // Find handler for this message type
         for (const [id, handler] of this.messageHandlers.entries()) {
-            if (handler.responseType === type) {
+            if (handler.responseType === type && handler.streamId === data?.streamId && handler.jobId === data?.jobId) {
                 this.messageHandlers.delete(id);
                 if (type === 'webgpu-ready') {
                     handler.callback(data);
@@ -665,9 +1257,10 @@ export class RasterPath {
         }
     }
 
+    // Requests carrying data.streamId or data.jobId only match replies with the same ids
     _sendMessage(type, data, responseType, callback) {
         const id = this.messageId++;
-        this.messageHandlers.set(id, { responseType, callback });
+        this.messageHandlers.set(id, { responseType, callback, streamId: data?.streamId, jobId: data?.jobId });
         this.worker.postMessage({ type, data });
     }
 
@@ -676,7 +1269,7 @@ export class RasterPath {
 
         // Find handler for this message type in this worker's handlers
         for (const [id, handler] of workerState.messageHandlers.entries()) {
-            if (handler.responseType === type) {
+            if (handler.responseType === type && handler.jobId === data?.jobId) {
                 workerState.messageHandlers.delete(id);
                 handler.callback(data);
                 break;
@@ -684,98 +1277,64 @@ export class RasterPath {
         }
     }
 
-    _sendWorkerMessage(workerState, type, data, responseType, callback) {
-        const id = workerState.messageId++;
-        workerState.messageHandlers.set(id, { responseType, callback });
-        workerState.worker.postMessage({ type, data });
+    // Reply callback that rejects when the worker answered with {error}
+    _replyHandler(resolve, reject) {
+        return (data) => {
+            if (data && data.error) {
+                reject(new Error(data.error));
+            } else {
+                resolve(data);
+            }
+        };
     }
 
-    _parseSTL(buffer) {
-        const view = new DataView(buffer);
-        const isASCII = this._isASCIISTL(buffer);
+    // Requests carrying data.jobId only match replies of the same job, so overlapping jobs can share a worker
+    _sendWorkerMessage(workerState, type, data, responseType, callback, transfer = []) {
+        const id = workerState.messageId++;
+        workerState.messageHandlers.set(id, { responseType, callback, jobId: data?.jobId });
+        workerState.worker.postMessage({ type, data }, transfer);
+    }
 
-        if (isASCII) {
-            return this._parseASCIISTL(buffer);
+    // Stream STL bytes to the primary worker; rasterize (optional) {stepSize, filterMode, boundsOverride}
+    // Each parse has its own stream id, so concurrent parses feed separate parsers in the worker
+    async _sendSTL(source, rasterize, responseType) {
+        const streamId = this.nextStreamId++;
+        if (source instanceof ArrayBuffer) {
+            this.worker.postMessage({ type: 'stl-parse-begin', data: { streamId, byteLength: source.byteLength } });
+            this.worker.postMessage({ type: 'stl-parse-chunk', data: { streamId, chunk: new Uint8Array(source) } }, [source]);
         } else {
-            return this._parseBinarySTL(view);
-        }
-    }
-
-    _isASCIISTL(buffer) {
-        const text = new TextDecoder().decode(buffer.slice(0, 80));
-        return text.toLowerCase().startsWith('solid');
-    }
-
-    _parseASCIISTL(buffer) {
-        const text = new TextDecoder().decode(buffer);
-        const lines = text.split('\n');
-        const triangles = [];
-        let vertexCount = 0;
-        let vertices = [];
-
-        for (const line of lines) {
-            const trimmed = line.trim();
-            if (trimmed.startsWith('vertex')) {
-                const parts = trimmed.split(/\s+/);
-                vertices.push(
-                    parseFloat(parts[1]),
-                    parseFloat(parts[2]),
-                    parseFloat(parts[3])
-                );
-                vertexCount++;
-                if (vertexCount === 3) {
-                    triangles.push(...vertices);
-                    vertices = [];
-                    vertexCount = 0;
+            this.worker.postMessage({ type: 'stl-parse-begin', data: { streamId } });
+            const reader = source.getReader();
+            try {
+                for (;;) {
+                    const { done, value } = await reader.read();
+                    if (done) break;
+                    // Transfer chunks that own their buffer, copy views into a larger one
+                    const chunk = value.byteOffset === 0 && value.byteLength === value.buffer.byteLength ? value : value.slice();
+                    this.worker.postMessage({ type: 'stl-parse-chunk', data: { streamId, chunk } }, [chunk.buffer]);
                 }
+            } catch (error) {
+                // Drop the partial parse and stop the source
+                this.worker.postMessage({ type: 'stl-parse-cancel', data: { streamId } });
+                await reader.cancel(error).catch(() => {});
+                throw error;
+            } finally {
+                reader.releaseLock();
             }
         }
 
-        return new Float32Array(triangles);
-    }
-
-    _parseBinarySTL(view) {
-        const numTriangles = view.getUint32(80, true);
-        const triangles = new Float32Array(numTriangles * 9); // 3 vertices * 3 components
-
-        let offset = 84; // Skip 80-byte header + 4-byte count
-        let floatIndex = 0;
-
-        for (let i = 0; i < numTriangles; i++) {
-            // Skip normal (12 bytes)
-            offset += 12;
-
-            // Read 3 vertices (9 floats)
-            for (let j = 0; j < 9; j++) {
-                triangles[floatIndex++] = view.getFloat32(offset, true);
-                offset += 4;
-            }
-
-            // Skip attribute byte count (2 bytes)
-            offset += 2;
-        }
-
-        return triangles;
-    }
-
-    _rotateTrianglesAroundX(triangles, angleDegrees) {
-        const rad = angleDegrees * Math.PI / 180;
-        const cos = Math.cos(rad);
-        const sin = Math.sin(rad);
-        const rotated = new Float32Array(triangles.length);
-
-        // Rotate each vertex: X stays same, Y and Z rotate
-        for (let i = 0; i < triangles.length; i += 3) {
-            const x = triangles[i];
-            const y = triangles[i + 1];
-            const z = triangles[i + 2];
-
-            rotated[i] = x;                      // X unchanged
-            rotated[i + 1] = y * cos - z * sin;  // Y' = Y*cos - Z*sin
-            rotated[i + 2] = y * sin + z * cos;  // Z' = Y*sin + Z*cos
-        }
+        return new Promise((resolve, reject) => {
+            const handler = (data) => {
+                if (data.error) {
+                    reject(new Error(data.error));
+                    return;
+                }
+                delete data.streamId;
+                resolve(data);
+            };
 
-        return rotated;
+            this._sendMessage('stl-parse-end', { streamId, rasterize }, responseType, handler);
+        });
     }
 }
 
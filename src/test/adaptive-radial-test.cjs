@@ -0,0 +1,166 @@
+// adaptive-radial-test.cjs
+// Verify adaptive angular refinement: refined rows equal the fixed-step radial toolpath and unrefined gaps stay within tolerance
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Adaptive Radial Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -50;
+                    const terrainBounds = terrainResult.bounds;
+                    const xStep = 1;
+                    const coarseStep = 20, minStep = 2.5, tolerance = 1;
+
+                    const fixed = await rasterPath.generateRadialToolpath(
+                        terrainTriangles, toolResult.positions, minStep, xStep, zFloor, stepSize, terrainBounds
+                    );
+                    const adaptive = await rasterPath.generateRadialToolpath(
+                        terrainTriangles, toolResult.positions, coarseStep, xStep, zFloor, stepSize, terrainBounds,
+                        { angularTolerance: tolerance, minRotationStep: minStep }
+                    );
+                    rasterPath.dispose();
+                    console.log(\`✓ Adaptive: \${adaptive.numRotations} rotations, fixed: \${fixed.numRotations} rotations\`);
+
+                    const { angles, pointsPerLine } = adaptive;
+                    if (pointsPerLine !== fixed.pointsPerLine || angles.length !== adaptive.numRotations) {
+                        return { error: \`Adaptive result is \${angles.length} angles x \${pointsPerLine}, fixed is \${fixed.pointsPerLine} points per line\` };
+                    }
+                    for (let angle = 0; angle < 360; angle += coarseStep) {
+                        if (!angles.includes(angle)) {
+                            return { error: \`Coarse angle \${angle}° is missing\` };
+                        }
+                    }
+
+                    // Every refined row equals the fixed-step row at the same angle
+                    for (let r = 0; r < angles.length; r++) {
+                        const fixedRow = Math.round(angles[r] / minStep);
+                        if (Math.abs(fixedRow * minStep - angles[r]) > 1e-6) {
+                            return { error: \`Angle \${angles[r]}° is not a multiple of the minimum step\` };
+                        }
+                        for (let x = 0; x < pointsPerLine; x++) {
+                            const actual = adaptive.pathData[r * pointsPerLine + x];
+                            const expected = fixed.pathData[fixedRow * pointsPerLine + x];
+                            if (actual !== expected) {
+                                return { error: \`Row at \${angles[r]}° point \${x} is \${actual}, fixed step gives \${expected}\` };
+                            }
+                        }
+                    }
+
+                    // Gaps left unrefined are within tolerance; narrower ones reached the minimum step
+                    for (let r = 0; r < angles.length; r++) {
+                        const next = (r + 1) % angles.length;
+                        const gap = ((angles[next] - angles[r]) % 360 + 360) % 360;
+                        if (gap < 2 * minStep) continue;
+                        let maxDiff = 0;
+                        for (let x = 0; x < pointsPerLine; x++) {
+                            maxDiff = Math.max(maxDiff, Math.abs(adaptive.pathData[r * pointsPerLine + x] - adaptive.pathData[next * pointsPerLine + x]));
+                        }
+                        if (maxDiff > tolerance) {
+                            return { error: \`Gap \${angles[r]}°-\${angles[next]}° differs by \${maxDiff} but was not refined\` };
+                        }
+                    }
+
+                    return {
+                        success: true,
+                        adaptiveRotations: adaptive.numRotations,
+                        fixedRotations: fixed.numRotations,
+                        pointsPerLine
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Adaptive radial rows match fixed-step toolpath');
+            console.log(`   Adaptive: ${result.adaptiveRotations} rotations (fixed step: ${result.fixedRotations}), ${result.pointsPerLine} points per line`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,159 @@
+// adaptive-toolpath-test.cjs
+// Verify adaptive toolpath polylines stay within tolerance of the dense generatePlanarToolpath output
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Adaptive Toolpath Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const xStep = 1, yStep = 5, zFloor = -100, tolerance = 0.01;
+                    const dense = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize,
+                        { terrainBounds: terrainResult.bounds }
+                    );
+                    const adaptive = await rasterPath.generateAdaptiveToolpath(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, tolerance,
+                        { terrainBounds: terrainResult.bounds }
+                    );
+                    rasterPath.dispose();
+
+                    if (adaptive.numScanlines !== dense.numScanlines || adaptive.pointsPerLine !== dense.pointsPerLine) {
+                        return { error: 'Dimension mismatch between adaptive and dense toolpaths' };
+                    }
+
+                    // Every vertex is an exact probe, and interpolating between vertices must stay within
+                    // tolerance of the dense samples (small slack for float32 interpolation)
+                    const ppl = dense.pointsPerLine;
+                    let maxDeviation = 0;
+                    for (let s = 0; s < adaptive.numScanlines; s++) {
+                        const first = adaptive.lineOffsets[s];
+                        const last = adaptive.lineOffsets[s + 1] - 1;
+                        if (adaptive.vertices[first * 2] !== 0 || adaptive.vertices[last * 2] !== ppl - 1) {
+                            return { error: \`Scanline \${s} does not span the full line\` };
+                        }
+                        for (let v = first; v <= last; v++) {
+                            const x = adaptive.vertices[v * 2];
+                            if (adaptive.vertices[v * 2 + 1] !== dense.pathData[s * ppl + x]) {
+                                return { error: \`Scanline \${s} vertex at \${x} differs from dense output\` };
+                            }
+                            if (v === last) continue;
+                            const x1 = adaptive.vertices[v * 2 + 2];
+                            const z0 = adaptive.vertices[v * 2 + 1], z1 = adaptive.vertices[v * 2 + 3];
+                            for (let xi = x; xi <= x1; xi++) {
+                                const z = z0 + (z1 - z0) * (xi - x) / (x1 - x);
+                                maxDeviation = Math.max(maxDeviation, Math.abs(z - dense.pathData[s * ppl + xi]));
+                            }
+                        }
+                    }
+
+                    if (maxDeviation > tolerance + 1e-4) {
+                        return { error: \`Max deviation \${maxDeviation.toFixed(4)}mm exceeds tolerance \${tolerance}mm\` };
+                    }
+
+                    return {
+                        success: true,
+                        denseCount: dense.pathData.length,
+                        vertexCount: adaptive.vertexCount,
+                        probeCount: adaptive.probeCount,
+                        maxDeviation
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Adaptive toolpath within tolerance of dense toolpath');
+            console.log(`   Dense samples: ${result.denseCount}`);
+            console.log(`   Adaptive vertices: ${result.vertexCount} (${result.probeCount} probes)`);
+            console.log(`   Max deviation: ${result.maxDeviation.toFixed(4)}mm`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
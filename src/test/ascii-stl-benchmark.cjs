@@ -0,0 +1,206 @@
+// ascii-stl-benchmark.cjs
+// Benchmark the worker's byte-level ASCII STL tokenizer against the previous string-splitting parser
+// on a 100MB+ ASCII STL generated from the terrain fixture (vertices in %e format, as scanner exports write them)
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== ASCII STL Benchmark ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const { triangles } = await rasterPath.parseSTL(await terrainResponse.arrayBuffer());
+
+                    // Repeat the fixture's facets until the file passes 100MB
+                    const facets = [];
+                    for (let i = 0; i < triangles.length; i += 9) {
+                        let facet = '  facet normal 0.000000e+00 0.000000e+00 1.000000e+00\\n    outer loop\\n';
+                        for (let k = 0; k < 9; k += 3) {
+                            facet += '      vertex ' + triangles[i + k].toExponential(6) + ' ' +
+                                triangles[i + k + 1].toExponential(6) + ' ' + triangles[i + k + 2].toExponential(6) + '\\n';
+                        }
+                        facets.push(facet + '    endloop\\n  endfacet\\n');
+                    }
+                    const block = new TextEncoder().encode(facets.join(''));
+                    const header = new TextEncoder().encode('solid benchmark\\n');
+                    const footer = new TextEncoder().encode('endsolid benchmark\\n');
+                    const copies = Math.ceil(100e6 / block.length);
+                    const stl = new Uint8Array(header.length + copies * block.length + footer.length);
+                    stl.set(header);
+                    for (let c = 0; c < copies; c++) {
+                        stl.set(block, header.length + c * block.length);
+                    }
+                    stl.set(footer, header.length + copies * block.length);
+                    const megabytes = stl.length / 1e6;
+                    console.log(\`✓ Generated ASCII STL: \${megabytes.toFixed(1)}MB, \${copies * triangles.length / 9} triangles\`);
+
+                    // Previous parser: decode, split lines, split tokens, grow a JS array
+                    function parseASCIISTLLegacy(buffer) {
+                        const text = new TextDecoder().decode(buffer);
+                        const lines = text.split('\\n');
+                        const triangles = [];
+                        let vertexCount = 0;
+                        let vertices = [];
+
+                        for (const line of lines) {
+                            const trimmed = line.trim();
+                            if (trimmed.startsWith('vertex')) {
+                                const parts = trimmed.split(/\\s+/);
+                                vertices.push(
+                                    parseFloat(parts[1]),
+                                    parseFloat(parts[2]),
+                                    parseFloat(parts[3])
+                                );
+                                vertexCount++;
+                                if (vertexCount === 3) {
+                                    triangles.push(...vertices);
+                                    vertices = [];
+                                    vertexCount = 0;
+                                }
+                            }
+                        }
+
+                        return new Float32Array(triangles);
+                    }
+
+                    let legacy = null;
+                    let legacyTime = null;
+                    try {
+                        const legacyStart = performance.now();
+                        legacy = parseASCIISTLLegacy(stl.buffer);
+                        legacyTime = performance.now() - legacyStart;
+                    } catch (error) {
+                        console.log(\`Legacy parser failed: \${error.message}\`);
+                    }
+
+                    // Worker tokenizer, whole buffer transferred (time includes the transfer and the reply)
+                    const streamCopy = stl.slice();
+                    const workerStart = performance.now();
+                    const parsed = await rasterPath.parseSTL(stl.buffer);
+                    const workerTime = performance.now() - workerStart;
+
+                    // Worker tokenizer fed 64KB stream chunks
+                    const stream = new ReadableStream({
+                        start(controller) {
+                            for (let offset = 0; offset < streamCopy.length; offset += 65536) {
+                                controller.enqueue(streamCopy.slice(offset, offset + 65536));
+                            }
+                            controller.close();
+                        }
+                    });
+                    const streamStart = performance.now();
+                    const streamed = await rasterPath.parseSTL(stream);
+                    const streamTime = performance.now() - streamStart;
+                    rasterPath.dispose();
+
+                    if (streamed.triangleCount !== parsed.triangleCount) {
+                        return { error: \`Streamed parse found \${streamed.triangleCount} triangles, whole buffer \${parsed.triangleCount}\` };
+                    }
+                    if (legacy) {
+                        if (legacy.length !== parsed.triangles.length) {
+                            return { error: \`Triangle count mismatch: legacy \${legacy.length / 9}, tokenizer \${parsed.triangleCount}\` };
+                        }
+                        for (let i = 0; i < legacy.length; i++) {
+                            if (legacy[i] !== parsed.triangles[i]) {
+                                return { error: \`Value \${i} differs: legacy \${legacy[i]}, tokenizer \${parsed.triangles[i]}\` };
+                            }
+                        }
+                    }
+
+                    return {
+                        success: true,
+                        megabytes,
+                        triangleCount: parsed.triangleCount,
+                        legacyTime,
+                        workerTime,
+                        streamTime
+                    };
+                } catch (error) {
+                    console.error('Benchmark error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Benchmark failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            const rate = (ms) => `${ms.toFixed(1)}ms (${(result.megabytes / (ms / 1000)).toFixed(0)} MB/s)`;
+            console.log('\n=== Final Results ===');
+            console.log('✅ ASCII STL benchmark complete');
+            console.log(`   File: ${result.megabytes.toFixed(1)}MB, ${result.triangleCount} triangles`);
+            console.log(`   Legacy parser:    ${result.legacyTime === null ? 'failed' : rate(result.legacyTime)}`);
+            console.log(`   Worker tokenizer: ${rate(result.workerTime)}`);
+            console.log(`   Worker, streamed: ${rate(result.streamTime)}`);
+            if (result.legacyTime !== null) {
+                console.log(`   Speedup:          ${(result.legacyTime / result.workerTime).toFixed(2)}x`);
+            }
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Benchmark execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
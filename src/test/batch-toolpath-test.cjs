@@ -0,0 +1,145 @@
+// batch-toolpath-test.cjs
+// Verify multi-tool batched toolpaths match individual generatePlanarToolpath calls
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Batch Toolpath Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    // Roughing / finishing style passes with different steps and floors
+                    const tools = [
+                        { toolPositions: toolResult.positions, xStep: 10, yStep: 10, zFloor: -100 },
+                        { toolPositions: toolResult.positions, xStep: 1, yStep: 5, zFloor: -50 },
+                        { toolPositions: toolResult.positions, xStep: 3, yStep: 1, zFloor: -100 }
+                    ];
+
+                    const batchStart = performance.now();
+                    const batch = await rasterPath.generateToolpathBatch(
+                        terrainResult.positions, tools, stepSize, { terrainBounds: terrainResult.bounds }
+                    );
+                    const batchTime = performance.now() - batchStart;
+
+                    const singleStart = performance.now();
+                    let mismatches = 0;
+                    for (let t = 0; t < tools.length; t++) {
+                        const single = await rasterPath.generatePlanarToolpath(
+                            terrainResult.positions, tools[t].toolPositions, tools[t].xStep, tools[t].yStep,
+                            tools[t].zFloor, stepSize, { terrainBounds: terrainResult.bounds }
+                        );
+                        if (single.numScanlines !== batch[t].numScanlines || single.pointsPerLine !== batch[t].pointsPerLine) {
+                            return { error: \`Tool \${t}: dimension mismatch\` };
+                        }
+                        for (let i = 0; i < single.pathData.length; i++) {
+                            if (single.pathData[i] !== batch[t].pathData[i]) mismatches++;
+                        }
+                        console.log(\`Tool \${t}: \${batch[t].numScanlines}x\${batch[t].pointsPerLine}\`);
+                    }
+                    const singleTime = performance.now() - singleStart;
+
+                    rasterPath.dispose();
+
+                    if (mismatches > 0) {
+                        return { error: \`\${mismatches} values differ between batch and single toolpaths\` };
+                    }
+
+                    return { success: true, toolCount: tools.length, batchTime, singleTime };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Batch toolpaths match individual toolpaths');
+            console.log(`   Tools: ${result.toolCount}`);
+            console.log(`   Batch: ${result.batchTime.toFixed(1)}ms`);
+            console.log(`   Individual: ${result.singleTime.toFixed(1)}ms`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
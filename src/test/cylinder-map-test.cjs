@@ -0,0 +1,181 @@
+// cylinder-map-test.cjs
+// Verify the cylinder map radial toolpath matches per-angle strip rasterization on a star-shaped part, and that cylinder map errors reject
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Cylinder Map Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    // Star-shaped fixture about the X axis: a tube whose radius ripples along X and around the axis,
+                    // so every outward ray leaves the part once and the cylinder map sees the whole surface
+                    const tubeTriangles = [];
+                    const segmentsX = 40, segmentsA = 120;
+                    const tubePoint = (i, j) => {
+                        const x = i * 0.5, a = j / segmentsA * 2 * Math.PI;
+                        const r = 10 + 1.6 * Math.sin(x * 0.35) * Math.cos(3 * a);
+                        return [x, r * Math.cos(a), r * Math.sin(a)];
+                    };
+                    for (let i = 0; i < segmentsX; i++) {
+                        for (let j = 0; j < segmentsA; j++) {
+                            const a = tubePoint(i, j), b = tubePoint(i + 1, j), c = tubePoint(i + 1, j + 1), d = tubePoint(i, j + 1);
+                            tubeTriangles.push(...a, ...b, ...c, ...a, ...c, ...d);
+                        }
+                    }
+                    const triangles = new Float32Array(tubeTriangles);
+                    const min = [Infinity, Infinity, Infinity], max = [-Infinity, -Infinity, -Infinity];
+                    for (let i = 0; i < triangles.length; i += 3) {
+                        for (let k = 0; k < 3; k++) {
+                            min[k] = Math.min(min[k], triangles[i + k]);
+                            max[k] = Math.max(max[k], triangles[i + k]);
+                        }
+                    }
+                    const bounds = { min: { x: min[0], y: min[1], z: min[2] }, max: { x: max[0], y: max[1], z: max[2] } };
+                    const tool = toolResult.positions;
+                    const rotationStep = 10, xStep = 2, zFloor = -50;
+
+                    // Cylinder map errors reject instead of leaving the call waiting
+                    const rejection = async (promise) => {
+                        try {
+                            await promise;
+                            return null;
+                        } catch (error) {
+                            return error.message;
+                        }
+                    };
+                    const noMapError = await rejection(rasterPath.generateCylindricalToolpath(tool, rotationStep, xStep, zFloor));
+                    if (!noMapError || !noMapError.includes('No cylinder map')) {
+                        return { error: \`generateCylindricalToolpath without a map gave: \${noMapError}\` };
+                    }
+                    const tooLargeError = await rejection(rasterPath.createCylinderMap(triangles, stepSize, bounds, { angleStep: 1e-6 }));
+                    if (!tooLargeError || !tooLargeError.includes('Cylinder map too large')) {
+                        return { error: \`createCylinderMap with a tiny angle step gave: \${tooLargeError}\` };
+                    }
+                    console.log('✓ Cylinder map errors reject');
+
+                    await rasterPath.createCylinderMap(triangles, stepSize, bounds);
+                    const cylindrical = await rasterPath.generateCylindricalToolpath(tool, rotationStep, xStep, zFloor);
+                    const strip = await rasterPath.generateRadialToolpath(triangles, tool, rotationStep, xStep, zFloor, stepSize, bounds);
+                    rasterPath.disposeCylinderMap();
+                    rasterPath.dispose();
+
+                    if (cylindrical.numRotations !== strip.numRotations || cylindrical.pointsPerLine !== strip.pointsPerLine) {
+                        return { error: \`Cylinder map result is \${cylindrical.numRotations}x\${cylindrical.pointsPerLine}, strips give \${strip.numRotations}x\${strip.pointsPerLine}\` };
+                    }
+
+                    // Both rasterize the same star-shaped surface, one unwrapped and one per rotated strip,
+                    // so they agree to within a grid step
+                    let maxDiff = 0;
+                    for (let i = 0; i < strip.pathData.length; i++) {
+                        const diff = Math.abs(cylindrical.pathData[i] - strip.pathData[i]);
+                        if (!(diff <= stepSize)) {
+                            const row = Math.floor(i / strip.pointsPerLine);
+                            return { error: \`Rotation \${row * rotationStep}° point \${i % strip.pointsPerLine}: cylinder map \${cylindrical.pathData[i]}, strips \${strip.pathData[i]}\` };
+                        }
+                        maxDiff = Math.max(maxDiff, diff);
+                    }
+                    console.log(\`✓ Cylinder map matches strip rasterization within \${maxDiff.toFixed(4)}mm\`);
+
+                    return {
+                        success: true,
+                        numRotations: strip.numRotations,
+                        pointsPerLine: strip.pointsPerLine,
+                        maxDiff
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Cylinder map matches strip radial toolpath');
+            console.log(`   ${result.numRotations}x${result.pointsPerLine} samples, largest difference ${result.maxDiff.toFixed(4)}mm`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
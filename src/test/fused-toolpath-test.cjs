@@ -0,0 +1,163 @@
+// fused-toolpath-test.cjs
+// Verify the fused mesh → toolpath pipeline matches rasterize + generatePlanarToolpath
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Fused Toolpath Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const xStep = 1;
+                    const yStep = 1;
+                    const zFloor = -100;
+
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Tool rasterized: \${toolResult.pointCount} points\`);
+
+                    // Reference: rasterize, read back, send heightmap back to the worker
+                    const separateStart = performance.now();
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const separate = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize,
+                        { terrainBounds: terrainResult.bounds }
+                    );
+                    const separateTime = performance.now() - separateStart;
+
+                    // Fused: heightmap stays on the GPU
+                    const fusedStart = performance.now();
+                    const fused = await rasterPath.generateToolpathFromMesh(
+                        terrainTriangles, toolResult.positions, xStep, yStep, zFloor, stepSize,
+                        { terrainBounds: terrainResult.bounds }
+                    );
+                    const fusedTime = performance.now() - fusedStart;
+
+                    console.log(\`Separate: \${separate.numScanlines}x\${separate.pointsPerLine} in \${separateTime.toFixed(1)}ms\`);
+                    console.log(\`Fused:    \${fused.numScanlines}x\${fused.pointsPerLine} in \${fusedTime.toFixed(1)}ms\`);
+
+                    if (fused.numScanlines !== separate.numScanlines || fused.pointsPerLine !== separate.pointsPerLine) {
+                        return { error: 'Dimension mismatch between fused and separate toolpaths' };
+                    }
+                    if (fused.terrain) {
+                        return { error: 'Heightmap returned without returnHeightmap' };
+                    }
+
+                    let mismatches = 0;
+                    for (let i = 0; i < fused.pathData.length; i++) {
+                        if (fused.pathData[i] !== separate.pathData[i]) mismatches++;
+                    }
+
+                    const withHeightmap = await rasterPath.generateToolpathFromMesh(
+                        terrainTriangles, toolResult.positions, xStep, yStep, zFloor, stepSize,
+                        { terrainBounds: terrainResult.bounds, returnHeightmap: true }
+                    );
+                    if (!withHeightmap.terrain || withHeightmap.terrain.positions.length !== terrainResult.positions.length) {
+                        return { error: 'Opt-in heightmap readback missing or wrong size' };
+                    }
+
+                    rasterPath.dispose();
+
+                    if (mismatches > 0) {
+                        return { error: \`\${mismatches} / \${fused.pathData.length} values differ\` };
+                    }
+
+                    return {
+                        success: true,
+                        totalPoints: fused.pathData.length,
+                        separateTime,
+                        fusedTime
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Fused toolpath matches separate pipeline');
+            console.log(`   Points: ${result.totalPoints}`);
+            console.log(`   Separate: ${result.separateTime.toFixed(1)}ms`);
+            console.log(`   Fused: ${result.fusedTime.toFixed(1)}ms`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
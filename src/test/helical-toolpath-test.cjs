@@ -0,0 +1,161 @@
+// helical-toolpath-test.cjs
+// Verify helical radial output: point count, X advance per turn, and heights against the cylindrical toolpath
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Helical Toolpath Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -50;
+                    const terrainBounds = terrainResult.bounds;
+                    const xRotationStep = 15, xStep = 1;
+
+                    const cylindrical = await rasterPath.generateRadialToolpath(
+                        terrainTriangles, toolResult.positions, xRotationStep, xStep, zFloor, stepSize, terrainBounds, { cylindrical: true }
+                    );
+                    const helical = await rasterPath.generateRadialToolpath(
+                        terrainTriangles, toolResult.positions, xRotationStep, xStep, zFloor, stepSize, terrainBounds, { helical: true }
+                    );
+                    rasterPath.dispose();
+
+                    // One continuous path: samplesPerTurn points per turn, X advancing xStep grid cells per turn
+                    const mapWidth = Math.ceil((terrainBounds.max.x - terrainBounds.min.x) / stepSize) + 1;
+                    const expectedTurns = Math.max(1, Math.ceil((mapWidth - 1) / xStep));
+                    const expectedSamplesPerTurn = Math.ceil(360 / xRotationStep);
+                    if (!helical.helical || helical.turns !== expectedTurns || helical.samplesPerTurn !== expectedSamplesPerTurn) {
+                        return { error: \`Helical path has \${helical.turns} turns x \${helical.samplesPerTurn} samples, expected \${expectedTurns} x \${expectedSamplesPerTurn}\` };
+                    }
+                    if (helical.numPoints !== helical.turns * helical.samplesPerTurn || helical.pathData.length !== helical.numPoints) {
+                        return { error: \`Helical path has \${helical.pathData.length} values and numPoints \${helical.numPoints}, expected \${helical.turns * helical.samplesPerTurn}\` };
+                    }
+                    if (Math.abs(helical.xAdvancePerTurn - xStep * stepSize) > 1e-9 || helical.xOrigin !== terrainBounds.min.x ||
+                        helical.rotationStepDegrees !== xRotationStep) {
+                        return { error: \`Helical advance \${helical.xAdvancePerTurn}mm from \${helical.xOrigin} at \${helical.rotationStepDegrees}°, expected \${xStep * stepSize}mm from \${terrainBounds.min.x} at \${xRotationStep}°\` };
+                    }
+
+                    // Each helical sample sits at the grid column nearest its X; where that column is a cylindrical sample
+                    // at the same angle, the heights are identical
+                    let compared = 0;
+                    for (let i = 0; i < helical.numPoints; i++) {
+                        const column = i / helical.samplesPerTurn * xStep;
+                        if (Math.abs(column - Math.floor(column) - 0.5) < 1e-4) continue;
+                        const nearest = Math.round(column);
+                        if (nearest % xStep !== 0 || nearest / xStep >= cylindrical.pointsPerLine) continue;
+                        const row = i % helical.samplesPerTurn;
+                        const expected = cylindrical.pathData[row * cylindrical.pointsPerLine + nearest / xStep];
+                        if (helical.pathData[i] !== expected) {
+                            return { error: \`Helical point \${i} is \${helical.pathData[i]}, cylindrical row \${row} point \${nearest / xStep} gives \${expected}\` };
+                        }
+                        compared++;
+                    }
+                    if (compared === 0) {
+                        return { error: 'No helical samples landed on cylindrical samples' };
+                    }
+
+                    return {
+                        success: true,
+                        numPoints: helical.numPoints,
+                        turns: helical.turns,
+                        samplesPerTurn: helical.samplesPerTurn,
+                        xAdvancePerTurn: helical.xAdvancePerTurn,
+                        compared
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Helical toolpath matches cylindrical samples');
+            console.log(`   Helical: ${result.numPoints} points = ${result.turns} turns x ${result.samplesPerTurn}, ${result.xAdvancePerTurn}mm per turn`);
+            console.log(`   Samples compared with the cylindrical toolpath: ${result.compared}`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,139 @@
+// offset-surface-test.cjs
+// Verify a raster sampled from the offset surface at angle 0 reproduces generatePlanarToolpath exactly
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Offset Surface Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -100;
+                    const terrainBounds = terrainResult.bounds;
+                    const xStep = 3, yStep = 2;
+
+                    const toolpath = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, { terrainBounds }
+                    );
+                    const surface = await rasterPath.createOffsetSurface(terrainResult.positions, toolResult.positions, zFloor, stepSize, terrainBounds);
+                    console.log(\`✓ Offset surface: \${surface.width}x\${surface.height}\`);
+
+                    // At angle 0 every raster sample lands on a surface cell, so no interpolation is involved
+                    const sampled = await rasterPath.sampleOffsetSurface({ type: 'raster', xStep, yStep });
+                    rasterPath.disposeOffsetSurface();
+                    rasterPath.dispose();
+
+                    if (sampled.pointsPerLine !== toolpath.pointsPerLine || sampled.numScanlines !== toolpath.numScanlines) {
+                        return { error: \`Sampled raster is \${sampled.pointsPerLine}x\${sampled.numScanlines}, planar toolpath is \${toolpath.pointsPerLine}x\${toolpath.numScanlines}\` };
+                    }
+                    for (let k = 0; k < toolpath.pathData.length; k++) {
+                        if (sampled.pathData[k] !== toolpath.pathData[k]) {
+                            const s = Math.floor(k / toolpath.pointsPerLine), i = k % toolpath.pointsPerLine;
+                            return { error: \`Sample (\${i}, \${s}) is \${sampled.pathData[k]}, generatePlanarToolpath gives \${toolpath.pathData[k]}\` };
+                        }
+                    }
+
+                    return {
+                        success: true,
+                        width: surface.width,
+                        height: surface.height,
+                        pointsPerLine: toolpath.pointsPerLine,
+                        numScanlines: toolpath.numScanlines
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Offset surface raster matches planar toolpath');
+            console.log(`   Offset surface: ${result.width}x${result.height}`);
+            console.log(`   Raster sample ${result.pointsPerLine}x${result.numScanlines} matches the planar toolpath`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,155 @@
+// overlapping-jobs-test.cjs
+// Verify overlapping radial toolpath calls on one RasterPath each get their own job, on the primary worker and on the worker pool
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Overlapping Jobs Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -50;
+                    const terrainBounds = terrainResult.bounds;
+
+                    // Two jobs with different rotation and X steps, so rows from the wrong job can't match
+                    const jobs = [
+                        { rotationStep: 5, xStep: 1 },
+                        { rotationStep: 8, xStep: 3 }
+                    ];
+                    const run = (rp, job) => rp.generateRadialToolpath(
+                        terrainTriangles, toolResult.positions, job.rotationStep, job.xStep, zFloor, stepSize, terrainBounds
+                    );
+
+                    // The primary worker (sequential path) first, then the same jobs on the worker pool
+                    const sequential = [];
+                    for (const job of jobs) {
+                        sequential.push(await run(rasterPath, job));
+                    }
+                    const primaryOverlapped = await Promise.all(jobs.map(job => run(rasterPath, job)));
+
+                    await rasterPath.initWorkerPool();
+                    console.log(\`✓ Worker pool: \${rasterPath.workerPool.length} workers\`);
+                    const poolOverlapped = await Promise.all(jobs.map(job => run(rasterPath, job)));
+                    rasterPath.dispose();
+
+                    const compare = (label, results) => {
+                        for (let j = 0; j < jobs.length; j++) {
+                            const expected = sequential[j], actual = results[j];
+                            if (actual.numRotations !== expected.numRotations || actual.pointsPerLine !== expected.pointsPerLine) {
+                                return \`\${label} job \${j} is \${actual.numRotations}x\${actual.pointsPerLine}, alone it is \${expected.numRotations}x\${expected.pointsPerLine}\`;
+                            }
+                            for (let i = 0; i < expected.pathData.length; i++) {
+                                if (actual.pathData[i] !== expected.pathData[i]) {
+                                    return \`\${label} job \${j} differs at row \${Math.floor(i / expected.pointsPerLine)}: \${actual.pathData[i]} vs \${expected.pathData[i]}\`;
+                                }
+                            }
+                        }
+                        return null;
+                    };
+
+                    const error = compare('Primary worker', primaryOverlapped) || compare('Worker pool', poolOverlapped);
+                    if (error) {
+                        return { error };
+                    }
+                    console.log('✓ Overlapping jobs match the jobs run alone');
+
+                    return {
+                        success: true,
+                        rows: sequential.map(result => \`\${result.numRotations}x\${result.pointsPerLine}\`).join(', ')
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Overlapping jobs match sequential jobs');
+            console.log(`   Overlapping radial jobs (${result.rows}) match the jobs run one at a time`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,205 @@
+// pattern-toolpath-test.cjs
+// Verify contour loops follow the outline of a round part and that contour, spiral and pocket samples equal queryToolZ at the same XY
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Pattern Toolpath Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    // Synthetic round part: a 10mm radius dome on a 30 x 30mm grid, empty outside the disc
+                    const EMPTY_CELL = -1e10;
+                    const partRadius = 10;
+                    const terrainBounds = { min: { x: -15, y: -15, z: 0 }, max: { x: 15, y: 15, z: partRadius } };
+                    const width = Math.ceil(30 / stepSize) + 1;
+                    const height = Math.ceil(30 / stepSize) + 1;
+                    const dome = new Float32Array(width * height);
+                    for (let gy = 0; gy < height; gy++) {
+                        for (let gx = 0; gx < width; gx++) {
+                            const r = Math.hypot(-15 + gx * stepSize, -15 + gy * stepSize);
+                            dome[gy * width + gx] = r <= partRadius ? Math.sqrt(partRadius * partRadius - r * r) : EMPTY_CELL;
+                        }
+                    }
+                    const zFloor = -100;
+                    const tool = toolResult.positions;
+                    await rasterPath.loadTerrain(dome, stepSize, terrainBounds);
+
+                    const stepover = 1, offset = 0.5;
+                    const contour = await rasterPath.generatePatternToolpath({ type: 'contour', stepover, spacing: stepSize, offset }, tool, zFloor);
+                    const spiral = await rasterPath.generatePatternToolpath({ type: 'spiral', pitch: 1, spacing: stepSize, radius: 12 }, tool, zFloor);
+                    const pocket = await rasterPath.generatePatternToolpath({ type: 'pocket', stepover, spacing: stepSize }, tool, zFloor);
+                    console.log(\`✓ Contour: \${contour.polylines.length} loops, spiral: \${spiral.pointCount} samples, pocket: \${pocket.polylines.length} loops\`);
+
+                    // One loop per offset, outermost first, closed, counter-clockwise and centered on the part
+                    // at the outline radius minus its offset (the outline lies half a cell outside the last part cell)
+                    const expectedLoops = Math.floor((partRadius - offset) / stepover) + 1;
+                    if (contour.polylines.length !== expectedLoops) {
+                        return { error: \`Contour has \${contour.polylines.length} loops, expected \${expectedLoops}\` };
+                    }
+                    for (let k = 0; k < contour.polylines.length; k++) {
+                        const loop = contour.polylines[k];
+                        const n = loop.length / 3;
+                        if (loop[0] !== loop[(n - 1) * 3] || loop[1] !== loop[(n - 1) * 3 + 1]) {
+                            return { error: \`Contour loop \${k} does not close\` };
+                        }
+                        let radiusSum = 0, area = 0;
+                        for (let i = 0; i + 1 < n; i++) {
+                            radiusSum += Math.hypot(loop[i * 3], loop[i * 3 + 1]);
+                            area += loop[i * 3] * loop[(i + 1) * 3 + 1] - loop[(i + 1) * 3] * loop[i * 3 + 1];
+                        }
+                        const radius = radiusSum / (n - 1);
+                        const expectedRadius = partRadius + stepSize / 2 - offset - k * stepover;
+                        if (Math.abs(radius - expectedRadius) > 1.5 * stepSize) {
+                            return { error: \`Contour loop \${k} has radius \${radius.toFixed(3)}, expected \${expectedRadius.toFixed(3)}\` };
+                        }
+                        if (area <= 0) {
+                            return { error: \`Contour loop \${k} runs clockwise\` };
+                        }
+                    }
+
+                    // Every pattern sample equals a drop-cutter query at its XY. Spiral and pocket positions are generated
+                    // on the GPU in grid cells, so their float32 world XY can round across a grid line; those are skipped.
+                    const nearGridLine = (value, min) => {
+                        const grid = (value - min) / stepSize;
+                        const frac = Math.abs(grid - Math.round(grid));
+                        return frac > 1e-6 && frac < 1e-3;
+                    };
+                    const compare = async (name, polylines, exactXY) => {
+                        const xy = polylines.map(xyz => {
+                            const pairs = new Float32Array(xyz.length / 3 * 2);
+                            for (let i = 0; i < xyz.length / 3; i++) {
+                                pairs[i * 2] = xyz[i * 3];
+                                pairs[i * 2 + 1] = xyz[i * 3 + 1];
+                            }
+                            return pairs;
+                        });
+                        const queried = await rasterPath.queryToolZ(xy, tool, zFloor);
+                        let checked = 0;
+                        for (let p = 0; p < polylines.length; p++) {
+                            for (let i = 0; i < polylines[p].length; i += 3) {
+                                const x = polylines[p][i], y = polylines[p][i + 1];
+                                if (!exactXY && (nearGridLine(x, terrainBounds.min.x) || nearGridLine(y, terrainBounds.min.y))) {
+                                    continue;
+                                }
+                                if (polylines[p][i + 2] !== queried[p][i + 2]) {
+                                    return \`\${name} polyline \${p} sample \${i / 3} at (\${x}, \${y}) is \${polylines[p][i + 2]}, queryToolZ gives \${queried[p][i + 2]}\`;
+                                }
+                                checked++;
+                            }
+                        }
+                        console.log(\`✓ \${name}: \${checked} samples match queryToolZ\`);
+                        return null;
+                    };
+                    const error = await compare('Contour', contour.polylines, true) ||
+                        await compare('Spiral', spiral.polylines, false) ||
+                        await compare('Pocket', pocket.polylines, false);
+                    rasterPath.disposeTerrain();
+                    rasterPath.dispose();
+                    if (error) {
+                        return { error };
+                    }
+
+                    return {
+                        success: true,
+                        contourLoops: contour.polylines.length,
+                        contourSamples: contour.pointCount,
+                        spiralSamples: spiral.pointCount,
+                        pocketLoops: pocket.polylines.length
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Pattern toolpaths match queryToolZ');
+            console.log(`   Contour: ${result.contourLoops} loops (${result.contourSamples} samples), spiral: ${result.spiralSamples} samples, pocket: ${result.pocketLoops} loops`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
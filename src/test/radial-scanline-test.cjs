@@ -0,0 +1,191 @@
+// radial-scanline-test.cjs
+// Verify batched GPU radial scanlines match the legacy rasterize + generateRadialScanline path,
+// and that sector-binned radial jobs match unbinned ones over a full 360° job
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Radial Scanline Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -50;
+                    const terrainBounds = terrainResult.bounds;
+                    const tool = toolResult.positions;
+                    const xStep = 1;
+                    const rotationStep = 2.5; // Lands on sector edges as well as inside sectors
+
+                    // Batched job: every rotation rasterized and collided on the GPU in batches, binned by rotation sector
+                    const batched = await rasterPath.generateRadialToolpath(terrainTriangles, tool, rotationStep, xStep, zFloor, stepSize, terrainBounds);
+                    const { numRotations, pointsPerLine } = batched;
+                    console.log(\`✓ Batched radial toolpath: \${numRotations}x\${pointsPerLine}\`);
+
+                    // Worker requests that the public API no longer exposes
+                    const request = (type, data, responseType) => new Promise((resolve, reject) => {
+                        rasterPath._sendMessage(type, data, responseType, (reply) => reply && reply.error ? reject(new Error(reply.error)) : resolve(reply));
+                    });
+                    const compareRow = (label, row, scanline) => {
+                        if (scanline.length !== pointsPerLine) {
+                            return \`\${label} at \${row * rotationStep}° has \${scanline.length} points, batched has \${pointsPerLine}\`;
+                        }
+                        for (let x = 0; x < pointsPerLine; x++) {
+                            const expected = batched.pathData[row * pointsPerLine + x];
+                            if (!Object.is(scanline[x], expected)) {
+                                return \`\${label} at \${row * rotationStep}° point \${x} is \${scanline[x]}, batched gives \${expected}\`;
+                            }
+                        }
+                        return null;
+                    };
+
+                    // Legacy path: rasterize each rotated strip, then the JS scanline loop over it
+                    let toolRadius = 0;
+                    for (let i = 0; i < tool.length; i += 3) {
+                        toolRadius = Math.max(toolRadius, Math.abs(tool[i + 1] * stepSize));
+                    }
+                    const stripBounds = {
+                        min: { x: terrainBounds.min.x, y: -toolRadius, z: terrainBounds.min.z },
+                        max: { x: terrainBounds.max.x, y: toolRadius, z: terrainBounds.max.z }
+                    };
+                    const legacyRows = [0, 1, Math.floor(numRotations / 3), Math.floor(numRotations / 2), numRotations - 1];
+                    for (const row of legacyRows) {
+                        const strip = await request('rasterize', {
+                            triangles: terrainTriangles, stepSize, filterMode: 0, isForTool: false,
+                            boundsOverride: stripBounds, rotationAngleDeg: row * rotationStep
+                        }, 'rasterize-complete');
+                        const legacy = await request('generate-radial-scanline', {
+                            stripPositions: strip.positions, stripBounds: strip.bounds, toolPositions: tool, xStep, zFloor, gridStep: stepSize
+                        }, 'radial-scanline-complete');
+                        const error = compareRow('Legacy scanline', row, legacy.scanline);
+                        if (error) {
+                            return { error };
+                        }
+                    }
+                    console.log(\`✓ \${legacyRows.length} rotations match the legacy generateRadialScanline path\`);
+
+                    // Unbinned job: one 360° sector, so every rotation tests the whole mesh
+                    const jobId = rasterPath.nextJobId++;
+                    const angles = [];
+                    for (let row = 0; row < numRotations; row++) {
+                        angles.push(row * rotationStep);
+                    }
+                    await request('radial-job-begin', {
+                        jobId, triangles: terrainTriangles, toolPositions: tool, xStep, zFloor, gridStep: stepSize, terrainBounds, sectorDeg: 360
+                    }, 'radial-job-ready');
+                    let unbinned;
+                    try {
+                        unbinned = await request('radial-job-angles', { jobId, angles }, 'radial-job-scanlines');
+                    } finally {
+                        rasterPath.worker.postMessage({ type: 'radial-job-end', data: { jobId } });
+                    }
+                    for (let row = 0; row < numRotations; row++) {
+                        const error = compareRow('Unbinned row', row, unbinned.scanlines.subarray(row * pointsPerLine, (row + 1) * pointsPerLine));
+                        if (error) {
+                            return { error };
+                        }
+                    }
+                    console.log(\`✓ All \${numRotations} rotations match the unbinned job\`);
+
+                    rasterPath.dispose();
+
+                    return {
+                        success: true,
+                        numRotations,
+                        pointsPerLine,
+                        legacyRows: legacyRows.length
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Batched radial scanlines match the reference paths');
+            console.log(`   ${result.numRotations}x${result.pointsPerLine} batched radial toolpath matches the legacy scanline path on ${result.legacyRows} rotations and the unbinned job on all of them`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
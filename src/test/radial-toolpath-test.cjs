@@ -70,26 +70,9 @@ function createWindow() {
                 console.log(\`✓ Loaded terrain.stl: \${terrainBuffer.byteLength} bytes\`);
                 console.log(\`✓ Loaded tool.stl: \${toolBuffer.byteLength} bytes\`);
 
-                // Parse STL files (inline parser)
-                function parseBinarySTL(buffer) {
-                    const dataView = new DataView(buffer);
-                    const numTriangles = dataView.getUint32(80, true);
-                    const positions = new Float32Array(numTriangles * 9);
-                    let offset = 84;
-
-                    for (let i = 0; i < numTriangles; i++) {
-                        offset += 12; // Skip normal
-                        for (let j = 0; j < 9; j++) {
-                            positions[i * 9 + j] = dataView.getFloat32(offset, true);
-                            offset += 4;
-                        }
-                        offset += 2; // Skip attribute byte count
-                    }
-                    return positions;
-                }
-
-                const triangles = parseBinarySTL(terrainBuffer);
-                const toolTriangles = parseBinarySTL(toolBuffer);
+                // Parse STL files in the worker
+                const triangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
                 console.log(\`✓ Parsed terrain: \${triangles.length/9} triangles\`);
                 console.log(\`✓ Parsed tool: \${toolTriangles.length/9} triangles\`);
 
@@ -0,0 +1,165 @@
+// raster-angle-test.cjs
+// Verify angled raster passes equal the axis-aligned toolpath kernel at the matching grid cells
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Raster Angle Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -100;
+                    const terrainBounds = terrainResult.bounds;
+
+                    // Axis-aligned reference: one sample at every grid cell
+                    const dense = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 1, 1, zFloor, stepSize, { terrainBounds }
+                    );
+
+                    // A 45° pass must equal the axis-aligned kernel at the cell nearest each sample center
+                    const xStep = 3, yStep = 3;
+                    const angled = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, { terrainBounds, rasterAngle: 45 }
+                    );
+
+                    let compared = 0;
+                    for (let s = 0; s < angled.numScanlines; s++) {
+                        for (let i = 0; i < angled.pointsPerLine; i++) {
+                            const gx = angled.sampleOrigin.x + i * xStep * angled.scanDirection.x + s * yStep * angled.stepDirection.x;
+                            const gy = angled.sampleOrigin.y + i * xStep * angled.scanDirection.y + s * yStep * angled.stepDirection.y;
+                            // Skip centers too close to a cell boundary for float32 and float64 rounding to agree
+                            if (Math.abs(gx - Math.floor(gx) - 0.5) < 1e-3 || Math.abs(gy - Math.floor(gy) - 0.5) < 1e-3) continue;
+                            const cx = Math.floor(gx + 0.5), cy = Math.floor(gy + 0.5);
+                            if (cx < 0 || cy < 0 || cx >= dense.pointsPerLine || cy >= dense.numScanlines) continue;
+
+                            const expected = dense.pathData[cy * dense.pointsPerLine + cx];
+                            const actual = angled.pathData[s * angled.pointsPerLine + i];
+                            if (actual !== expected) {
+                                return { error: \`45° sample (\${i}, \${s}) at cell (\${cx}, \${cy}) is \${actual}, axis-aligned kernel gives \${expected}\` };
+                            }
+                            compared++;
+                        }
+                    }
+                    if (compared === 0) {
+                        return { error: 'No 45° samples fell on the terrain grid' };
+                    }
+
+                    // Unsupported combinations are rejected instead of silently ignored
+                    let rejected = 0;
+                    for (const extra of [{ simplifyTolerance: 0.01 }, { rest: { useStock: true, threshold: 0.1 } }]) {
+                        try {
+                            await rasterPath.generatePlanarToolpath(
+                                terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, { terrainBounds, rasterAngle: 45, ...extra }
+                            );
+                        } catch (error) {
+                            rejected++;
+                        }
+                    }
+                    rasterPath.dispose();
+                    if (rejected !== 2) {
+                        return { error: 'rasterAngle combined with simplifyTolerance or rest did not throw' };
+                    }
+
+                    return {
+                        success: true,
+                        compared,
+                        pointsPerLine: angled.pointsPerLine,
+                        numScanlines: angled.numScanlines
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Angled raster matches axis-aligned kernel');
+            console.log(`   45° pass: ${result.pointsPerLine}x${result.numScanlines}`);
+            console.log(`   Samples compared with the axis-aligned kernel: ${result.compared}`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,188 @@
+// rest-toolpath-test.cjs
+// Verify rest machining: after a tool too large for a slot, the small tool only cuts inside the slot
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Rest Toolpath Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // 20mm square flat terrain at Z=0 with a 1mm wide, 2mm deep slot along Y
+                    const gridStep = 0.125;
+                    const size = 161;
+                    const slotFirst = 76, slotLast = 84; // Slot columns
+                    const terrain = new Float32Array(size * size);
+                    for (let y = 0; y < size; y++) {
+                        for (let x = slotFirst; x <= slotLast; x++) {
+                            terrain[y * size + x] = -2;
+                        }
+                    }
+                    const terrainBounds = { min: { x: 0, y: 0, z: -2 }, max: { x: (size - 1) * gridStep, y: (size - 1) * gridStep, z: 0 } };
+
+                    // Flat end mills as grid points, radius in cells
+                    function flatTool(radius) {
+                        const points = [];
+                        for (let gy = -radius; gy <= radius; gy++) {
+                            for (let gx = -radius; gx <= radius; gx++) {
+                                if (gx * gx + gy * gy <= radius * radius) {
+                                    points.push(gx + radius, gy + radius, 0);
+                                }
+                            }
+                        }
+                        return new Float32Array(points);
+                    }
+                    const bigTool = flatTool(16);   // 4mm diameter, cannot enter the slot
+                    const smallTool = flatTool(2);  // 0.5mm diameter
+                    const zFloor = -100;
+
+                    const roughing = await rasterPath.generatePlanarToolpath(terrain, bigTool, 1, 1, zFloor, gridStep, { terrainBounds });
+                    const full = await rasterPath.generatePlanarToolpath(terrain, smallTool, 1, 1, zFloor, gridStep, { terrainBounds });
+                    const fullSimplified = await rasterPath.generatePlanarToolpath(terrain, smallTool, 1, 1, zFloor, gridStep, { terrainBounds, simplifyTolerance: 0 });
+                    const rest = await rasterPath.generatePlanarToolpath(terrain, smallTool, 1, 1, zFloor, gridStep, {
+                        terrainBounds,
+                        rest: { previous: { ...roughing, toolPositions: bigTool, xStep: 1, yStep: 1 }, threshold: 0.1 }
+                    });
+
+                    // Rest jobs without a remaining-stock source, or on another grid than the stock, reject
+                    const restError = async (rest) => {
+                        try {
+                            await rasterPath.generatePlanarToolpath(terrain, smallTool, 1, 1, zFloor, gridStep, { terrainBounds, rest });
+                            return null;
+                        } catch (error) {
+                            return error.message;
+                        }
+                    };
+                    const noSourceError = await restError({});
+                    if (!noSourceError || !noSourceError.includes('needs a previous toolpath')) {
+                        return { error: \`Rest job without a previous toolpath gave: \${noSourceError}\` };
+                    }
+                    const noStockError = await restError({ useStock: true });
+                    if (!noStockError || !noStockError.includes('No stock')) {
+                        return { error: \`Rest job without a stock gave: \${noStockError}\` };
+                    }
+                    await rasterPath.createStock({ min: { x: 0, y: 0, z: -2 }, max: { x: 20, y: 20, z: 0 } }, gridStep * 2);
+                    const gridStepError = await restError({ useStock: true });
+                    if (!gridStepError || !gridStepError.includes('does not match the stock grid step')) {
+                        return { error: \`Rest job on a coarser stock gave: \${gridStepError}\` };
+                    }
+                    rasterPath.disposeStock();
+                    rasterPath.dispose();
+                    console.log('✓ Invalid rest jobs reject');
+                    console.log(\`✓ Rest toolpath: \${rest.vertexCount} vertices, full toolpath: \${fullSimplified.vertexCount} simplified vertices\`);
+
+                    // Every kept vertex is inside the slot and matches the full small-tool toolpath there
+                    let kept = 0;
+                    for (let s = 0; s < rest.numScanlines; s++) {
+                        let keptInLine = 0;
+                        for (let v = rest.lineOffsets[s]; v < rest.lineOffsets[s + 1]; v++) {
+                            const pointIdx = rest.vertices[v * 2];
+                            const z = rest.vertices[v * 2 + 1];
+                            if (Number.isNaN(pointIdx) || Number.isNaN(z)) continue;
+                            if (pointIdx < slotFirst || pointIdx > slotLast) {
+                                return { error: \`Rest vertex on scanline \${s} at point \${pointIdx} is outside the slot\` };
+                            }
+                            const expected = full.pathData[s * full.pointsPerLine + pointIdx];
+                            if (z !== expected) {
+                                return { error: \`Rest vertex on scanline \${s} at point \${pointIdx} is \${z}, full toolpath gives \${expected}\` };
+                            }
+                            keptInLine++;
+                        }
+                        if (keptInLine === 0) {
+                            return { error: \`Scanline \${s} has no rest vertices in the slot\` };
+                        }
+                        kept += keptInLine;
+                    }
+                    if (rest.vertexCount >= fullSimplified.vertexCount) {
+                        return { error: \`Rest toolpath has \${rest.vertexCount} vertices, not fewer than the full toolpath's \${fullSimplified.vertexCount}\` };
+                    }
+
+                    return {
+                        success: true,
+                        restVertices: rest.vertexCount,
+                        keptVertices: kept,
+                        fullVertices: fullSimplified.vertexCount,
+                        fullSamples: full.pathData.length
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Rest toolpath covers only the uncut slot');
+            console.log(`   Rest vertices: ${result.restVertices} (${result.keptVertices} cutting)`);
+            console.log(`   Full toolpath: ${result.fullVertices} simplified vertices, ${result.fullSamples} samples`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
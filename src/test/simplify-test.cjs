@@ -0,0 +1,199 @@
+// simplify-test.cjs
+// Verify GPU toolpath simplification: dropped samples stay within tolerance of the polyline and NaN breaks are kept
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Simplify Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -100;
+                    const terrainBounds = terrainResult.bounds;
+                    const tolerance = 0.01;
+
+                    // Dense reference at one sample per grid cell
+                    const dense = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 1, 1, zFloor, stepSize, { terrainBounds }
+                    );
+                    const { pointsPerLine, numScanlines } = dense;
+
+                    // Check a simplified result against the dense samples: emitted vertices are exact samples and every
+                    // sample dropped between two emitted vertices lies within tolerance of the chord joining them
+                    function checkSimplified(label, simplified) {
+                        if (simplified.pointsPerLine !== pointsPerLine || simplified.numScanlines !== numScanlines) {
+                            return { error: \`\${label}: \${simplified.pointsPerLine}x\${simplified.numScanlines}, expected \${pointsPerLine}x\${numScanlines}\` };
+                        }
+                        let maxDeviation = 0;
+                        const breaks = [];
+                        for (let s = 0; s < numScanlines; s++) {
+                            const row = s * pointsPerLine;
+                            const first = simplified.lineOffsets[s], last = simplified.lineOffsets[s + 1];
+                            for (let v = first; v < last; v++) {
+                                const i = simplified.vertices[v * 2], z = simplified.vertices[v * 2 + 1];
+                                if (Number.isNaN(z)) {
+                                    breaks.push(row + i);
+                                    continue;
+                                }
+                                if (z !== dense.pathData[row + i]) {
+                                    return { error: \`\${label}: vertex on scanline \${s} at \${i} is \${z}, dense sample is \${dense.pathData[row + i]}\` };
+                                }
+                                if (v + 1 >= last || Number.isNaN(simplified.vertices[v * 2 + 3])) continue;
+                                const j = simplified.vertices[v * 2 + 2], zj = simplified.vertices[v * 2 + 3];
+                                for (let k = i + 1; k < j; k++) {
+                                    const chord = z + (zj - z) * (k - i) / (j - i);
+                                    const deviation = Math.abs(dense.pathData[row + k] - chord);
+                                    if (deviation > tolerance + 1e-5) {
+                                        return { error: \`\${label}: dropped sample \${k} on scanline \${s} is \${deviation} from the polyline\` };
+                                    }
+                                    maxDeviation = Math.max(maxDeviation, deviation);
+                                }
+                            }
+                        }
+                        return { maxDeviation, breaks };
+                    }
+
+                    // Plain toolpath: no breaks, first and last sample of each line kept
+                    const simplified = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 1, 1, zFloor, stepSize, { terrainBounds, simplifyTolerance: tolerance }
+                    );
+                    const plain = checkSimplified('Simplified', simplified);
+                    if (plain.error) return plain;
+                    for (let s = 0; s < numScanlines; s++) {
+                        const first = simplified.lineOffsets[s], last = simplified.lineOffsets[s + 1] - 1;
+                        if (simplified.vertices[first * 2] !== 0 || simplified.vertices[last * 2] !== pointsPerLine - 1) {
+                            return { error: \`Scanline \${s} does not start at sample 0 and end at sample \${pointsPerLine - 1}\` };
+                        }
+                    }
+                    console.log(\`✓ Simplified \${dense.pathData.length} samples to \${simplified.vertexCount} vertices\`);
+
+                    // Rest machining masks samples to NaN: the breaks survive simplification unchanged
+                    const previous = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 1, 4, zFloor, stepSize, { terrainBounds }
+                    );
+                    const rest = { previous: { ...previous, toolPositions: toolResult.positions, xStep: 1, yStep: 4 }, threshold: 0.01 };
+                    const restExact = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 1, 1, zFloor, stepSize, { terrainBounds, rest, simplifyTolerance: 0 }
+                    );
+                    const restSimplified = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 1, 1, zFloor, stepSize, { terrainBounds, rest, simplifyTolerance: tolerance }
+                    );
+                    rasterPath.dispose();
+
+                    const exact = checkSimplified('Rest, tolerance 0', restExact);
+                    if (exact.error) return exact;
+                    const masked = checkSimplified('Rest', restSimplified);
+                    if (masked.error) return masked;
+                    if (masked.breaks.length === 0) {
+                        return { error: 'Rest toolpath has no NaN breaks to check' };
+                    }
+                    if (masked.breaks.length !== exact.breaks.length || masked.breaks.some((b, k) => b !== exact.breaks[k])) {
+                        return { error: \`Simplification changed the breaks: \${masked.breaks.length} at tolerance \${tolerance}, \${exact.breaks.length} at 0\` };
+                    }
+
+                    return {
+                        success: true,
+                        samples: dense.pathData.length,
+                        vertices: simplified.vertexCount,
+                        maxDeviation: Math.max(plain.maxDeviation, masked.maxDeviation),
+                        breaks: masked.breaks.length,
+                        restVertices: restSimplified.vertexCount
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Simplified toolpaths stay within tolerance');
+            console.log(`   ${result.samples} samples simplified to ${result.vertices} vertices`);
+            console.log(`   Max deviation of a dropped sample: ${result.maxDeviation.toFixed(5)}mm`);
+            console.log(`   Rest toolpath: ${result.restVertices} vertices, ${result.breaks} NaN breaks kept`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
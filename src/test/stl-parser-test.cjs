@@ -0,0 +1,207 @@
+// stl-parser-test.cjs
+// Verify the worker STL parser: ASCII and binary in any chunking, truncated input, empty solids and binary headers that start with "solid"
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== STL Parser Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Three triangles with negative, exponent and many-digit coordinates
+                    const coordinates = [
+                        ['0', '0', '0'], ['1.5', '-2.25', '3'], ['-4.125e1', '5E-1', '6.000001'],
+                        ['7', '8.5', '-9'], ['1.0e+2', '-0.001', '0.3333333333333333'], ['12', '13', '14'],
+                        ['-1', '-1', '-1'], ['2.5', '2.5', '2.5'], ['3.75', '-3.75', '1e-3']
+                    ];
+                    const expected = new Float32Array(coordinates.flat().map(Number));
+                    const triangleCount = expected.length / 9;
+
+                    const facetText = (t) => [
+                        '  facet normal 0 0 1',
+                        '    outer loop',
+                        ...coordinates.slice(t * 3, t * 3 + 3).map(v => \`      vertex \${v.join(' ')}\`),
+                        '    endloop',
+                        '  endfacet'
+                    ].join('\\n') + '\\n';
+                    const encoder = new TextEncoder();
+                    const asciiSTL = (name, count) => {
+                        let text = \`solid \${name}\\n\`;
+                        for (let t = 0; t < count; t++) text += facetText(t);
+                        return encoder.encode(text + \`endsolid \${name}\\n\`);
+                    };
+                    const binarySTL = (header, count) => {
+                        const bytes = new Uint8Array(84 + count * 50);
+                        bytes.set(encoder.encode(header).subarray(0, 80));
+                        const view = new DataView(bytes.buffer);
+                        view.setUint32(80, count, true);
+                        for (let t = 0; t < count; t++) {
+                            view.setFloat32(84 + t * 50 + 8, 1, true);
+                            for (let k = 0; k < 9; k++) {
+                                view.setFloat32(84 + t * 50 + 12 + k * 4, expected[t * 9 + k], true);
+                            }
+                        }
+                        return bytes;
+                    };
+
+                    // Feed bytes as one transferred ArrayBuffer, or as a stream of chunkSize-byte chunks (size unknown up front)
+                    const parse = (bytes, chunkSize) => {
+                        if (!chunkSize) {
+                            return rasterPath.parseSTL(bytes.slice().buffer);
+                        }
+                        let offset = 0;
+                        const stream = new ReadableStream({
+                            pull(controller) {
+                                if (offset >= bytes.length) {
+                                    controller.close();
+                                    return;
+                                }
+                                controller.enqueue(bytes.slice(offset, offset + chunkSize));
+                                offset += chunkSize;
+                            }
+                        });
+                        return rasterPath.parseSTL(stream);
+                    };
+
+                    const expectTriangles = (name, result, count) => {
+                        if (result.triangleCount !== count || result.triangles.length !== count * 9) {
+                            return \`\${name}: \${result.triangleCount} triangles (\${result.triangles.length} floats), expected \${count}\`;
+                        }
+                        for (let i = 0; i < count * 9; i++) {
+                            if (result.triangles[i] !== expected[i]) {
+                                return \`\${name}: float \${i} is \${result.triangles[i]}, expected \${expected[i]}\`;
+                            }
+                        }
+                        if (count > 0) {
+                            const axes = ['x', 'y', 'z'];
+                            for (let a = 0; a < 3; a++) {
+                                let min = Infinity, max = -Infinity;
+                                for (let i = a; i < count * 9; i += 3) {
+                                    min = Math.min(min, expected[i]);
+                                    max = Math.max(max, expected[i]);
+                                }
+                                if (result.bounds.min[axes[a]] !== min || result.bounds.max[axes[a]] !== max) {
+                                    return \`\${name}: \${axes[a]} bounds \${result.bounds.min[axes[a]]}..\${result.bounds.max[axes[a]]}, expected \${min}..\${max}\`;
+                                }
+                            }
+                        }
+                        return null;
+                    };
+
+                    const binaryHeader = 'binary STL written by the parser test';
+                    const twoFacetsBytes = asciiSTL('part', 2).length - encoder.encode('endsolid part\\n').length;
+                    const files = [
+                        { name: 'ASCII', bytes: asciiSTL('part', triangleCount), count: triangleCount },
+                        { name: 'Binary', bytes: binarySTL(binaryHeader, triangleCount), count: triangleCount },
+                        // Binary header that reads like the start of an ASCII file
+                        { name: 'Binary with "solid ... facet" header', bytes: binarySTL('solid part facet normal 0 0 1 outer loop vertex', triangleCount), count: triangleCount },
+                        // Truncated mid facet / mid record: only whole triangles are kept
+                        { name: 'Truncated ASCII', bytes: asciiSTL('part', triangleCount).subarray(0, twoFacetsBytes + 60), count: 2 },
+                        { name: 'Truncated binary', bytes: binarySTL(binaryHeader, triangleCount).subarray(0, 84 + 2 * 50 + 17), count: 2 },
+                        { name: 'Binary without triangles', bytes: binarySTL('solid empty', 0), count: 0 },
+                        { name: 'Empty solid', bytes: encoder.encode('solid empty\\nendsolid empty\\n'), count: 0 },
+                        // Longer than a binary header plus one record, so it would read as garbage triangles if taken for binary
+                        { name: 'Empty solid with long name', bytes: encoder.encode(\`solid \${'x'.repeat(150)}\\nendsolid\\n\`), count: 0 }
+                    ];
+                    const chunkSizes = [0, 1, 7, 333];
+
+                    let parses = 0;
+                    for (const file of files) {
+                        for (const chunkSize of chunkSizes) {
+                            const name = \`\${file.name} (\${chunkSize ? \`\${chunkSize}-byte chunks\` : 'ArrayBuffer'})\`;
+                            const error = expectTriangles(name, await parse(file.bytes, chunkSize), file.count);
+                            if (error) {
+                                return { error };
+                            }
+                            parses++;
+                        }
+                        console.log(\`✓ \${file.name}: \${file.count} triangles in every chunking\`);
+                    }
+                    rasterPath.dispose();
+
+                    return {
+                        success: true,
+                        files: files.length,
+                        parses
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ STL parser returns the same triangles for every chunking');
+            console.log(`   ${result.files} files parsed ${result.parses} ways with identical triangles`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,192 @@
+// stock-simulation-test.cjs
+// Verify stock simulation: a ball-nose pass cuts its profile into a box stock and only the touched band reads back dirty
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Stock Simulation Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Stock errors reject instead of leaving the call waiting
+                    const rejection = async (promise) => {
+                        try {
+                            await promise;
+                            return null;
+                        } catch (error) {
+                            return error.message;
+                        }
+                    };
+                    const noStockError = await rejection(rasterPath.readStock());
+                    if (!noStockError || !noStockError.includes('No stock')) {
+                        return { error: \`readStock without a stock gave: \${noStockError}\` };
+                    }
+                    const heightsError = await rejection(rasterPath.createStock(
+                        { min: { x: 0, y: 0, z: -5 }, max: { x: 20, y: 40, z: 0 } }, 0.1, { heights: new Float32Array(10) }
+                    ));
+                    if (!heightsError || !heightsError.includes('Stock heights must be')) {
+                        return { error: \`createStock with mis-sized heights gave: \${heightsError}\` };
+                    }
+                    console.log('✓ Stock errors reject');
+
+                    // 20 x 40mm box stock, top at Z=0, on a 0.1mm grid
+                    const gridStep = 0.1;
+                    const stock = await rasterPath.createStock({ min: { x: 0, y: 0, z: -5 }, max: { x: 20, y: 40, z: 0 } }, gridStep);
+                    console.log(\`✓ Stock: \${stock.width}x\${stock.height}, \${stock.bandRows} rows per band\`);
+
+                    // A fresh stock is all dirty; read it once to clear the flags
+                    const fresh = await rasterPath.readStock();
+                    const freshRows = fresh.regions.reduce((sum, region) => sum + region.rowCount, 0);
+                    if (freshRows !== stock.height) {
+                        return { error: \`Fresh stock returned \${freshRows} dirty rows, expected all \${stock.height}\` };
+                    }
+
+                    // 1mm radius ball-nose tool as grid points (tip at Z=0)
+                    const toolRadius = 10; // cells
+                    const toolPoints = [];
+                    for (let gy = -toolRadius; gy <= toolRadius; gy++) {
+                        for (let gx = -toolRadius; gx <= toolRadius; gx++) {
+                            const d2 = (gx * gx + gy * gy) * gridStep * gridStep;
+                            if (gx * gx + gy * gy <= toolRadius * toolRadius) {
+                                toolPoints.push(gx + toolRadius, gy + toolRadius, 1 - Math.sqrt(1 - d2));
+                            }
+                        }
+                    }
+                    const toolPositions = new Float32Array(toolPoints);
+
+                    // One flat pass at Z=-2 along Y=10mm, one sample per grid cell across the whole stock
+                    const tipZ = -2;
+                    const pointsPerLine = stock.width;
+                    const toolpath = { pathData: new Float32Array(pointsPerLine).fill(tipZ), numScanlines: 1, pointsPerLine };
+                    const pathRow = 100;
+                    const sim = await rasterPath.simulateToolpath(toolpath, toolPositions, 1, 1, { x: 0, y: pathRow * gridStep });
+                    if (sim.changedBands !== 1) {
+                        return { error: \`Simulation changed \${sim.changedBands} bands, expected 1\` };
+                    }
+
+                    // Only the band holding rows 90-110 comes back dirty
+                    const dirty = await rasterPath.readStock();
+                    if (dirty.regions.length !== 1) {
+                        return { error: \`Expected 1 dirty region, got \${dirty.regions.length}\` };
+                    }
+                    const region = dirty.regions[0];
+                    const expectedStart = Math.floor(pathRow / stock.bandRows) * stock.bandRows;
+                    if (region.rowStart !== expectedStart || region.rowCount !== stock.bandRows) {
+                        return { error: \`Dirty region is rows \${region.rowStart}+\${region.rowCount}, expected \${expectedStart}+\${stock.bandRows}\` };
+                    }
+
+                    // Cut heights follow the ball profile across the pass and leave the rest of the band at the top
+                    let maxError = 0;
+                    for (let r = 0; r < region.rowCount; r++) {
+                        const dy = region.rowStart + r - pathRow;
+                        const expected = Math.abs(dy) <= toolRadius
+                            ? Math.min(0, tipZ + Math.fround(1 - Math.sqrt(1 - dy * dy * gridStep * gridStep)))
+                            : 0;
+                        for (let x = 0; x < stock.width; x++) {
+                            const actual = region.heights[r * stock.width + x];
+                            const error = Math.abs(actual - expected);
+                            if (error > 1e-5) {
+                                return { error: \`Stock cell (\${x}, \${region.rowStart + r}) is \${actual}, expected \${expected}\` };
+                            }
+                            maxError = Math.max(maxError, error);
+                        }
+                    }
+
+                    // Nothing changed since the last read
+                    const clean = await rasterPath.readStock();
+                    rasterPath.disposeStock();
+                    rasterPath.dispose();
+                    if (clean.regions.length !== 0) {
+                        return { error: \`Expected no dirty regions after reading, got \${clean.regions.length}\` };
+                    }
+
+                    return {
+                        success: true,
+                        width: stock.width,
+                        height: stock.height,
+                        dirtyRows: \`\${region.rowStart}-\${region.rowStart + region.rowCount - 1}\`,
+                        maxError
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Stock simulation matches the tool profile');
+            console.log(`   Stock: ${result.width}x${result.height}`);
+            console.log(`   Dirty rows after one pass: ${result.dirtyRows}`);
+            console.log(`   Max cut height error: ${result.maxError.toExponential(2)}`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,157 @@
+// tiled-equality-test.cjs
+// Verify planar toolpaths forced into small tiles are bit-identical to the untiled toolpath
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Tiled Equality Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -100;
+                    const terrainBounds = terrainResult.bounds;
+                    const width = Math.ceil((terrainBounds.max.x - terrainBounds.min.x) / stepSize) + 1;
+                    const height = Math.ceil((terrainBounds.max.y - terrainBounds.min.y) / stepSize) + 1;
+                    const safetyMargin = 0.8;
+
+                    // Output budgets that force roughly this many tiles; the default budget runs the same job untiled
+                    const cases = [
+                        { xStep: 1, yStep: 1, tiles: 3 },
+                        { xStep: 1, yStep: 1, tiles: 12 },
+                        { xStep: 3, yStep: 2, tiles: 2 }
+                    ];
+                    const results = [];
+                    for (const { xStep, yStep, tiles } of cases) {
+                        const outputBytes = Math.ceil(width / xStep) * Math.ceil(height / yStep) * 4;
+                        if (outputBytes > rasterPath.getConfig().maxGPUMemoryMB * 1024 * 1024 * safetyMargin) {
+                            return { error: \`Reference \${xStep}x\${yStep} toolpath would be tiled too\` };
+                        }
+                        const reference = await rasterPath.generatePlanarToolpath(
+                            terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, { terrainBounds }
+                        );
+
+                        const maxGPUMemoryMB = outputBytes / tiles / safetyMargin / (1024 * 1024);
+                        const tiledPath = new RasterPath({ maxGPUMemoryMB, gpuMemorySafetyMargin: safetyMargin, parallelWorkers: 3 });
+                        await tiledPath.init();
+                        // Shared tiles run across the pool when the page is cross-origin isolated, on the primary worker otherwise
+                        await tiledPath.initWorkerPool();
+                        const tiled = await tiledPath.generatePlanarToolpath(
+                            terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, { terrainBounds }
+                        );
+                        tiledPath.dispose();
+
+                        if (tiled.numScanlines !== reference.numScanlines || tiled.pointsPerLine !== reference.pointsPerLine) {
+                            return { error: \`Tiled \${xStep}x\${yStep} toolpath is \${tiled.pointsPerLine}x\${tiled.numScanlines}, untiled is \${reference.pointsPerLine}x\${reference.numScanlines}\` };
+                        }
+                        for (let i = 0; i < reference.pathData.length; i++) {
+                            if (!Object.is(tiled.pathData[i], reference.pathData[i])) {
+                                const s = Math.floor(i / reference.pointsPerLine), p = i % reference.pointsPerLine;
+                                return { error: \`Tiled \${xStep}x\${yStep} toolpath (~\${tiles} tiles) differs at (\${p}, \${s}): \${tiled.pathData[i]} vs \${reference.pathData[i]}\` };
+                            }
+                        }
+                        console.log(\`✓ ~\${tiles} tiles, \${xStep}x\${yStep} step: \${reference.pointsPerLine}x\${reference.numScanlines} bit-identical\`);
+                        results.push(\`~\${tiles} tiles at \${xStep}x\${yStep}\`);
+                    }
+                    rasterPath.dispose();
+
+                    return {
+                        success: true,
+                        cases: results.join(', '),
+                        crossOriginIsolated: globalThis.crossOriginIsolated === true
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Tiled toolpaths match untiled toolpaths');
+            console.log(`   Tiled toolpaths (${result.cases}) are bit-identical to the untiled ones (pool shared tiles: ${result.crossOriginIsolated})`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
@@ -0,0 +1,182 @@
+// tool-query-test.cjs
+// Verify queryToolZ at grid-aligned positions equals the matching generatePlanarToolpath samples,
+// and that off-grid positions take the highest surrounding grid center
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Tool Query Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -100;
+                    const terrainBounds = terrainResult.bounds;
+                    const xStep = 3, yStep = 2;
+
+                    const toolpath = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, { terrainBounds }
+                    );
+
+                    // Querying before a terrain is loaded rejects
+                    let noTerrainError = null;
+                    try {
+                        await rasterPath.queryToolZ(new Float32Array([0, 0]), toolResult.positions, zFloor);
+                    } catch (error) {
+                        noTerrainError = error.message;
+                    }
+                    if (!noTerrainError || !noTerrainError.includes('No terrain')) {
+                        return { error: \`queryToolZ without a terrain gave: \${noTerrainError}\` };
+                    }
+
+                    await rasterPath.loadTerrain(terrainResult.positions, stepSize, terrainBounds);
+
+                    // Query the world XY of every toolpath sample
+                    const { numScanlines, pointsPerLine } = toolpath;
+                    const queries = new Float32Array(numScanlines * pointsPerLine * 2);
+                    for (let s = 0; s < numScanlines; s++) {
+                        for (let i = 0; i < pointsPerLine; i++) {
+                            const q = (s * pointsPerLine + i) * 2;
+                            queries[q] = terrainBounds.min.x + i * xStep * stepSize;
+                            queries[q + 1] = terrainBounds.min.y + s * yStep * stepSize;
+                        }
+                    }
+                    const z = await rasterPath.queryToolZ(queries, toolResult.positions, zFloor);
+
+                    // Off-grid queries between each sample and its +X/+Y neighbour cells, with the four
+                    // surrounding grid centers queried alongside them
+                    const offGridQueries = new Float32Array(numScanlines * pointsPerLine * 10);
+                    for (let s = 0; s < numScanlines; s++) {
+                        for (let i = 0; i < pointsPerLine; i++) {
+                            const q = (s * pointsPerLine + i) * 10;
+                            const x = terrainBounds.min.x + i * xStep * stepSize;
+                            const y = terrainBounds.min.y + s * yStep * stepSize;
+                            offGridQueries.set([
+                                x + 0.5 * stepSize, y + 0.25 * stepSize,
+                                x, y, x + stepSize, y, x, y + stepSize, x + stepSize, y + stepSize
+                            ], q);
+                        }
+                    }
+                    const offGridZ = await rasterPath.queryToolZ(offGridQueries, toolResult.positions, zFloor);
+                    rasterPath.disposeTerrain();
+                    rasterPath.dispose();
+
+                    // Off-grid queries take the highest surrounding grid center, so they never gouge
+                    for (let k = 0; k < offGridZ.length; k += 5) {
+                        const highest = Math.max(offGridZ[k + 1], offGridZ[k + 2], offGridZ[k + 3], offGridZ[k + 4]);
+                        if (offGridZ[k] !== highest) {
+                            return { error: \`Off-grid query \${k / 5} is \${offGridZ[k]}, the highest surrounding grid center is \${highest}\` };
+                        }
+                    }
+
+                    if (z.length !== toolpath.pathData.length) {
+                        return { error: \`queryToolZ returned \${z.length} values for \${toolpath.pathData.length} queries\` };
+                    }
+                    for (let k = 0; k < z.length; k++) {
+                        if (z[k] !== toolpath.pathData[k]) {
+                            const s = Math.floor(k / pointsPerLine), i = k % pointsPerLine;
+                            return { error: \`Query at sample (\${i}, \${s}) is \${z[k]}, generatePlanarToolpath gives \${toolpath.pathData[k]}\` };
+                        }
+                    }
+
+                    return {
+                        success: true,
+                        queryCount: z.length,
+                        pointsPerLine,
+                        numScanlines
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ queryToolZ matches planar toolpath');
+            console.log(`   ${result.queryCount} grid-aligned queries (${result.pointsPerLine}x${result.numScanlines}) match the planar toolpath`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
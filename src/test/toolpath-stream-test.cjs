@@ -0,0 +1,191 @@
+// toolpath-stream-test.cjs
+// Verify binary toolpath streams reproduce the one-shot planar and radial toolpaths, including two streams read at once
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Toolpath Stream Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const zFloor = -100;
+                    const terrainBounds = terrainResult.bounds;
+
+                    // Read a binary stream to the end and view it as the Float32 rows it carries
+                    async function readBinary(stream) {
+                        const chunks = [];
+                        let length = 0;
+                        const reader = stream.getReader();
+                        while (true) {
+                            const { value, done } = await reader.read();
+                            if (done) break;
+                            chunks.push(value);
+                            length += value.length;
+                        }
+                        const bytes = new Uint8Array(length);
+                        let offset = 0;
+                        for (const chunk of chunks) {
+                            bytes.set(chunk, offset);
+                            offset += chunk.length;
+                        }
+                        return { data: new Float32Array(bytes.buffer), chunkCount: chunks.length };
+                    }
+
+                    function compare(label, actual, expected) {
+                        if (actual.length !== expected.length) {
+                            return \`\${label}: streamed \${actual.length} values, expected \${expected.length}\`;
+                        }
+                        for (let i = 0; i < expected.length; i++) {
+                            if (!Object.is(actual[i], expected[i])) {
+                                return \`\${label}: value \${i} is \${actual[i]}, expected \${expected[i]}\`;
+                            }
+                        }
+                        return null;
+                    }
+
+                    // Planar: concatenated chunks equal the one-shot pathData
+                    const planar = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 2, 4, zFloor, stepSize, { terrainBounds }
+                    );
+                    const planarStream = await rasterPath.streamPlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 2, 4, zFloor, stepSize,
+                        { terrainBounds, format: 'binary', chunkScanlines: 16 }
+                    );
+                    const planarStreamed = await readBinary(planarStream.stream);
+                    let error = compare('Planar', planarStreamed.data, planar.pathData);
+                    if (error) return { error };
+                    console.log(\`✓ Planar: \${planarStreamed.chunkCount} chunks match generatePlanarToolpath\`);
+
+                    // Radial: concatenated chunks equal the one-shot pathData
+                    const radialZFloor = -50;
+                    const radial = await rasterPath.generateRadialToolpath(
+                        terrainTriangles, toolResult.positions, 10, 1, radialZFloor, stepSize, terrainBounds
+                    );
+                    const radialStream = await rasterPath.streamRadialToolpath(
+                        terrainTriangles, toolResult.positions, 10, 1, radialZFloor, stepSize, terrainBounds,
+                        { format: 'binary', chunkAngles: 3 }
+                    );
+                    const radialStreamed = await readBinary(radialStream.stream);
+                    error = compare('Radial', radialStreamed.data, radial.pathData);
+                    if (error) return { error };
+                    console.log(\`✓ Radial: \${radialStreamed.chunkCount} chunks match generateRadialToolpath\`);
+
+                    // Two streams open at once are read interleaved and stay independent
+                    const first = await rasterPath.streamPlanarToolpath(
+                        terrainResult.positions, toolResult.positions, 2, 4, zFloor, stepSize,
+                        { terrainBounds, format: 'binary', chunkScanlines: 16 }
+                    );
+                    const second = await rasterPath.streamRadialToolpath(
+                        terrainTriangles, toolResult.positions, 10, 1, radialZFloor, stepSize, terrainBounds,
+                        { format: 'binary', chunkAngles: 3 }
+                    );
+                    const [firstStreamed, secondStreamed] = await Promise.all([readBinary(first.stream), readBinary(second.stream)]);
+                    rasterPath.dispose();
+                    error = compare('Concurrent planar', firstStreamed.data, planar.pathData) ||
+                        compare('Concurrent radial', secondStreamed.data, radial.pathData);
+                    if (error) return { error };
+
+                    return {
+                        success: true,
+                        planarChunks: planarStreamed.chunkCount,
+                        planarValues: planar.pathData.length,
+                        radialChunks: radialStreamed.chunkCount,
+                        radialValues: radial.pathData.length
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Toolpath streams match one-shot toolpaths');
+            console.log(`   Planar: ${result.planarValues} values in ${result.planarChunks} chunks`);
+            console.log(`   Radial: ${result.radialValues} values in ${result.radialChunks} chunks`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
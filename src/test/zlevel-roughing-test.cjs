@@ -0,0 +1,221 @@
+// zlevel-roughing-test.cjs
+// Verify Z-level roughing segments against layers rebuilt on the CPU from the dense planar toolpath
+
+const { app, BrowserWindow } = require('electron');
+const path = require('path');
+
+let mainWindow;
+
+function createWindow() {
+    mainWindow = new BrowserWindow({
+        width: 1200,
+        height: 800,
+        show: false,
+        webPreferences: {
+            nodeIntegration: false,
+            contextIsolation: true,
+            enableBlinkFeatures: 'WebGPU',
+        }
+    });
+
+    const htmlPath = path.join(__dirname, '../../build/index.html');
+    mainWindow.loadFile(htmlPath);
+
+    mainWindow.webContents.on('did-finish-load', async () => {
+        console.log('✓ Page loaded');
+
+        const testScript = `
+            (async function() {
+                try {
+                    console.log('=== Z-Level Roughing Test ===');
+
+                    if (!navigator.gpu) {
+                        return { error: 'WebGPU not available' };
+                    }
+
+                    const { RasterPath } = await import('./raster-path.js');
+                    const rasterPath = new RasterPath();
+                    await rasterPath.init();
+                    console.log('✓ RasterPath initialized');
+
+                    // Load STL files from benchmark/fixtures
+                    const terrainResponse = await fetch('../benchmark/fixtures/terrain.stl');
+                    const terrainBuffer = await terrainResponse.arrayBuffer();
+                    const toolResponse = await fetch('../benchmark/fixtures/tool.stl');
+                    const toolBuffer = await toolResponse.arrayBuffer();
+
+                    // Parse STL files in the worker
+                    const terrainTriangles = (await rasterPath.parseSTL(terrainBuffer)).triangles;
+                    const toolTriangles = (await rasterPath.parseSTL(toolBuffer)).triangles;
+
+                    const stepSize = 0.05;
+                    const terrainResult = await rasterPath.rasterizeMesh(terrainTriangles, stepSize, 0);
+                    const toolResult = await rasterPath.rasterizeMesh(toolTriangles, stepSize, 1);
+                    console.log(\`✓ Terrain: \${terrainResult.pointCount} points, tool: \${toolResult.pointCount} points\`);
+
+                    const terrainBounds = terrainResult.bounds;
+                    const xStep = 2, yStep = 3, allowance = 0.25;
+
+                    // Dense planar toolpath over the same grid; its floor sits below every layer, as the roughing floor does
+                    const zFloor = terrainBounds.min.z - 1000;
+                    const planar = await rasterPath.generatePlanarToolpath(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, zFloor, stepSize, { terrainBounds }
+                    );
+                    const { pathData, numScanlines, pointsPerLine } = planar;
+
+                    // Layers spread over the toolpath's Z range, plus one above everything and one below it
+                    let minZ = Infinity, maxZ = -Infinity;
+                    for (const z of pathData) {
+                        if (z > zFloor) {
+                            minZ = Math.min(minZ, z);
+                            maxZ = Math.max(maxZ, z);
+                        }
+                    }
+                    const zLevels = [maxZ + 1, ...[0.8, 0.6, 0.4, 0.2].map(t => minZ + t * (maxZ - minZ)), minZ - 1];
+
+                    // Rebuild each layer on the CPU: a sample is cut where toolZ + allowance <= level (in f32, as on the GPU),
+                    // runs become (start, end) pairs and odd rows are reversed into a zig-zag
+                    const expectedOffsets = [0];
+                    const expectedSegments = [];
+                    for (const level of zLevels) {
+                        const levelF32 = Math.fround(level);
+                        for (let s = 0; s < numScanlines; s++) {
+                            const runs = [];
+                            let runStart = -1;
+                            for (let x = 0; x <= pointsPerLine; x++) {
+                                const cut = x < pointsPerLine &&
+                                    Math.fround(pathData[s * pointsPerLine + x] + Math.fround(allowance)) <= levelF32;
+                                if (cut && runStart < 0) {
+                                    runStart = x;
+                                } else if (!cut && runStart >= 0) {
+                                    runs.push([runStart, x - 1]);
+                                    runStart = -1;
+                                }
+                            }
+                            if (s % 2 === 1) {
+                                runs.reverse();
+                                for (const run of runs) run.reverse();
+                            }
+                            for (const run of runs) expectedSegments.push(...run);
+                            expectedOffsets.push(expectedSegments.length / 2);
+                        }
+                    }
+
+                    const compare = (name, roughing) => {
+                        if (roughing.numScanlines !== numScanlines || roughing.pointsPerLine !== pointsPerLine) {
+                            return \`\${name} roughing is \${roughing.pointsPerLine}x\${roughing.numScanlines}, planar is \${pointsPerLine}x\${numScanlines}\`;
+                        }
+                        if (roughing.segmentOffsets.length !== expectedOffsets.length) {
+                            return \`\${name} roughing has \${roughing.segmentOffsets.length} segment offsets, expected \${expectedOffsets.length}\`;
+                        }
+                        for (let i = 0; i < expectedOffsets.length; i++) {
+                            if (roughing.segmentOffsets[i] !== expectedOffsets[i]) {
+                                const layer = Math.floor(i / numScanlines), s = i % numScanlines;
+                                return \`\${name} roughing segmentOffsets[\${i}] (layer \${layer}, scanline \${s}) is \${roughing.segmentOffsets[i]}, expected \${expectedOffsets[i]}\`;
+                            }
+                        }
+                        for (let i = 0; i < expectedSegments.length; i++) {
+                            if (roughing.segments[i] !== expectedSegments[i]) {
+                                return \`\${name} roughing segment value \${i} is \${roughing.segments[i]}, expected \${expectedSegments[i]}\`;
+                            }
+                        }
+                        return null;
+                    };
+
+                    const roughing = await rasterPath.generateZLevelRoughing(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, stepSize, zLevels, { terrainBounds, allowance }
+                    );
+                    const untiledError = compare('Untiled', roughing);
+                    if (untiledError) {
+                        return { error: untiledError };
+                    }
+                    console.log(\`✓ \${zLevels.length} layers, \${roughing.segmentCount} segments match the CPU rebuild\`);
+
+                    // The same job split into tile bands interleaves back into the same layout
+                    // A budget of a third of the terrain limits each band to roughly a third of its rows
+                    const width = Math.ceil((terrainBounds.max.x - terrainBounds.min.x) / stepSize) + 1;
+                    const height = Math.ceil((terrainBounds.max.y - terrainBounds.min.y) / stepSize) + 1;
+                    const tiledPath = new RasterPath({ maxGPUMemoryMB: width * height * 4 / 3 / 0.8 / (1024 * 1024), gpuMemorySafetyMargin: 0.8 });
+                    await tiledPath.init();
+                    const tiled = await tiledPath.generateZLevelRoughing(
+                        terrainResult.positions, toolResult.positions, xStep, yStep, stepSize, zLevels, { terrainBounds, allowance }
+                    );
+                    tiledPath.dispose();
+                    const tiledError = compare('Tiled', tiled);
+                    if (tiledError) {
+                        return { error: tiledError };
+                    }
+                    console.log('✓ Tiled roughing matches the CPU rebuild');
+
+                    // Errors reject instead of leaving the promise pending
+                    let rejected = null;
+                    try {
+                        await rasterPath.generateZLevelRoughing(
+                            terrainResult.positions, toolResult.positions, xStep, yStep, stepSize, [], { terrainBounds }
+                        );
+                    } catch (error) {
+                        rejected = error.message;
+                    }
+                    rasterPath.dispose();
+                    if (!rejected || !rejected.includes('At least one Z level')) {
+                        return { error: \`Empty zLevels should reject, got \${rejected}\` };
+                    }
+
+                    return {
+                        success: true,
+                        layers: zLevels.length,
+                        segmentCount: roughing.segmentCount,
+                        numScanlines,
+                        pointsPerLine
+                    };
+                } catch (error) {
+                    console.error('Test error:', error);
+                    return { error: error.message, stack: error.stack };
+                }
+            })();
+        `;
+
+        try {
+            const result = await mainWindow.webContents.executeJavaScript(testScript);
+
+            if (result.error) {
+                console.error('❌ Test failed:', result.error);
+                if (result.stack) {
+                    console.error(result.stack);
+                }
+                app.exit(1);
+                return;
+            }
+
+            console.log('\n=== Test Results ===');
+            console.log('✅ Z-level roughing segments match the planar toolpath');
+            console.log(`   ${result.layers} layers over ${result.pointsPerLine}x${result.numScanlines}: ${result.segmentCount} segments match the dense planar toolpath`);
+
+            app.exit(0);
+        } catch (error) {
+            console.error('❌ Test execution failed:', error);
+            app.exit(1);
+        }
+    });
+
+    mainWindow.webContents.on('console-message', (event, level, message) => {
+        // Filter out verbose worker initialization messages to reduce output
+        if (message.includes('Adapter limits') ||
+            message.includes('Initialized (pipelines cached)') ||
+            message.includes('Worker') && message.includes('initialized')) {
+            return;
+        }
+        try {
+            console.log('[Renderer]', message);
+        } catch (err) {
+            // Ignore EPIPE errors from closed stdout
+            if (err.code !== 'EPIPE') throw err;
+        }
+    });
+}
+
+app.whenReady().then(createWindow);
+
+app.on('window-all-closed', () => {
+    app.quit();
+});
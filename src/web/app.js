@@ -1,6 +1,5 @@
 import * as THREE from 'three';
 import { OrbitControls } from 'three/addons/controls/OrbitControls.js';
-import { parseSTL } from './parse-stl.js?v=1';
 import { RasterPath } from './raster-path.js';
 
 // Configuration
@@ -80,6 +79,7 @@ let terrainTriangles = null;  // Store original triangles for radial mode
 let toolData = null;
 let toolFile = null;
 let webgpuWorker = null;
+let pendingSTLParse = null;  // {resolve, reject} of the STL being parsed in the WebGPU worker
 let rasterPath = null;  // RasterPath API instance for radial mode
 
 // Store STL bounds for bounds override feature
@@ -483,7 +483,7 @@ function initScene() {
                         try {
                             updateStatus('Recomputing tool...');
                             const buffer = await toolFile.arrayBuffer();
-                            const { positions, triangleCount } = parseSTL(buffer);
+                            const { positions, triangleCount } = await parseSTL(buffer);
                             console.log('Parsed tool STL:', triangleCount, 'triangles');
 
                             // Send to WebGPU worker (tools don't use bounds override)
@@ -539,6 +539,16 @@ function onWindowResize() {
 // Configuration
 const NUM_PARALLEL_WORKERS = 4; // Number of parallel workers for toolpath generation
 
+// Parse an STL file in the WebGPU worker (binary or ASCII); the buffer is transferred and detached
+function parseSTL(buffer) {
+    return new Promise((resolve, reject) => {
+        pendingSTLParse = { resolve, reject };
+        webgpuWorker.postMessage({ type: 'stl-parse-begin', data: { byteLength: buffer.byteLength } });
+        webgpuWorker.postMessage({ type: 'stl-parse-chunk', data: { chunk: new Uint8Array(buffer) } }, [buffer]);
+        webgpuWorker.postMessage({ type: 'stl-parse-end', data: {} });
+    });
+}
+
 // Web Worker setup
 async function initWorkers() {
     // Initialize WebGPU worker
@@ -579,6 +589,15 @@ async function initWorkers() {
                 // Already handled above
                 break;
 
+            case 'stl-parsed':
+                if (data.error) {
+                    pendingSTLParse.reject(new Error(data.error));
+                } else {
+                    pendingSTLParse.resolve({ positions: data.triangles, triangleCount: data.triangleCount, bounds: data.bounds });
+                }
+                pendingSTLParse = null;
+                break;
+
             case 'rasterize-complete':
                 console.log('WebGPU worker: rasterization complete, points:', data.pointCount, 'isForTool:', isForTool);
                 handleRasterizeComplete(data, isForTool);
@@ -606,6 +625,10 @@ async function initWorkers() {
 
             case 'error':
                 console.error('WebGPU worker error:', e.data.message);
+                if (pendingSTLParse) {
+                    pendingSTLParse.reject(new Error(e.data.message));
+                    pendingSTLParse = null;
+                }
                 updateStatus('Error: ' + e.data.message);
                 generateToolpathBtn.disabled = false;
                 // Hide progress bar on error
@@ -1381,7 +1404,7 @@ async function processFileWebGPU(file) {
         console.log('File loaded, buffer size:', buffer.byteLength);
 
         updateStatus('Parsing STL...');
-        const { positions, triangleCount, bounds } = parseSTL(buffer);
+        const { positions, triangleCount, bounds } = await parseSTL(buffer);
         console.log('Parsed STL:', triangleCount, 'triangles');
         console.log('Original bounds:', bounds);
 
@@ -1557,7 +1580,7 @@ toolFileInput.addEventListener('change', async (e) => {
             try {
                 // WebGPU worker path
                 const buffer = await file.arrayBuffer();
-                const { positions, triangleCount } = parseSTL(buffer);
+                const { positions, triangleCount } = await parseSTL(buffer);
                 console.log('Parsed tool STL:', triangleCount, 'triangles');
 
                 // Send to WebGPU worker (tools don't use bounds override)
@@ -8,7 +8,28 @@ let cachedRasterizePipeline = null;
 let cachedRasterizeShaderModule = null;
 let cachedToolpathPipeline = null;
 let cachedToolpathShaderModule = null;
+let cachedToolpathBatchPipeline = null;
+let cachedToolpathProbePipeline = null;
+let cachedToolpathSimplifyPipeline = null;
+let cachedPrefixSumPipeline = null;
+let cachedZLevelSegmentsPipeline = null;
+let cachedStockSweepPipeline = null;
+let cachedToolpathRestPipeline = null;
+let cachedToolpathRotatedPipeline = null;
+let cachedOffsetSurfaceGatherPipeline = null;
+let cachedToolQueryPipeline = null;
+let cachedRadialScanlinePipeline = null;
+let cachedCylinderRasterPipeline = null;
+let cachedCylinderToolpathPipeline = null;
 let config = null;
+const toolpathTileJobs = new Map(); // Shared tiled toolpath jobs this pool worker is running tiles for by job id
+const toolpathStreams = new Map(); // Chunk iterators of the open streaming toolpaths by stream id
+const radialJobs = new Map(); // Mesh and tool of the radial jobs this worker is running angles for by job id
+let residentCylinderMap = null; // Unwrapped (X, angle) radius map of a mesh about the X axis
+const stlParsers = new Map(); // STLs being received chunk by chunk by stream id
+let residentStock = null; // GPU stock heightmap updated by simulated toolpaths
+let residentOffsetSurface = null; // Full-resolution tool-center offset surface sampled by scan patterns
+let residentTerrain = null; // Dense terrain kept on the GPU for drop-cutter queries
 let deviceCapabilities = null;
 
 // Initialize WebGPU device in worker context
@@ -65,6 +86,80 @@ async function initWebGPU() {
             compute: { module: cachedToolpathShaderModule, entryPoint: 'main' },
         });
 
+        // Pre-create multi-tool batch toolpath pipeline
+        cachedToolpathBatchPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: toolpathBatchShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create toolpath probe pipeline (arbitrary sample positions, used by adaptive sampling)
+        cachedToolpathProbePipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: toolpathProbeShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create toolpath simplification pipelines (corridor count/emit + offsets scan)
+        cachedToolpathSimplifyPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: toolpathSimplifyShaderCode }), entryPoint: 'main' },
+        });
+        cachedPrefixSumPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: prefixSumShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create Z-level roughing segment pipeline
+        cachedZLevelSegmentsPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: zLevelSegmentsShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create stock simulation pipeline
+        cachedStockSweepPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: stockSweepShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create rest machining mask pipeline
+        cachedToolpathRestPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: toolpathRestShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create rotated raster toolpath pipeline
+        cachedToolpathRotatedPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: toolpathRotatedShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create offset surface gather pipeline
+        cachedOffsetSurfaceGatherPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: offsetSurfaceGatherShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create drop-cutter query pipeline
+        cachedToolQueryPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: toolQueryShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create radial scanline pipeline
+        cachedRadialScanlinePipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: radialScanlineShaderCode }), entryPoint: 'main' },
+        });
+
+        // Pre-create cylindrical raster and toolpath pipelines
+        cachedCylinderRasterPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: cylinderRasterShaderCode }), entryPoint: 'main' },
+        });
+        cachedCylinderToolpathPipeline = device.createComputePipeline({
+            layout: 'auto',
+            compute: { module: device.createShaderModule({ code: cylinderToolpathShaderCode }), entryPoint: 'main' },
+        });
+
         // Store device capabilities
         deviceCapabilities = {
             maxStorageBufferBindingSize: device.limits.maxStorageBufferBindingSize,
@@ -315,7 +410,11 @@ fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
 }
 `;
 
-const toolpathShaderCode = `
+// Drop-cutter collision shared by the toolpath and tool query shaders: the lowest tool minus terrain
+// delta of a tool centered on a terrain cell, over the tool points landing on non-empty cells of the
+// terrain rows [row_start, row_end) held in terrain_map. Returns FLT_MAX when no point lands on the part.
+// The including shader declares terrain_map and sparse_tool.
+const toolMinDeltaShaderCode = `
 // Sentinel value for empty terrain cells (must match rasterize shader)
 const EMPTY_CELL: f32 = -1e10;
 
@@ -326,6 +425,35 @@ struct SparseToolPoint {
     padding: f32,
 }
 
+fn tool_min_delta(center_x: i32, center_y: i32, terrain_width: u32, tool_count: u32, row_start: i32, row_end: i32) -> f32 {
+    var min_delta = 3.402823466e+38;
+
+    for (var i = 0u; i < tool_count; i++) {
+        let tool_point = sparse_tool[i];
+        let terrain_x = center_x + tool_point.x_offset;
+        let terrain_y = center_y + tool_point.y_offset;
+
+        if (terrain_x < 0 || terrain_x >= i32(terrain_width) ||
+            terrain_y < row_start || terrain_y >= row_end) {
+            continue;
+        }
+
+        let terrain_idx = u32(terrain_y - row_start) * terrain_width + u32(terrain_x);
+        let terrain_z = terrain_map[terrain_idx];
+
+        // Check if terrain cell has geometry (not empty sentinel value)
+        if (terrain_z > EMPTY_CELL + 1.0) {
+            min_delta = min(min_delta, tool_point.z_value - terrain_z);
+        }
+    }
+
+    return min_delta;
+}
+`;
+
+const toolpathShaderCode = `
+${toolMinDeltaShaderCode}
+
 struct Uniforms {
     terrain_width: u32,
     terrain_height: u32,
@@ -335,6 +463,78 @@ struct Uniforms {
     oob_z: f32,
     points_per_line: u32,
     num_scanlines: u32,
+    // Tile window: output sample (0, 0) of this dispatch in global output coordinates
+    sample_origin_x: u32,
+    sample_origin_y: u32,
+    // Global terrain rows [band_start_y, band_end_y) held in terrain_map (full width)
+    band_start_y: u32,
+    band_end_y: u32,
+}
+
+@group(0) @binding(0) var<storage, read> terrain_map: array<f32>;
+@group(0) @binding(1) var<storage, read> sparse_tool: array<SparseToolPoint>;
+@group(0) @binding(2) var<storage, read_write> output_path: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+
+@compute @workgroup_size(16, 16)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let scanline = global_id.y;
+    let point_idx = global_id.x;
+
+    if (scanline >= uniforms.num_scanlines || point_idx >= uniforms.points_per_line) {
+        return;
+    }
+
+    let tool_center_x = i32((uniforms.sample_origin_x + point_idx) * uniforms.x_step);
+    let tool_center_y = i32((uniforms.sample_origin_y + scanline) * uniforms.y_step);
+
+    // The band always lies inside [0, terrain_height), so its rows are also the global bounds check
+    let min_delta = tool_min_delta(tool_center_x, tool_center_y, uniforms.terrain_width, uniforms.tool_count,
+        i32(uniforms.band_start_y), i32(uniforms.band_end_y));
+
+    var output_z = uniforms.oob_z;
+    if (min_delta < 3.402823466e+38) {
+        output_z = -min_delta;
+    }
+
+    let output_idx = scanline * uniforms.points_per_line + point_idx;
+    output_path[output_idx] = output_z;
+}
+`;
+
+// Rotated raster variant of the toolpath shader: scanlines run along scan_dir and step along step_dir
+// (unit vectors in grid cells), so any raster angle samples the same dense heightmap. Only the sample
+// center is rotated: it is rounded to its nearest cell once and the tool's world-frame integer offsets are
+// added to it, so every sample is exactly the axis-aligned collision at that cell.
+const toolpathRotatedShaderCode = `
+// Sentinel value for empty terrain cells (must match rasterize shader)
+const EMPTY_CELL: f32 = -1e10;
+
+struct SparseToolPoint {
+    x_offset: i32,
+    y_offset: i32,
+    z_value: f32,
+    padding: f32,
+}
+
+struct Uniforms {
+    terrain_width: u32,
+    terrain_height: u32,
+    tool_count: u32,
+    points_per_line: u32,
+    num_scanlines: u32,
+    scanline_start: u32,
+    oob_z: f32,
+    x_step: f32,
+    y_step: f32,
+    // Grid position of sample (0, 0)
+    origin_x: f32,
+    origin_y: f32,
+    scan_dir_x: f32,
+    scan_dir_y: f32,
+    step_dir_x: f32,
+    step_dir_y: f32,
+    padding: u32,
 }
 
 @group(0) @binding(0) var<storage, read> terrain_map: array<f32>;
@@ -351,29 +551,26 @@ fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
         return;
     }
 
-    let tool_center_x = i32(point_idx * uniforms.x_step);
-    let tool_center_y = i32(scanline * uniforms.y_step);
+    let along = f32(point_idx) * uniforms.x_step;
+    let across = f32(uniforms.scanline_start + scanline) * uniforms.y_step;
+    let center_x = i32(floor(uniforms.origin_x + along * uniforms.scan_dir_x + across * uniforms.step_dir_x + 0.5));
+    let center_y = i32(floor(uniforms.origin_y + along * uniforms.scan_dir_y + across * uniforms.step_dir_y + 0.5));
 
     var min_delta = 3.402823466e+38;
 
     for (var i = 0u; i < uniforms.tool_count; i++) {
         let tool_point = sparse_tool[i];
-        let terrain_x = tool_center_x + tool_point.x_offset;
-        let terrain_y = tool_center_y + tool_point.y_offset;
+        let terrain_x = center_x + tool_point.x_offset;
+        let terrain_y = center_y + tool_point.y_offset;
 
-        if (terrain_x < 0 || terrain_y < 0 ||
-            terrain_x >= i32(uniforms.terrain_width) ||
-            terrain_y >= i32(uniforms.terrain_height)) {
+        if (terrain_x < 0 || terrain_x >= i32(uniforms.terrain_width) ||
+            terrain_y < 0 || terrain_y >= i32(uniforms.terrain_height)) {
             continue;
         }
 
-        let terrain_idx = u32(terrain_y) * uniforms.terrain_width + u32(terrain_x);
-        let terrain_z = terrain_map[terrain_idx];
-
-        // Check if terrain cell has geometry (not empty sentinel value)
+        let terrain_z = terrain_map[u32(terrain_y) * uniforms.terrain_width + u32(terrain_x)];
         if (terrain_z > EMPTY_CELL + 1.0) {
-            let delta = tool_point.z_value - terrain_z;
-            min_delta = min(min_delta, delta);
+            min_delta = min(min_delta, tool_point.z_value - terrain_z);
         }
     }
 
@@ -382,776 +579,4827 @@ fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
         output_z = -min_delta;
     }
 
-    let output_idx = scanline * uniforms.points_per_line + point_idx;
-    output_path[output_idx] = output_z;
+    output_path[scanline * uniforms.points_per_line + point_idx] = output_z;
 }
 `;
 
-// Calculate bounding box from triangle vertices
-function calculateBounds(triangles) {
-    let min_x = Infinity, min_y = Infinity, min_z = Infinity;
-    let max_x = -Infinity, max_y = -Infinity, max_z = -Infinity;
+// Offset surface gather: bilinear lookups into the resident full-resolution offset surface.
+// mode 0 reads explicit grid positions from points; mode 1 generates a (rotated) raster from the frame
+// uniforms. Positions off the grid give oob_z; where a corner is off the part (oob_z) the highest corner
+// is used instead so samples at the part edge do not dip towards the floor.
+const offsetSurfaceGatherShaderCode = `
+struct Uniforms {
+    surface_width: u32,
+    surface_height: u32,
+    sample_count: u32,
+    mode: u32,
+    oob_z: f32,
+    dispatch_width: u32,
+    points_per_line: u32,
+    padding: u32,
+    origin_x: f32,
+    origin_y: f32,
+    scan_dir_x: f32,
+    scan_dir_y: f32,
+    step_dir_x: f32,
+    step_dir_y: f32,
+    x_step: f32,
+    y_step: f32,
+}
 
-    for (let i = 0; i < triangles.length; i += 3) {
-        const x = triangles[i];
-        const y = triangles[i + 1];
-        const z = triangles[i + 2];
+@group(0) @binding(0) var<storage, read> surface: array<f32>;
+@group(0) @binding(1) var<storage, read> points: array<vec2<f32>>;
+@group(0) @binding(2) var<storage, read_write> output_z: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
 
-        if (x < min_x) min_x = x;
-        if (y < min_y) min_y = y;
-        if (z < min_z) min_z = z;
-        if (x > max_x) max_x = x;
-        if (y > max_y) max_y = y;
-        if (z > max_z) max_z = z;
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let idx = global_id.y * uniforms.dispatch_width + global_id.x;
+    if (idx >= uniforms.sample_count) {
+        return;
     }
 
-    return {
-        min: { x: min_x, y: min_y, z: min_z },
-        max: { x: max_x, y: max_y, z: max_z }
-    };
-}
-
-// Build spatial grid for efficient triangle culling
-function buildSpatialGrid(triangles, bounds, cellSize = 5.0) {
-    const gridWidth = Math.max(1, Math.ceil((bounds.max.x - bounds.min.x) / cellSize));
-    const gridHeight = Math.max(1, Math.ceil((bounds.max.y - bounds.min.y) / cellSize));
-    const totalCells = gridWidth * gridHeight;
-
-    // console.log(`[WebGPU Worker] Building spatial grid ${gridWidth}x${gridHeight} (${cellSize}mm cells)`);
+    var position: vec2<f32>;
+    if (uniforms.mode == 0u) {
+        position = points[idx];
+    } else {
+        let along = f32(idx % uniforms.points_per_line) * uniforms.x_step;
+        let across = f32(idx / uniforms.points_per_line) * uniforms.y_step;
+        position = vec2<f32>(
+            uniforms.origin_x + along * uniforms.scan_dir_x + across * uniforms.step_dir_x,
+            uniforms.origin_y + along * uniforms.scan_dir_y + across * uniforms.step_dir_y
+        );
+    }
 
-    const grid = new Array(totalCells);
-    for (let i = 0; i < totalCells; i++) {
-        grid[i] = [];
+    let max_x = f32(uniforms.surface_width - 1u);
+    let max_y = f32(uniforms.surface_height - 1u);
+    if (!(position.x >= 0.0 && position.y >= 0.0 && position.x <= max_x && position.y <= max_y)) {
+        output_z[idx] = uniforms.oob_z;
+        return;
     }
 
-    const triangleCount = triangles.length / 9;
-    for (let t = 0; t < triangleCount; t++) {
-        const base = t * 9;
+    // Corners with zero weight are not read, so grid-aligned samples return the exact cell value
+    let x0 = u32(floor(position.x));
+    let y0 = u32(floor(position.y));
+    let fx = position.x - f32(x0);
+    let fy = position.y - f32(y0);
+    let x1 = select(min(x0 + 1u, uniforms.surface_width - 1u), x0, fx == 0.0);
+    let y1 = select(min(y0 + 1u, uniforms.surface_height - 1u), y0, fy == 0.0);
+
+    let z00 = surface[y0 * uniforms.surface_width + x0];
+    let z10 = surface[y0 * uniforms.surface_width + x1];
+    let z01 = surface[y1 * uniforms.surface_width + x0];
+    let z11 = surface[y1 * uniforms.surface_width + x1];
+
+    let oob = uniforms.oob_z;
+    if (z00 == oob || z10 == oob || z01 == oob || z11 == oob) {
+        output_z[idx] = max(max(z00, z10), max(z01, z11));
+        return;
+    }
 
-        const v0x = triangles[base], v0y = triangles[base + 1];
-        const v1x = triangles[base + 3], v1y = triangles[base + 4];
-        const v2x = triangles[base + 6], v2y = triangles[base + 7];
+    output_z[idx] = mix(mix(z00, z10, fx), mix(z01, z11, fx), fy);
+}
+`;
 
-        const minX = Math.min(v0x, v1x, v2x);
-        const maxX = Math.max(v0x, v1x, v2x);
-        const minY = Math.min(v0y, v1y, v2y);
-        const maxY = Math.max(v0y, v1y, v2y);
+// Drop-cutter queries at arbitrary grid positions against the resident terrain
+// The toolpath collision is evaluated at the surrounding integer tool centers and the highest is used.
+// Blending the corners could dip below one of them and gouge; the highest corner is conservative, and
+// also keeps queries at the part edge off oob_z. Zero-weight corners are skipped, so grid-aligned
+// queries are exact.
+// mode 0 reads positions from queries and writes Z; modes 1 (Archimedean spiral) and 2 (rectangular
+// pocket loops) generate the positions in order and write (x, y, z) per sample.
+const toolQueryShaderCode = `
+${toolMinDeltaShaderCode}
 
-        let minCellX = Math.floor((minX - bounds.min.x) / cellSize);
-        let maxCellX = Math.floor((maxX - bounds.min.x) / cellSize);
-        let minCellY = Math.floor((minY - bounds.min.y) / cellSize);
-        let maxCellY = Math.floor((maxY - bounds.min.y) / cellSize);
+struct Uniforms {
+    terrain_width: u32,
+    terrain_height: u32,
+    tool_count: u32,
+    query_count: u32,
+    oob_z: f32,
+    dispatch_width: u32,
+    mode: u32,
+    loop_count: u32,
+    // Spiral (mode 1), in grid cells: r = spiral_a * theta, samples every spacing along the arc
+    center_x: f32,
+    center_y: f32,
+    spacing: f32,
+    spiral_a: f32,
+    // Rectangular pocket (mode 2), in grid cells: loop j is the rectangle inset by j * stepover
+    rect_min_x: f32,
+    rect_min_y: f32,
+    rect_max_x: f32,
+    rect_max_y: f32,
+    stepover: f32,
+    padding0: u32,
+    padding1: u32,
+    padding2: u32,
+}
 
-        minCellX = Math.max(0, Math.min(gridWidth - 1, minCellX));
-        maxCellX = Math.max(0, Math.min(gridWidth - 1, maxCellX));
-        minCellY = Math.max(0, Math.min(gridHeight - 1, minCellY));
-        maxCellY = Math.max(0, Math.min(gridHeight - 1, maxCellY));
+@group(0) @binding(0) var<storage, read> terrain_map: array<f32>;
+@group(0) @binding(1) var<storage, read> sparse_tool: array<SparseToolPoint>;
+@group(0) @binding(2) var<storage, read_write> output_z: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+@group(0) @binding(4) var<storage, read> queries: array<vec2<f32>>;
+// First sample of each pocket loop (loop_count + 1 entries)
+@group(0) @binding(5) var<storage, read> loop_starts: array<u32>;
 
-        for (let cy = minCellY; cy <= maxCellY; cy++) {
-            for (let cx = minCellX; cx <= maxCellX; cx++) {
-                const cellIdx = cy * gridWidth + cx;
-                grid[cellIdx].push(t);
-            }
-        }
-    }
+fn spiral_arc_length(theta: f32) -> f32 {
+    return 0.5 * uniforms.spiral_a * (theta * sqrt(1.0 + theta * theta) + asinh(theta));
+}
 
-    let totalTriangleRefs = 0;
-    for (let i = 0; i < totalCells; i++) {
-        totalTriangleRefs += grid[i].length;
+fn spiral_position(idx: u32) -> vec2<f32> {
+    // Invert the arc length with Newton steps from its large-theta approximation
+    let target_length = f32(idx) * uniforms.spacing;
+    var theta = sqrt(2.0 * target_length / uniforms.spiral_a);
+    for (var i = 0; i < 3; i++) {
+        theta -= (spiral_arc_length(theta) - target_length) / (uniforms.spiral_a * sqrt(1.0 + theta * theta));
+        theta = max(theta, 0.0);
     }
+    let radius = uniforms.spiral_a * theta;
+    return vec2<f32>(uniforms.center_x + radius * cos(theta), uniforms.center_y + radius * sin(theta));
+}
 
-    const cellOffsets = new Uint32Array(totalCells + 1);
-    const triangleIndices = new Uint32Array(totalTriangleRefs);
-
-    let currentOffset = 0;
-    for (let i = 0; i < totalCells; i++) {
-        cellOffsets[i] = currentOffset;
-        for (let j = 0; j < grid[i].length; j++) {
-            triangleIndices[currentOffset++] = grid[i][j];
+fn pocket_position(idx: u32) -> vec2<f32> {
+    var lo = 0u;
+    var hi = uniforms.loop_count - 1u;
+    while (lo < hi) {
+        let mid = (lo + hi + 1u) / 2u;
+        if (loop_starts[mid] <= idx) {
+            lo = mid;
+        } else {
+            hi = mid - 1u;
         }
     }
-    cellOffsets[totalCells] = currentOffset;
 
-    const avgPerCell = totalTriangleRefs / totalCells;
-    // console.log(`[WebGPU Worker] Spatial grid: ${totalTriangleRefs} refs (avg ${avgPerCell.toFixed(1)} per cell)`);
+    let inset = f32(lo) * uniforms.stepover;
+    let x0 = uniforms.rect_min_x + inset;
+    let y0 = uniforms.rect_min_y + inset;
+    let width = uniforms.rect_max_x - inset - x0;
+    let height = uniforms.rect_max_y - inset - y0;
+    let u = min(f32(idx - loop_starts[lo]) * uniforms.spacing, 2.0 * (width + height));
 
-    return {
-        gridWidth,
-        gridHeight,
-        cellSize,
-        cellOffsets,
-        triangleIndices,
-        avgTrianglesPerCell: avgPerCell
-    };
+    // Counter-clockwise from the loop's min corner, closing back on it
+    if (u <= width) {
+        return vec2<f32>(x0 + u, y0);
+    }
+    if (u <= width + height) {
+        return vec2<f32>(x0 + width, y0 + u - width);
+    }
+    if (u <= 2.0 * width + height) {
+        return vec2<f32>(x0 + width - (u - width - height), y0 + height);
+    }
+    return vec2<f32>(x0, y0 + height - (u - 2.0 * width - height));
 }
 
-// Rasterize mesh to point cloud
-// Internal function - rasterize without tiling (do not modify this function!)
-async function rasterizeMeshSingle(triangles, stepSize, filterMode, options = {}) {
-    const startTime = performance.now();
-
-    if (!isInitialized) {
-        const initStart = performance.now();
-        const success = await initWebGPU();
-        if (!success) {
-            throw new Error('WebGPU not available');
-        }
-        const initEnd = performance.now();
-        console.log(`[WebGPU Worker] First-time init: ${(initEnd - initStart).toFixed(1)}ms`);
+fn drop_cutter(center_x: i32, center_y: i32) -> f32 {
+    let min_delta = tool_min_delta(center_x, center_y, uniforms.terrain_width, uniforms.tool_count,
+        0, i32(uniforms.terrain_height));
+    if (min_delta < 3.402823466e+38) {
+        return -min_delta;
     }
+    return uniforms.oob_z;
+}
 
-    // console.log(`[WebGPU Worker] Rasterizing ${triangles.length / 9} triangles (step ${stepSize}mm, mode ${filterMode})...`);
-
-    // Extract options
-    const boundsOverride = options.bounds || options.min ? options : null;  // Support old and new format
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let idx = global_id.y * uniforms.dispatch_width + global_id.x;
+    if (idx >= uniforms.query_count) {
+        return;
+    }
 
-    // Use bounds override if provided, otherwise calculate from triangles
-    const bounds = boundsOverride || calculateBounds(triangles);
+    var position: vec2<f32>;
+    if (uniforms.mode == 1u) {
+        position = spiral_position(idx);
+    } else if (uniforms.mode == 2u) {
+        position = pocket_position(idx);
+    } else {
+        position = queries[idx];
+    }
 
-    if (boundsOverride) {
-        // console.log(`[WebGPU Worker] Using bounds override: min(${bounds.min.x.toFixed(2)}, ${bounds.min.y.toFixed(2)}, ${bounds.min.z.toFixed(2)}) max(${bounds.max.x.toFixed(2)}, ${bounds.max.y.toFixed(2)}, ${bounds.max.z.toFixed(2)})`);
+    let x0 = i32(floor(position.x));
+    let y0 = i32(floor(position.y));
+    let fx = position.x - f32(x0);
+    let fy = position.y - f32(y0);
 
-        // Validate bounds
-        if (bounds.min.x >= bounds.max.x || bounds.min.y >= bounds.max.y || bounds.min.z >= bounds.max.z) {
-            throw new Error(`Invalid bounds: min must be less than max. Got min(${bounds.min.x}, ${bounds.min.y}, ${bounds.min.z}) max(${bounds.max.x}, ${bounds.max.y}, ${bounds.max.z})`);
+    var z = drop_cutter(x0, y0);
+    if (fx != 0.0) {
+        z = max(z, drop_cutter(x0 + 1, y0));
+    }
+    if (fy != 0.0) {
+        z = max(z, drop_cutter(x0, y0 + 1));
+        if (fx != 0.0) {
+            z = max(z, drop_cutter(x0 + 1, y0 + 1));
         }
     }
 
-    const gridWidth = Math.ceil((bounds.max.x - bounds.min.x) / stepSize) + 1;
-    const gridHeight = Math.ceil((bounds.max.y - bounds.min.y) / stepSize) + 1;
+    if (uniforms.mode == 0u) {
+        output_z[idx] = z;
+    } else {
+        output_z[idx * 3u] = position.x;
+        output_z[idx * 3u + 1u] = position.y;
+        output_z[idx * 3u + 2u] = z;
+    }
+}
+`;
+
+// Multi-tool variant of the toolpath shader: N sparse tools concatenated into one buffer,
+// each with its own offset range, steps and floor, evaluated over a shared terrain in one dispatch
+const toolpathBatchShaderCode = `
+// Sentinel value for empty terrain cells (must match rasterize shader)
+const EMPTY_CELL: f32 = -1e10;
+
+struct SparseToolPoint {
+    x_offset: i32,
+    y_offset: i32,
+    z_value: f32,
+    padding: f32,
+}
+
+struct ToolRange {
+    tool_offset: u32,
+    tool_count: u32,
+    x_step: u32,
+    y_step: u32,
+    points_per_line: u32,
+    num_scanlines: u32,
+    output_offset: u32,
+    oob_z: f32,
+}
+
+struct Uniforms {
+    terrain_width: u32,
+    terrain_height: u32,
+    range_count: u32,
+    total_points: u32,
+    dispatch_width: u32,
+}
+
+@group(0) @binding(0) var<storage, read> terrain_map: array<f32>;
+@group(0) @binding(1) var<storage, read> sparse_tool: array<SparseToolPoint>;
+@group(0) @binding(2) var<storage, read_write> output_path: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+@group(0) @binding(4) var<storage, read> tool_ranges: array<ToolRange>;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let output_idx = global_id.y * uniforms.dispatch_width + global_id.x;
+
+    if (output_idx >= uniforms.total_points) {
+        return;
+    }
+
+    // Ranges are sorted by output_offset and there are only a handful of them
+    var range_idx = 0u;
+    for (var r = 1u; r < uniforms.range_count; r++) {
+        if (output_idx >= tool_ranges[r].output_offset) {
+            range_idx = r;
+        }
+    }
+    let range = tool_ranges[range_idx];
+
+    let local_idx = output_idx - range.output_offset;
+    let scanline = local_idx / range.points_per_line;
+    let point_idx = local_idx % range.points_per_line;
+
+    let tool_center_x = i32(point_idx * range.x_step);
+    let tool_center_y = i32(scanline * range.y_step);
+
+    var min_delta = 3.402823466e+38;
+
+    let tool_end = range.tool_offset + range.tool_count;
+    for (var i = range.tool_offset; i < tool_end; i++) {
+        let tool_point = sparse_tool[i];
+        let terrain_x = tool_center_x + tool_point.x_offset;
+        let terrain_y = tool_center_y + tool_point.y_offset;
+
+        if (terrain_x < 0 || terrain_y < 0 ||
+            terrain_x >= i32(uniforms.terrain_width) ||
+            terrain_y >= i32(uniforms.terrain_height)) {
+            continue;
+        }
+
+        let terrain_idx = u32(terrain_y) * uniforms.terrain_width + u32(terrain_x);
+        let terrain_z = terrain_map[terrain_idx];
+
+        // Check if terrain cell has geometry (not empty sentinel value)
+        if (terrain_z > EMPTY_CELL + 1.0) {
+            let delta = tool_point.z_value - terrain_z;
+            min_delta = min(min_delta, delta);
+        }
+    }
+
+    var output_z = range.oob_z;
+    if (min_delta < 3.402823466e+38) {
+        output_z = -min_delta;
+    }
+
+    output_path[output_idx] = output_z;
+}
+`;
+
+// Probe variant of the toolpath shader: evaluates the tool at an arbitrary list of output samples
+// (point index along the scanline, scanline) instead of the full grid. Used by adaptive sampling.
+const toolpathProbeShaderCode = `
+// Sentinel value for empty terrain cells (must match rasterize shader)
+const EMPTY_CELL: f32 = -1e10;
+
+struct SparseToolPoint {
+    x_offset: i32,
+    y_offset: i32,
+    z_value: f32,
+    padding: f32,
+}
+
+struct Uniforms {
+    terrain_width: u32,
+    terrain_height: u32,
+    tool_count: u32,
+    x_step: u32,
+    y_step: u32,
+    oob_z: f32,
+    probe_count: u32,
+    dispatch_width: u32,
+}
+
+@group(0) @binding(0) var<storage, read> terrain_map: array<f32>;
+@group(0) @binding(1) var<storage, read> sparse_tool: array<SparseToolPoint>;
+@group(0) @binding(2) var<storage, read_write> output_z: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+@group(0) @binding(4) var<storage, read> probes: array<vec2<u32>>;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let probe_idx = global_id.y * uniforms.dispatch_width + global_id.x;
+
+    if (probe_idx >= uniforms.probe_count) {
+        return;
+    }
+
+    let probe = probes[probe_idx];
+    let tool_center_x = i32(probe.x * uniforms.x_step);
+    let tool_center_y = i32(probe.y * uniforms.y_step);
+
+    var min_delta = 3.402823466e+38;
+
+    for (var i = 0u; i < uniforms.tool_count; i++) {
+        let tool_point = sparse_tool[i];
+        let terrain_x = tool_center_x + tool_point.x_offset;
+        let terrain_y = tool_center_y + tool_point.y_offset;
+
+        if (terrain_x < 0 || terrain_y < 0 ||
+            terrain_x >= i32(uniforms.terrain_width) ||
+            terrain_y >= i32(uniforms.terrain_height)) {
+            continue;
+        }
+
+        let terrain_idx = u32(terrain_y) * uniforms.terrain_width + u32(terrain_x);
+        let terrain_z = terrain_map[terrain_idx];
+
+        // Check if terrain cell has geometry (not empty sentinel value)
+        if (terrain_z > EMPTY_CELL + 1.0) {
+            let delta = tool_point.z_value - terrain_z;
+            min_delta = min(min_delta, delta);
+        }
+    }
+
+    var z = uniforms.oob_z;
+    if (min_delta < 3.402823466e+38) {
+        z = -min_delta;
+    }
+
+    output_z[probe_idx] = z;
+}
+`;
+
+// Per-scanline toolpath simplification. One thread walks one scanline: from each anchor it extends
+// the segment while some chord from the anchor stays within tolerance (Z) of every skipped sample,
+// keeping the feasible slope interval [lo, hi], and ends it at the furthest sample whose own chord
+// lies in that interval. Run in two modes over the same walk: count (line_data = vertex counts)
+// and emit (line_data = exclusive offsets, vertices written as (pointIdx, z)).
+// NaN samples break the polyline: each NaN run emits a single (pointIdx, NaN) marker.
+const toolpathSimplifyShaderCode = `
+struct Uniforms {
+    points_per_line: u32,
+    num_scanlines: u32,
+    tolerance: f32,
+    dispatch_width: u32,
+    emit_vertices: u32,
+}
+
+@group(0) @binding(0) var<storage, read> path: array<f32>;
+@group(0) @binding(1) var<storage, read_write> line_data: array<u32>;
+@group(0) @binding(2) var<storage, read_write> vertices: array<vec2<f32>>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+
+// Bit test rather than z != z, which compilers may fold away
+fn is_break(z: f32) -> bool {
+    return (bitcast<u32>(z) & 0x7fffffffu) > 0x7f800000u;
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let scanline = global_id.y * uniforms.dispatch_width + global_id.x;
+
+    if (scanline >= uniforms.num_scanlines) {
+        return;
+    }
+
+    let ppl = uniforms.points_per_line;
+    let base = scanline * ppl;
+    let emit = uniforms.emit_vertices != 0u;
+
+    var out_base = 0u;
+    if (emit) {
+        out_base = line_data[scanline];
+    }
+
+    var count = 0u;
+    var i = 0u;
+    loop {
+        if (i >= ppl) {
+            break;
+        }
+
+        let zi = path[base + i];
+        if (is_break(zi)) {
+            if (emit) {
+                vertices[out_base + count] = vec2<f32>(f32(i), zi);
+            }
+            count++;
+            var k = i + 1u;
+            loop {
+                if (k >= ppl || !is_break(path[base + k])) {
+                    break;
+                }
+                k++;
+            }
+            i = k;
+            continue;
+        }
+
+        // i is a vertex; find the end of its segment
+        if (emit) {
+            vertices[out_base + count] = vec2<f32>(f32(i), zi);
+        }
+        count++;
+
+        var lo = -3.402823466e+38;
+        var hi = 3.402823466e+38;
+        var best = i;
+        var j = i + 1u;
+        loop {
+            if (j >= ppl) {
+                break;
+            }
+            let zj = path[base + j];
+            if (is_break(zj)) {
+                break;
+            }
+            let dx = f32(j - i);
+            let slope = (zj - zi) / dx;
+            if (slope >= lo && slope <= hi) {
+                best = j;
+            }
+            lo = max(lo, (zj - uniforms.tolerance - zi) / dx);
+            hi = min(hi, (zj + uniforms.tolerance - zi) / dx);
+            if (lo > hi) {
+                break;
+            }
+            j++;
+        }
+
+        // best == i only when the next sample is a break or the line ended
+        i = select(best, i + 1u, best == i);
+    }
+
+    if (!emit) {
+        line_data[scanline] = count;
+    }
+}
+`;
+
+// Exclusive prefix sum of counts[0..count) into offsets[0..count], in a single workgroup.
+// Each thread sums a contiguous chunk, the 256 chunk totals are scanned in workgroup memory, then
+// each thread writes its chunk's offsets. offsets[count] receives the grand total.
+const prefixSumShaderCode = `
+struct Uniforms {
+    count: u32,
+}
+
+@group(0) @binding(0) var<storage, read> counts: array<u32>;
+@group(0) @binding(1) var<storage, read_write> offsets: array<u32>;
+@group(0) @binding(2) var<uniform> uniforms: Uniforms;
+
+var<workgroup> partial_sums: array<u32, 256>;
+
+@compute @workgroup_size(256)
+fn main(@builtin(local_invocation_id) local_id: vec3<u32>) {
+    let n = uniforms.count;
+    let t = local_id.x;
+    let chunk = (n + 255u) / 256u;
+    let start = min(t * chunk, n);
+    let end = min(start + chunk, n);
+
+    var sum = 0u;
+    for (var i = start; i < end; i++) {
+        sum += counts[i];
+    }
+    partial_sums[t] = sum;
+    workgroupBarrier();
+
+    // Hillis-Steele inclusive scan over the chunk totals
+    for (var offset = 1u; offset < 256u; offset *= 2u) {
+        var addend = 0u;
+        if (t >= offset) {
+            addend = partial_sums[t - offset];
+        }
+        workgroupBarrier();
+        partial_sums[t] += addend;
+        workgroupBarrier();
+    }
+
+    var running = partial_sums[t] - sum;
+    for (var i = start; i < end; i++) {
+        offsets[i] = running;
+        running += counts[i];
+    }
+    if (t == 255u) {
+        offsets[n] = partial_sums[255];
+    }
+}
+`;
+
+// Z-level roughing segments. The offset surface is the toolpath output (tool tip Z touching the
+// terrain) for a band of scanlines; a sample is machinable at layer z when offset + allowance <= z.
+// One thread per (layer, row) walks the row and records runs of machinable samples as
+// (start, end) sample index pairs, reversed on odd global rows so each layer reads as a zig-zag.
+// Like the simplify shader it runs as a count pass (line_data = run counts) and, after a prefix
+// sum, an emit pass (line_data = exclusive offsets).
+const zLevelSegmentsShaderCode = `
+struct Uniforms {
+    points_per_line: u32,
+    num_rows: u32,
+    layer_count: u32,
+    dispatch_width: u32,
+    emit_segments: u32,
+    row_origin: u32,
+    allowance: f32,
+    padding: u32,
+}
+
+@group(0) @binding(0) var<storage, read> offset_surface: array<f32>;
+@group(0) @binding(1) var<storage, read_write> line_data: array<u32>;
+@group(0) @binding(2) var<storage, read_write> segments: array<vec2<u32>>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+@group(0) @binding(4) var<storage, read> z_levels: array<f32>;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let line_idx = global_id.y * uniforms.dispatch_width + global_id.x;
+
+    if (line_idx >= uniforms.layer_count * uniforms.num_rows) {
+        return;
+    }
+
+    let layer = line_idx / uniforms.num_rows;
+    let row = line_idx % uniforms.num_rows;
+    let z = z_levels[layer];
+    let ppl = uniforms.points_per_line;
+    let base = row * ppl;
+    let emit = uniforms.emit_segments != 0u;
+    let reverse = ((uniforms.row_origin + row) & 1u) == 1u;
+
+    var out_base = 0u;
+    var total = 0u;
+    if (emit) {
+        out_base = line_data[line_idx];
+        total = line_data[line_idx + 1u] - out_base;
+    }
+
+    var count = 0u;
+    var run_start = 0u;
+    var in_run = false;
+    for (var x = 0u; x <= ppl; x++) {
+        // NaN offsets fail the comparison and are never machinable
+        var machinable = false;
+        if (x < ppl) {
+            machinable = offset_surface[base + x] + uniforms.allowance <= z;
+        }
+
+        if (machinable && !in_run) {
+            run_start = x;
+            in_run = true;
+        } else if (!machinable && in_run) {
+            if (emit) {
+                if (reverse) {
+                    segments[out_base + total - 1u - count] = vec2<u32>(x - 1u, run_start);
+                } else {
+                    segments[out_base + count] = vec2<u32>(run_start, x - 1u);
+                }
+            }
+            count++;
+            in_run = false;
+        }
+    }
+
+    if (!emit) {
+        line_data[line_idx] = count;
+    }
+}
+`;
+
+// Stock simulation: lower each stock cell to the bottom envelope of the tool swept along a toolpath.
+// Per-cell gather: for every tool point, the path sample whose tool footprint puts that point on this
+// cell is found by inverting the offset. Along a scanline the tool moves continuously, so tip Z is
+// interpolated between adjacent samples; NaN samples are breaks and cut nothing. Cells that change
+// flag their row band in dirty so only those bands need to be read back.
+const stockSweepShaderCode = `
+struct SparseToolPoint {
+    x_offset: i32,
+    y_offset: i32,
+    z_value: f32,
+    padding: f32,
+}
+
+struct Uniforms {
+    stock_width: u32,
+    stock_height: u32,
+    tool_count: u32,
+    x_step: u32,
+    y_step: u32,
+    points_per_line: u32,
+    // Path scanlines [scanline_start, scanline_start + scanline_count) are held in path_z
+    scanline_start: u32,
+    scanline_count: u32,
+    // Stock cell of path sample (0, 0)
+    path_origin_x: i32,
+    path_origin_y: i32,
+    // Stock rows covered by this dispatch
+    row_start: u32,
+    row_count: u32,
+    band_rows: u32,
+    padding0: u32,
+    padding1: u32,
+    padding2: u32,
+}
+
+@group(0) @binding(0) var<storage, read_write> stock: array<f32>;
+@group(0) @binding(1) var<storage, read> sparse_tool: array<SparseToolPoint>;
+@group(0) @binding(2) var<storage, read> path_z: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+@group(0) @binding(4) var<storage, read_write> dirty: array<atomic<u32>>;
+
+fn is_break(z: f32) -> bool {
+    return (bitcast<u32>(z) & 0x7fffffffu) > 0x7f800000u;
+}
+
+@compute @workgroup_size(16, 16)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let x = global_id.x;
+    let y = uniforms.row_start + global_id.y;
+
+    if (x >= uniforms.stock_width || global_id.y >= uniforms.row_count || y >= uniforms.stock_height) {
+        return;
+    }
+
+    let ppl = uniforms.points_per_line;
+    var lowest = 3.402823466e+38;
+
+    for (var i = 0u; i < uniforms.tool_count; i++) {
+        let tool_point = sparse_tool[i];
+        let px = i32(x) - uniforms.path_origin_x - tool_point.x_offset;
+        let py = i32(y) - uniforms.path_origin_y - tool_point.y_offset;
+        if (px < 0 || py < 0) {
+            continue;
+        }
+
+        let upy = u32(py);
+        if (upy % uniforms.y_step != 0u) {
+            continue;
+        }
+        let scanline = upy / uniforms.y_step;
+        if (scanline < uniforms.scanline_start || scanline >= uniforms.scanline_start + uniforms.scanline_count) {
+            continue;
+        }
+
+        let upx = u32(px);
+        let sample = upx / uniforms.x_step;
+        let remainder = upx % uniforms.x_step;
+        if (sample >= ppl) {
+            continue;
+        }
+
+        let row_base = (scanline - uniforms.scanline_start) * ppl;
+        let z0 = path_z[row_base + sample];
+        var tip_z = z0;
+        if (remainder != 0u) {
+            if (sample + 1u >= ppl) {
+                continue;
+            }
+            let z1 = path_z[row_base + sample + 1u];
+            if (is_break(z1)) {
+                continue;
+            }
+            tip_z = mix(z0, z1, f32(remainder) / f32(uniforms.x_step));
+        }
+        if (is_break(z0)) {
+            continue;
+        }
+
+        lowest = min(lowest, tip_z + tool_point.z_value);
+    }
+
+    let idx = y * uniforms.stock_width + x;
+    if (lowest < stock[idx]) {
+        stock[idx] = lowest;
+        atomicOr(&dirty[y / uniforms.band_rows], 1u);
+    }
+}
+`;
+
+// Rest machining mask: keep a toolpath sample only where the tool, at its computed tip Z, would still
+// remove more than threshold of the remaining stock under its footprint. Other samples are overwritten
+// with NaN in place, which the simplify pass then collapses into a single break marker per run.
+const toolpathRestShaderCode = `
+struct SparseToolPoint {
+    x_offset: i32,
+    y_offset: i32,
+    z_value: f32,
+    padding: f32,
+}
+
+struct Uniforms {
+    stock_width: u32,
+    stock_height: u32,
+    tool_count: u32,
+    x_step: u32,
+    y_step: u32,
+    points_per_line: u32,
+    num_scanlines: u32,
+    sample_origin_y: u32,
+    // Stock cell of terrain cell (0, 0)
+    stock_origin_x: i32,
+    stock_origin_y: i32,
+    threshold: f32,
+    dispatch_width: u32,
+}
+
+@group(0) @binding(0) var<storage, read_write> path_z: array<f32>;
+@group(0) @binding(1) var<storage, read> stock: array<f32>;
+@group(0) @binding(2) var<storage, read> sparse_tool: array<SparseToolPoint>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let idx = global_id.y * uniforms.dispatch_width + global_id.x;
+    if (idx >= uniforms.points_per_line * uniforms.num_scanlines) {
+        return;
+    }
+
+    let tip_z = path_z[idx];
+    if ((bitcast<u32>(tip_z) & 0x7fffffffu) > 0x7f800000u) {
+        return;
+    }
+
+    let center_x = i32((idx % uniforms.points_per_line) * uniforms.x_step) + uniforms.stock_origin_x;
+    let center_y = i32((uniforms.sample_origin_y + idx / uniforms.points_per_line) * uniforms.y_step) + uniforms.stock_origin_y;
+
+    var residual = -3.402823466e+38;
+    for (var i = 0u; i < uniforms.tool_count; i++) {
+        let tool_point = sparse_tool[i];
+        let x = center_x + tool_point.x_offset;
+        let y = center_y + tool_point.y_offset;
+        if (x < 0 || y < 0 || x >= i32(uniforms.stock_width) || y >= i32(uniforms.stock_height)) {
+            continue;
+        }
+        residual = max(residual, stock[u32(y) * uniforms.stock_width + u32(x)] - (tip_z + tool_point.z_value));
+    }
+
+    if (residual <= uniforms.threshold) {
+        path_z[idx] = bitcast<f32>(0x7fc00000u);
+    }
+}
+`;
+
+// Radial scanline: tool centered on the strip's y=0 row, one thread per output X sample.
+// Same collision as generateRadialScanline: highest tool center Z over non-empty cells, floored at z_floor
+const radialScanlineShaderCode = `
+const EMPTY_CELL: f32 = -1e10;
+
+struct SparseToolPoint {
+    x_offset: i32,
+    y_offset: i32,
+    z_value: f32,
+    padding: f32,
+}
+
+struct Uniforms {
+    strip_width: u32,
+    strip_height: u32,
+    tool_count: u32,
+    x_step: u32,
+    center_y: i32,
+    output_width: u32,
+    z_floor: f32,
+    // First element of this angle's row in a batch of scanlines
+    scanline_offset: u32,
+}
+
+@group(0) @binding(0) var<storage, read> strip: array<f32>;
+@group(0) @binding(1) var<storage, read> sparse_tool: array<SparseToolPoint>;
+@group(0) @binding(2) var<storage, read_write> scanline: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let out_x = global_id.x;
+    if (out_x >= uniforms.output_width) {
+        return;
+    }
+
+    let center_x = i32(out_x * uniforms.x_step);
+    var max_z = uniforms.z_floor;
+    for (var i = 0u; i < uniforms.tool_count; i++) {
+        let tool_point = sparse_tool[i];
+        let x = center_x + tool_point.x_offset;
+        let y = uniforms.center_y + tool_point.y_offset;
+        if (x < 0 || y < 0 || x >= i32(uniforms.strip_width) || y >= i32(uniforms.strip_height)) {
+            continue;
+        }
+
+        let terrain_z = strip[u32(y) * uniforms.strip_width + u32(x)];
+        if (terrain_z == EMPTY_CELL) {
+            continue;
+        }
+        max_z = max(max_z, terrain_z - tool_point.z_value);
+    }
+
+    scanline[uniforms.scanline_offset + out_x] = max_z;
+}
+`;
+
+// Cylindrical rasterization: one ray per (X, angle) cell, cast outward from the X axis in direction
+// (0, cos(phi), sin(phi)), keeping the outermost hit. Row a of radius_map is the radius profile at angle a.
+const cylinderRasterShaderCode = `
+const EMPTY_CELL: f32 = -1e10;
+
+struct Uniforms {
+    min_x: f32,
+    step_size: f32,
+    width: u32,
+    angle_count: u32,
+    angle_step: f32,
+    cell_size: f32,
+    cells_x: u32,
+    sector_count: u32,
+}
+
+@group(0) @binding(0) var<storage, read> triangles: array<f32>;
+@group(0) @binding(1) var<storage, read_write> radius_map: array<f32>;
+@group(0) @binding(2) var<uniform> uniforms: Uniforms;
+@group(0) @binding(3) var<storage, read> cell_offsets: array<u32>;
+@group(0) @binding(4) var<storage, read> cell_triangles: array<u32>;
+
+@compute @workgroup_size(16, 16)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let xi = global_id.x;
+    let ai = global_id.y;
+    if (xi >= uniforms.width || ai >= uniforms.angle_count) {
+        return;
+    }
+
+    let x = uniforms.min_x + f32(xi) * uniforms.step_size;
+    let phi = f32(ai) * uniforms.angle_step;
+    let origin = vec3<f32>(x, 0.0, 0.0);
+    let dir = vec3<f32>(0.0, cos(phi), sin(phi));
+
+    let cell_x = min(u32(max(0.0, (x - uniforms.min_x) / uniforms.cell_size)), uniforms.cells_x - 1u);
+    let sector = min(u32(f32(ai) * f32(uniforms.sector_count) / f32(uniforms.angle_count)), uniforms.sector_count - 1u);
+    let cell = sector * uniforms.cells_x + cell_x;
+
+    var best = EMPTY_CELL;
+    for (var idx = cell_offsets[cell]; idx < cell_offsets[cell + 1u]; idx++) {
+        let base = cell_triangles[idx] * 9u;
+        let v0 = vec3<f32>(triangles[base], triangles[base + 1u], triangles[base + 2u]);
+        let v1 = vec3<f32>(triangles[base + 3u], triangles[base + 4u], triangles[base + 5u]);
+        let v2 = vec3<f32>(triangles[base + 6u], triangles[base + 7u], triangles[base + 8u]);
+
+        if (x < min(min(v0.x, v1.x), v2.x) || x > max(max(v0.x, v1.x), v2.x)) {
+            continue;
+        }
+
+        // Moller-Trumbore with the same edge tolerance as the planar rasterizer
+        let EPSILON = 0.0000001;
+        let edge1 = v1 - v0;
+        let edge2 = v2 - v0;
+        let h = cross(dir, edge2);
+        let a = dot(edge1, h);
+        if (a > -EPSILON && a < EPSILON) {
+            continue;
+        }
+        let f = 1.0 / a;
+        let s = origin - v0;
+        let u = f * dot(s, h);
+        if (u < -EPSILON || u > 1.0 + EPSILON) {
+            continue;
+        }
+        let q = cross(s, edge1);
+        let v = f * dot(dir, q);
+        if (v < -EPSILON || u + v > 1.0 + EPSILON) {
+            continue;
+        }
+        let t = f * dot(edge2, q);
+        if (t > EPSILON) {
+            best = max(best, t);
+        }
+    }
+
+    radius_map[ai * uniforms.width + xi] = best;
+}
+`;
+
+// Radial toolpath from a radius map: for rotation theta, map column phi lies at psi = phi + theta in the
+// rotated frame, i.e. at lateral offset r*cos(psi) and height r*sin(psi). Columns in the upper half
+// (wrapping around 360 degrees) are collided against a dense tool grid row picked by the lateral offset.
+// Helical mode reads the same grid as turns x angles-per-turn, with X advancing continuously along the turn.
+const cylinderToolpathShaderCode = `
+const EMPTY_CELL: f32 = -1e10;
+const PI: f32 = 3.14159265358979;
+
+struct Uniforms {
+    map_width: u32,
+    angle_count: u32,
+    angle_step: f32,
+    grid_step: f32,
+    tool_width: u32,
+    tool_height: u32,
+    tool_center_x: i32,
+    tool_center_y: i32,
+    x_step: u32,
+    points_per_line: u32,
+    num_rotations: u32,
+    rotation_step: f32,
+    z_floor: f32,
+    helical: u32,
+    padding1: u32,
+    padding2: u32,
+}
+
+@group(0) @binding(0) var<storage, read> radius_map: array<f32>;
+@group(0) @binding(1) var<storage, read> tool_grid: array<f32>;
+@group(0) @binding(2) var<storage, read_write> output_path: array<f32>;
+@group(0) @binding(3) var<uniform> uniforms: Uniforms;
+
+@compute @workgroup_size(16, 16)
+fn main(@builtin(global_invocation_id) global_id: vec3<u32>) {
+    let point_idx = global_id.x;
+    let rotation = global_id.y;
+    if (point_idx >= uniforms.points_per_line || rotation >= uniforms.num_rotations) {
+        return;
+    }
+
+    var theta = f32(rotation) * uniforms.rotation_step;
+    var center_x = i32(point_idx * uniforms.x_step);
+    if (uniforms.helical != 0u) {
+        // Row = turn, column = angle within the turn; X is rounded to the nearest map column
+        theta = f32(point_idx) * uniforms.rotation_step;
+        center_x = i32(round((f32(rotation) + f32(point_idx) / f32(uniforms.points_per_line)) * f32(uniforms.x_step)));
+    }
+    let angle_count = i32(uniforms.angle_count);
+    let first = i32(ceil(-theta / uniforms.angle_step));
+    let last = i32(floor((PI - theta) / uniforms.angle_step));
+
+    var max_z = uniforms.z_floor;
+    for (var k = first; k <= last; k++) {
+        let column = ((k % angle_count) + angle_count) % angle_count;
+        let psi = f32(k) * uniforms.angle_step + theta;
+        let c = cos(psi);
+        let s = sin(psi);
+        let row = u32(column) * uniforms.map_width;
+
+        for (var tx = 0; tx < i32(uniforms.tool_width); tx++) {
+            let mx = center_x + tx - uniforms.tool_center_x;
+            if (mx < 0 || mx >= i32(uniforms.map_width)) {
+                continue;
+            }
+            let r = radius_map[row + u32(mx)];
+            if (r == EMPTY_CELL) {
+                continue;
+            }
+            let ty = i32(round(r * c / uniforms.grid_step)) + uniforms.tool_center_y;
+            if (ty < 0 || ty >= i32(uniforms.tool_height)) {
+                continue;
+            }
+            let tool_z = tool_grid[u32(ty) * uniforms.tool_width + u32(tx)];
+            if (tool_z == EMPTY_CELL) {
+                continue;
+            }
+            max_z = max(max_z, r * s - tool_z);
+        }
+    }
+
+    output_path[rotation * uniforms.points_per_line + point_idx] = max_z;
+}
+`;
+
+// Calculate bounding box from triangle vertices
+function calculateBounds(triangles) {
+    let min_x = Infinity, min_y = Infinity, min_z = Infinity;
+    let max_x = -Infinity, max_y = -Infinity, max_z = -Infinity;
+
+    for (let i = 0; i < triangles.length; i += 3) {
+        const x = triangles[i];
+        const y = triangles[i + 1];
+        const z = triangles[i + 2];
+
+        if (x < min_x) min_x = x;
+        if (y < min_y) min_y = y;
+        if (z < min_z) min_z = z;
+        if (x > max_x) max_x = x;
+        if (y > max_y) max_y = y;
+        if (z > max_z) max_z = z;
+    }
+
+    return {
+        min: { x: min_x, y: min_y, z: min_z },
+        max: { x: max_x, y: max_y, z: max_z }
+    };
+}
+
+// Build spatial grid for efficient triangle culling
+function buildSpatialGrid(triangles, bounds, cellSize = 5.0) {
+    const gridWidth = Math.max(1, Math.ceil((bounds.max.x - bounds.min.x) / cellSize));
+    const gridHeight = Math.max(1, Math.ceil((bounds.max.y - bounds.min.y) / cellSize));
+    const totalCells = gridWidth * gridHeight;
+
+    // console.log(`[WebGPU Worker] Building spatial grid ${gridWidth}x${gridHeight} (${cellSize}mm cells)`);
+
+    const grid = new Array(totalCells);
+    for (let i = 0; i < totalCells; i++) {
+        grid[i] = [];
+    }
+
+    const triangleCount = triangles.length / 9;
+    for (let t = 0; t < triangleCount; t++) {
+        const base = t * 9;
+
+        const v0x = triangles[base], v0y = triangles[base + 1];
+        const v1x = triangles[base + 3], v1y = triangles[base + 4];
+        const v2x = triangles[base + 6], v2y = triangles[base + 7];
+
+        const minX = Math.min(v0x, v1x, v2x);
+        const maxX = Math.max(v0x, v1x, v2x);
+        const minY = Math.min(v0y, v1y, v2y);
+        const maxY = Math.max(v0y, v1y, v2y);
+
+        let minCellX = Math.floor((minX - bounds.min.x) / cellSize);
+        let maxCellX = Math.floor((maxX - bounds.min.x) / cellSize);
+        let minCellY = Math.floor((minY - bounds.min.y) / cellSize);
+        let maxCellY = Math.floor((maxY - bounds.min.y) / cellSize);
+
+        minCellX = Math.max(0, Math.min(gridWidth - 1, minCellX));
+        maxCellX = Math.max(0, Math.min(gridWidth - 1, maxCellX));
+        minCellY = Math.max(0, Math.min(gridHeight - 1, minCellY));
+        maxCellY = Math.max(0, Math.min(gridHeight - 1, maxCellY));
+
+        for (let cy = minCellY; cy <= maxCellY; cy++) {
+            for (let cx = minCellX; cx <= maxCellX; cx++) {
+                const cellIdx = cy * gridWidth + cx;
+                grid[cellIdx].push(t);
+            }
+        }
+    }
+
+    let totalTriangleRefs = 0;
+    for (let i = 0; i < totalCells; i++) {
+        totalTriangleRefs += grid[i].length;
+    }
+
+    const cellOffsets = new Uint32Array(totalCells + 1);
+    const triangleIndices = new Uint32Array(totalTriangleRefs);
+
+    let currentOffset = 0;
+    for (let i = 0; i < totalCells; i++) {
+        cellOffsets[i] = currentOffset;
+        for (let j = 0; j < grid[i].length; j++) {
+            triangleIndices[currentOffset++] = grid[i][j];
+        }
+    }
+    cellOffsets[totalCells] = currentOffset;
+
+    const avgPerCell = totalTriangleRefs / totalCells;
+    // console.log(`[WebGPU Worker] Spatial grid: ${totalTriangleRefs} refs (avg ${avgPerCell.toFixed(1)} per cell)`);
+
+    return {
+        gridWidth,
+        gridHeight,
+        cellSize,
+        cellOffsets,
+        triangleIndices,
+        avgTrianglesPerCell: avgPerCell
+    };
+}
+
+// Rasterize mesh to point cloud
+// Internal function - rasterize without tiling (do not modify this function!)
+async function rasterizeMeshSingle(triangles, stepSize, filterMode, options = {}) {
+    const startTime = performance.now();
+
+    if (!isInitialized) {
+        const initStart = performance.now();
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+        const initEnd = performance.now();
+        console.log(`[WebGPU Worker] First-time init: ${(initEnd - initStart).toFixed(1)}ms`);
+    }
+
+    // console.log(`[WebGPU Worker] Rasterizing ${triangles.length / 9} triangles (step ${stepSize}mm, mode ${filterMode})...`);
+
+    // Extract options
+    const boundsOverride = options.bounds || options.min ? options : null;  // Support old and new format
+
+    // Use bounds override if provided, otherwise calculate from triangles
+    const bounds = boundsOverride || calculateBounds(triangles);
+
+    if (boundsOverride) {
+        // console.log(`[WebGPU Worker] Using bounds override: min(${bounds.min.x.toFixed(2)}, ${bounds.min.y.toFixed(2)}, ${bounds.min.z.toFixed(2)}) max(${bounds.max.x.toFixed(2)}, ${bounds.max.y.toFixed(2)}, ${bounds.max.z.toFixed(2)})`);
+
+        // Validate bounds
+        if (bounds.min.x >= bounds.max.x || bounds.min.y >= bounds.max.y || bounds.min.z >= bounds.max.z) {
+            throw new Error(`Invalid bounds: min must be less than max. Got min(${bounds.min.x}, ${bounds.min.y}, ${bounds.min.z}) max(${bounds.max.x}, ${bounds.max.y}, ${bounds.max.z})`);
+        }
+    }
+
+    const gridWidth = Math.ceil((bounds.max.x - bounds.min.x) / stepSize) + 1;
+    const gridHeight = Math.ceil((bounds.max.y - bounds.min.y) / stepSize) + 1;
+    const totalGridPoints = gridWidth * gridHeight;
+
+    // console.log(`[WebGPU Worker] Grid: ${gridWidth}x${gridHeight} = ${totalGridPoints.toLocaleString()} points`);
+
+    // Calculate buffer size based on filter mode
+    // filterMode 0 (terrain): Dense Z-only output (1 float per grid cell)
+    // filterMode 1 (tool): Sparse X,Y,Z output (3 floats per grid cell)
+    const floatsPerPoint = filterMode === 0 ? 1 : 3;
+    const outputSize = totalGridPoints * floatsPerPoint * 4;
+    const maxBufferSize = device.limits.maxBufferSize || 268435456; // 256MB default
+    const modeStr = filterMode === 0 ? 'terrain (dense Z-only)' : 'tool (sparse XYZ)';
+    // console.log(`[WebGPU Worker] Output buffer size: ${(outputSize / 1024 / 1024).toFixed(2)} MB for ${modeStr} (max: ${(maxBufferSize / 1024 / 1024).toFixed(2)} MB)`);
+
+    if (outputSize > maxBufferSize) {
+        throw new Error(`Output buffer too large: ${(outputSize / 1024 / 1024).toFixed(2)} MB exceeds device limit of ${(maxBufferSize / 1024 / 1024).toFixed(2)} MB. Try a larger step size.`);
+    }
+
+    // Triangles are binned on their unrotated XY, so a rotated strip bins into a single row to see every triangle it may rotate into
+    const gridBounds = options.rotationAngleDeg ? { min: bounds.min, max: { ...bounds.max, y: bounds.min.y } } : bounds;
+    const spatialGrid = buildSpatialGrid(triangles, gridBounds);
+
+    // Create buffers
+    const triangleBuffer = device.createBuffer({
+        size: triangles.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(triangleBuffer, 0, triangles);
+    const outputBuffer = device.createBuffer({
+        size: outputSize,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
+
+    const validMaskBuffer = device.createBuffer({
+        size: totalGridPoints * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
+
+    const spatialCellOffsetsBuffer = device.createBuffer({
+        size: spatialGrid.cellOffsets.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(spatialCellOffsetsBuffer, 0, spatialGrid.cellOffsets);
+
+    const spatialTriangleIndicesBuffer = device.createBuffer({
+        size: spatialGrid.triangleIndices.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(spatialTriangleIndicesBuffer, 0, spatialGrid.triangleIndices);
+
+    // Uniforms
+    const uniformData = new Float32Array([
+        bounds.min.x, bounds.min.y, bounds.min.z,
+        bounds.max.x, bounds.max.y, bounds.max.z,
+        stepSize,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0  // Extended for rotation_cos and rotation_sin
+    ]);
+    const uniformDataU32 = new Uint32Array(uniformData.buffer);
+    uniformDataU32[7] = gridWidth;
+    uniformDataU32[8] = gridHeight;
+    uniformDataU32[9] = triangles.length / 9;
+    uniformDataU32[10] = filterMode;
+    uniformDataU32[11] = spatialGrid.gridWidth;
+    uniformDataU32[12] = spatialGrid.gridHeight;
+    const uniformDataF32 = new Float32Array(uniformData.buffer);
+    uniformDataF32[13] = spatialGrid.cellSize;
+
+    // Set rotation (identity by default: cos=1, sin=0)
+    const rotationAngleDeg = options.rotationAngleDeg ?? 0;
+    const rotationAngleRad = rotationAngleDeg * Math.PI / 180;
+    uniformDataF32[14] = Math.cos(rotationAngleRad);
+    uniformDataF32[15] = Math.sin(rotationAngleRad);
+
+    // Check for u32 overflow
+    const maxU32 = 4294967295;
+    if (gridWidth > maxU32 || gridHeight > maxU32) {
+        throw new Error(`Grid dimensions exceed u32 max: ${gridWidth}x${gridHeight}`);
+    }
+
+    // console.log(`[WebGPU Worker] Uniforms: gridWidth=${gridWidth}, gridHeight=${gridHeight}, triangles=${triangles.length / 9}`);
+
+    const uniformBuffer = device.createBuffer({
+        size: uniformData.byteLength,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+    // Use cached pipeline
+    const bindGroup = device.createBindGroup({
+        layout: cachedRasterizePipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: triangleBuffer } },
+            { binding: 1, resource: { buffer: outputBuffer } },
+            { binding: 2, resource: { buffer: validMaskBuffer } },
+            { binding: 3, resource: { buffer: uniformBuffer } },
+            { binding: 4, resource: { buffer: spatialCellOffsetsBuffer } },
+            { binding: 5, resource: { buffer: spatialTriangleIndicesBuffer } },
+        ],
+    });
+
+    // Dispatch compute shader
+    const commandEncoder = device.createCommandEncoder();
+    const passEncoder = commandEncoder.beginComputePass();
+    passEncoder.setPipeline(cachedRasterizePipeline);
+    passEncoder.setBindGroup(0, bindGroup);
+
+    const workgroupsX = Math.ceil(gridWidth / 16);
+    const workgroupsY = Math.ceil(gridHeight / 16);
+
+    // Check dispatch limits
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    // console.log(`[WebGPU Worker] Dispatching ${workgroupsX}x${workgroupsY} workgroups (max per dim: ${maxWorkgroupsPerDim})`);
+
+    if (workgroupsX > maxWorkgroupsPerDim || workgroupsY > maxWorkgroupsPerDim) {
+        throw new Error(`Workgroup dispatch too large: ${workgroupsX}x${workgroupsY} exceeds limit of ${maxWorkgroupsPerDim}. Try a larger step size.`);
+    }
+
+    passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+    passEncoder.end();
+
+    // Create staging buffers for readback
+    const stagingOutputBuffer = device.createBuffer({
+        size: outputSize,
+        usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
+    });
+
+    const stagingValidMaskBuffer = device.createBuffer({
+        size: totalGridPoints * 4,
+        usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
+    });
+
+    commandEncoder.copyBufferToBuffer(outputBuffer, 0, stagingOutputBuffer, 0, outputSize);
+    commandEncoder.copyBufferToBuffer(validMaskBuffer, 0, stagingValidMaskBuffer, 0, totalGridPoints * 4);
+
+    device.queue.submit([commandEncoder.finish()]);
+
+    // Wait for GPU to finish
+    await device.queue.onSubmittedWorkDone();
+
+    // Read back results
+    await stagingOutputBuffer.mapAsync(GPUMapMode.READ);
+    await stagingValidMaskBuffer.mapAsync(GPUMapMode.READ);
+
+    const outputData = new Float32Array(stagingOutputBuffer.getMappedRange());
+    const validMaskData = new Uint32Array(stagingValidMaskBuffer.getMappedRange());
+
+    let result, pointCount;
+
+    if (filterMode === 0) {
+        // Terrain: Dense output (Z-only), no compaction needed
+        // Copy the full array (already has NaN for empty cells)
+        result = new Float32Array(outputData);
+        pointCount = totalGridPoints;
+
+        // Count actual valid points for logging (sentinel value = -1e10)
+        const EMPTY_CELL = -1e10;
+        let validCount = 0;
+        for (let i = 0; i < totalGridPoints; i++) {
+            if (result[i] > EMPTY_CELL + 1) validCount++;  // Any value significantly above sentinel
+        }
+        // console.log(`[WebGPU Worker] Dense terrain: ${totalGridPoints} grid cells, ${validCount} with geometry (${(validCount/totalGridPoints*100).toFixed(1)}% coverage)`);
+    } else {
+        // Tool: Sparse output (X,Y,Z triplets), compact to remove invalid points
+        const validPoints = [];
+        for (let i = 0; i < totalGridPoints; i++) {
+            if (validMaskData[i] === 1) {
+                validPoints.push(
+                    outputData[i * 3],
+                    outputData[i * 3 + 1],
+                    outputData[i * 3 + 2]
+                );
+            }
+        }
+        result = new Float32Array(validPoints);
+        pointCount = validPoints.length / 3;
+    }
+
+    stagingOutputBuffer.unmap();
+    stagingValidMaskBuffer.unmap();
+
+    // Cleanup
+    triangleBuffer.destroy();
+    outputBuffer.destroy();
+    validMaskBuffer.destroy();
+    uniformBuffer.destroy();
+    spatialCellOffsetsBuffer.destroy();
+    spatialTriangleIndicesBuffer.destroy();
+    stagingOutputBuffer.destroy();
+    stagingValidMaskBuffer.destroy();
+
+    const endTime = performance.now();
+    const conversionTime = endTime - startTime;
+    // console.log(`[WebGPU Worker] ✅ Rasterize complete: ${pointCount} points in ${conversionTime.toFixed(1)}ms`);
+    // console.log(`[WebGPU Worker] Bounds: min(${bounds.min.x.toFixed(2)}, ${bounds.min.y.toFixed(2)}, ${bounds.min.z.toFixed(2)}) max(${bounds.max.x.toFixed(2)}, ${bounds.max.y.toFixed(2)}, ${bounds.max.z.toFixed(2)})`);
+
+    // Verify result data integrity
+    if (filterMode === 0) {
+        // Terrain: Dense Z-only format
+        if (result.length > 0) {
+            const EMPTY_CELL = -1e10;
+            const firstZ = result[0] <= EMPTY_CELL + 1 ? 'EMPTY' : result[0].toFixed(3);
+            const lastZ = result[result.length-1] <= EMPTY_CELL + 1 ? 'EMPTY' : result[result.length-1].toFixed(3);
+            // console.log(`[WebGPU Worker] First Z: ${firstZ}, Last Z: ${lastZ}`);
+        }
+    } else {
+        // Tool: Sparse X,Y,Z format
+        if (result.length > 0) {
+            const firstPoint = `(${result[0].toFixed(3)}, ${result[1].toFixed(3)}, ${result[2].toFixed(3)})`;
+            const lastIdx = result.length - 3;
+            const lastPoint = `(${result[lastIdx].toFixed(3)}, ${result[lastIdx+1].toFixed(3)}, ${result[lastIdx+2].toFixed(3)})`;
+            // console.log(`[WebGPU Worker] First point: ${firstPoint}, Last point: ${lastPoint}`);
+        }
+    }
+
+    return {
+        positions: result,
+        pointCount: pointCount,
+        bounds: bounds,
+        conversionTime: conversionTime,
+        gridWidth: gridWidth,
+        gridHeight: gridHeight,
+        isDense: filterMode === 0  // True for terrain (dense), false for tool (sparse)
+    };
+}
+
+// Upload triangles and their spatial grid once so rasterize passes can be encoded without re-uploading
+function uploadMesh(triangles, bounds, spatialGrid = null) {
+    const grid = spatialGrid || buildSpatialGrid(triangles, bounds);
+
+    const triangleBuffer = device.createBuffer({
+        size: triangles.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(triangleBuffer, 0, triangles);
+
+    const spatialCellOffsetsBuffer = device.createBuffer({
+        size: grid.cellOffsets.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(spatialCellOffsetsBuffer, 0, grid.cellOffsets);
+
+    // Empty index lists are legal but zero-sized storage bindings are not
+    const spatialTriangleIndicesBuffer = device.createBuffer({
+        size: Math.max(4, grid.triangleIndices.byteLength),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(spatialTriangleIndicesBuffer, 0, grid.triangleIndices);
+
+    return {
+        triangleBuffer,
+        triangleCount: triangles.length / 9,
+        spatialGrid: grid,
+        spatialCellOffsetsBuffer,
+        spatialTriangleIndicesBuffer,
+        destroy() {
+            triangleBuffer.destroy();
+            spatialCellOffsetsBuffer.destroy();
+            spatialTriangleIndicesBuffer.destroy();
+        }
+    };
+}
+
+// Encode a rasterize pass for an uploaded mesh into an existing command encoder
+// Same uniforms and dispatch as rasterizeMeshSingle, but the output stays on the GPU so it can
+// feed later passes directly. Returns the output buffer plus transient buffers to destroy after submit.
+// sector (optional) selects one rotation sector of a mesh uploaded with a buildRadialSectorGrid grid.
+function encodeRasterizePass(commandEncoder, mesh, stepSize, filterMode, bounds, rotationAngleDeg = 0, sector = null) {
+    const gridWidth = Math.ceil((bounds.max.x - bounds.min.x) / stepSize) + 1;
+    const gridHeight = Math.ceil((bounds.max.y - bounds.min.y) / stepSize) + 1;
     const totalGridPoints = gridWidth * gridHeight;
+    const floatsPerPoint = filterMode === 0 ? 1 : 3;
+
+    const outputBuffer = device.createBuffer({
+        size: totalGridPoints * floatsPerPoint * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
+
+    // Terrain mode never writes the valid mask, so a single element satisfies the binding
+    const validMaskBuffer = device.createBuffer({
+        size: filterMode === 0 ? 4 : totalGridPoints * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
+
+    const uniformData = new Float32Array([
+        bounds.min.x, bounds.min.y, bounds.min.z,
+        bounds.max.x, bounds.max.y, bounds.max.z,
+        stepSize,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    ]);
+    const uniformDataU32 = new Uint32Array(uniformData.buffer);
+    uniformDataU32[7] = gridWidth;
+    uniformDataU32[8] = gridHeight;
+    uniformDataU32[9] = mesh.triangleCount;
+    uniformDataU32[10] = filterMode;
+    uniformDataU32[11] = mesh.spatialGrid.gridWidth;
+    uniformDataU32[12] = mesh.spatialGrid.gridHeight;
+    uniformData[13] = mesh.spatialGrid.cellSize;
+    const rotationAngleRad = rotationAngleDeg * Math.PI / 180;
+    uniformData[14] = Math.cos(rotationAngleRad);
+    uniformData[15] = Math.sin(rotationAngleRad);
+
+    const uniformBuffer = device.createBuffer({
+        size: uniformData.byteLength,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+    const cellOffsetsResource = sector === null
+        ? { buffer: mesh.spatialCellOffsetsBuffer }
+        : {
+            buffer: mesh.spatialCellOffsetsBuffer,
+            offset: sector * mesh.spatialGrid.sectorStride * 4,
+            size: (mesh.spatialGrid.gridWidth + 1) * 4
+        };
+
+    const bindGroup = device.createBindGroup({
+        layout: cachedRasterizePipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: mesh.triangleBuffer } },
+            { binding: 1, resource: { buffer: outputBuffer } },
+            { binding: 2, resource: { buffer: validMaskBuffer } },
+            { binding: 3, resource: { buffer: uniformBuffer } },
+            { binding: 4, resource: cellOffsetsResource },
+            { binding: 5, resource: { buffer: mesh.spatialTriangleIndicesBuffer } },
+        ],
+    });
+
+    const workgroupsX = Math.ceil(gridWidth / 16);
+    const workgroupsY = Math.ceil(gridHeight / 16);
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    if (workgroupsX > maxWorkgroupsPerDim || workgroupsY > maxWorkgroupsPerDim) {
+        throw new Error(`Workgroup dispatch too large: ${workgroupsX}x${workgroupsY} exceeds limit of ${maxWorkgroupsPerDim}. Try a larger step size.`);
+    }
+
+    const passEncoder = commandEncoder.beginComputePass();
+    passEncoder.setPipeline(cachedRasterizePipeline);
+    passEncoder.setBindGroup(0, bindGroup);
+    passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+    passEncoder.end();
+
+    return {
+        outputBuffer,
+        validMaskBuffer,
+        gridWidth,
+        gridHeight,
+        transientBuffers: [uniformBuffer]
+    };
+}
+
+// Create tiles for tiled rasterization
+function createTiles(bounds, stepSize, maxMemoryBytes) {
+    const width = bounds.max.x - bounds.min.x;
+    const height = bounds.max.y - bounds.min.y;
+    const aspectRatio = width / height;
+
+    // Calculate how many grid points we can fit in one tile
+    // Terrain uses dense Z-only format: (gridW * gridH * 1 * 4) for output
+    // This is 4x more efficient than the old sparse format (16 bytes → 4 bytes per point)
+    const bytesPerPoint = 1 * 4; // 4 bytes per grid point (Z-only)
+    const maxPointsPerTile = Math.floor(maxMemoryBytes / bytesPerPoint);
+    console.log(`[WebGPU Worker] Dense terrain format: ${bytesPerPoint} bytes/point (was 16), can fit ${(maxPointsPerTile/1e6).toFixed(1)}M points per tile`);
+
+    // Calculate optimal tile grid dimensions while respecting aspect ratio
+    // We want: tileGridW * tileGridH <= maxPointsPerTile
+    // And: tileGridW / tileGridH ≈ aspectRatio
+
+    let tileGridW, tileGridH;
+    if (aspectRatio >= 1) {
+        // Width >= Height
+        tileGridH = Math.floor(Math.sqrt(maxPointsPerTile / aspectRatio));
+        tileGridW = Math.floor(tileGridH * aspectRatio);
+    } else {
+        // Height > Width
+        tileGridW = Math.floor(Math.sqrt(maxPointsPerTile * aspectRatio));
+        tileGridH = Math.floor(tileGridW / aspectRatio);
+    }
+
+    // Ensure we don't exceed limits
+    while (tileGridW * tileGridH * bytesPerPoint > maxMemoryBytes) {
+        if (tileGridW > tileGridH) {
+            tileGridW--;
+        } else {
+            tileGridH--;
+        }
+    }
+
+    // Convert grid dimensions to world dimensions
+    const tileWidth = tileGridW * stepSize;
+    const tileHeight = tileGridH * stepSize;
+
+    // Calculate number of tiles needed
+    const tilesX = Math.ceil(width / tileWidth);
+    const tilesY = Math.ceil(height / tileHeight);
+
+    // Calculate actual tile dimensions (distribute evenly)
+    const actualTileWidth = width / tilesX;
+    const actualTileHeight = height / tilesY;
+
+    console.log(`[WebGPU Worker] Creating ${tilesX}x${tilesY} = ${tilesX * tilesY} tiles (${actualTileWidth.toFixed(2)}mm × ${actualTileHeight.toFixed(2)}mm each)`);
+    console.log(`[WebGPU Worker] Tile grid: ${Math.ceil(actualTileWidth / stepSize)}x${Math.ceil(actualTileHeight / stepSize)} points per tile`);
+
+    const tiles = [];
+    const overlap = stepSize * 2; // Overlap by 2 grid cells to ensure no gaps
+
+    for (let ty = 0; ty < tilesY; ty++) {
+        for (let tx = 0; tx < tilesX; tx++) {
+            // Calculate base tile bounds (no overlap)
+            let tileMinX = bounds.min.x + (tx * actualTileWidth);
+            let tileMinY = bounds.min.y + (ty * actualTileHeight);
+            let tileMaxX = Math.min(bounds.max.x, tileMinX + actualTileWidth);
+            let tileMaxY = Math.min(bounds.max.y, tileMinY + actualTileHeight);
+
+            // Add overlap (except at outer edges) - but DON'T extend beyond global bounds
+            if (tx > 0) tileMinX = Math.max(bounds.min.x, tileMinX - overlap);
+            if (ty > 0) tileMinY = Math.max(bounds.min.y, tileMinY - overlap);
+            if (tx < tilesX - 1) tileMaxX = Math.min(bounds.max.x, tileMaxX + overlap);
+            if (ty < tilesY - 1) tileMaxY = Math.min(bounds.max.y, tileMaxY + overlap);
+
+            tiles.push({
+                id: `tile_${tx}_${ty}`,
+                bounds: {
+                    min: { x: tileMinX, y: tileMinY, z: bounds.min.z },
+                    max: { x: tileMaxX, y: tileMaxY, z: bounds.max.z }
+                }
+            });
+        }
+    }
+
+    return { tiles, tilesX, tilesY };
+}
+
+// Stitch tiles from multiple rasterization passes
+function stitchTiles(tileResults, fullBounds, stepSize) {
+    if (tileResults.length === 0) {
+        throw new Error('No tile results to stitch');
+    }
+
+    // Check if results are dense (terrain) or sparse (tool)
+    const isDense = tileResults[0].isDense;
+
+    if (isDense) {
+        // DENSE TERRAIN STITCHING: Simple array copying (Z-only format)
+        console.log(`[WebGPU Worker] Stitching ${tileResults.length} dense terrain tiles...`);
+
+        // Calculate global grid dimensions
+        const globalWidth = Math.ceil((fullBounds.max.x - fullBounds.min.x) / stepSize) + 1;
+        const globalHeight = Math.ceil((fullBounds.max.y - fullBounds.min.y) / stepSize) + 1;
+        const totalGridCells = globalWidth * globalHeight;
+
+        // Allocate global dense grid (Z-only), initialize to sentinel value
+        const EMPTY_CELL = -1e10;
+        const globalGrid = new Float32Array(totalGridCells);
+        globalGrid.fill(EMPTY_CELL);
+
+        console.log(`[WebGPU Worker] Global grid: ${globalWidth}x${globalHeight} = ${totalGridCells.toLocaleString()} cells`);
+
+        // Copy each tile's Z-values to the correct position in global grid
+        for (const tile of tileResults) {
+            // Calculate tile's position in global grid
+            const tileOffsetX = Math.round((tile.tileBounds.min.x - fullBounds.min.x) / stepSize);
+            const tileOffsetY = Math.round((tile.tileBounds.min.y - fullBounds.min.y) / stepSize);
+
+            const tileWidth = tile.gridWidth;
+            const tileHeight = tile.gridHeight;
+
+            // Copy Z-values row by row
+            for (let ty = 0; ty < tileHeight; ty++) {
+                const globalY = tileOffsetY + ty;
+                if (globalY >= globalHeight) continue;
+
+                for (let tx = 0; tx < tileWidth; tx++) {
+                    const globalX = tileOffsetX + tx;
+                    if (globalX >= globalWidth) continue;
+
+                    const tileIdx = ty * tileWidth + tx;
+                    const globalIdx = globalY * globalWidth + globalX;
+                    const tileZ = tile.positions[tileIdx];
+
+                    // For overlapping cells, keep max Z (terrain surface)
+                    // Skip empty cells (sentinel value)
+                    if (tileZ > EMPTY_CELL + 1) {
+                        const existingZ = globalGrid[globalIdx];
+                        if (existingZ <= EMPTY_CELL + 1 || tileZ > existingZ) {
+                            globalGrid[globalIdx] = tileZ;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Count valid cells (above sentinel value)
+        let validCount = 0;
+        for (let i = 0; i < totalGridCells; i++) {
+            if (globalGrid[i] > EMPTY_CELL + 1) validCount++;
+        }
+
+        console.log(`[WebGPU Worker] ✅ Stitched: ${totalGridCells} total cells, ${validCount} with geometry (${(validCount/totalGridCells*100).toFixed(1)}% coverage)`);
+
+        return {
+            positions: globalGrid,
+            pointCount: totalGridCells,
+            bounds: fullBounds,
+            gridWidth: globalWidth,
+            gridHeight: globalHeight,
+            isDense: true,
+            conversionTime: tileResults.reduce((sum, r) => sum + (r.conversionTime || 0), 0),
+            tileCount: tileResults.length
+        };
+
+    } else {
+        // SPARSE TOOL STITCHING: Keep existing deduplication logic (X,Y,Z triplets)
+        console.log(`[WebGPU Worker] Stitching ${tileResults.length} sparse tool tiles...`);
+
+        const pointMap = new Map();
+
+        for (const result of tileResults) {
+            const positions = result.positions;
+
+            // Calculate offset from tile origin to global origin (in grid cells)
+            const tileOffsetX = Math.round((result.tileBounds.min.x - fullBounds.min.x) / stepSize);
+            const tileOffsetY = Math.round((result.tileBounds.min.y - fullBounds.min.y) / stepSize);
+
+            // Convert each point from tile-local to global grid coordinates
+            for (let i = 0; i < positions.length; i += 3) {
+                const localGridX = positions[i];
+                const localGridY = positions[i + 1];
+                const z = positions[i + 2];
+
+                // Convert local grid indices to global grid indices
+                const globalGridX = localGridX + tileOffsetX;
+                const globalGridY = localGridY + tileOffsetY;
+
+                const key = `${globalGridX},${globalGridY}`;
+                const existing = pointMap.get(key);
+
+                // Keep lowest Z value (for tool)
+                if (!existing || z < existing.z) {
+                    pointMap.set(key, { x: globalGridX, y: globalGridY, z });
+                }
+            }
+        }
+
+        // Convert Map to flat array
+        const finalPointCount = pointMap.size;
+        const allPositions = new Float32Array(finalPointCount * 3);
+        let writeOffset = 0;
+
+        for (const point of pointMap.values()) {
+            allPositions[writeOffset++] = point.x;
+            allPositions[writeOffset++] = point.y;
+            allPositions[writeOffset++] = point.z;
+        }
+
+        console.log(`[WebGPU Worker] ✅ Stitched: ${finalPointCount} unique sparse points`);
+
+        return {
+            positions: allPositions,
+            pointCount: finalPointCount,
+            bounds: fullBounds,
+            isDense: false,
+            conversionTime: tileResults.reduce((sum, r) => sum + (r.conversionTime || 0), 0),
+            tileCount: tileResults.length
+        };
+    }
+}
+
+// Check if tiling is needed (only called for terrain, which uses dense format)
+function shouldUseTiling(bounds, stepSize) {
+    if (!config || !config.autoTiling) return false;
+    if (!deviceCapabilities) return false;
+
+    const gridWidth = Math.ceil((bounds.max.x - bounds.min.x) / stepSize) + 1;
+    const gridHeight = Math.ceil((bounds.max.y - bounds.min.y) / stepSize) + 1;
+    const totalPoints = gridWidth * gridHeight;
+
+    // Terrain uses dense Z-only format: 1 float (4 bytes) per grid cell
+    const gpuOutputBuffer = totalPoints * 1 * 4;
+    const totalGPUMemory = gpuOutputBuffer;  // No mask needed for dense output
+
+    // Use the smaller of configured limit or device capability
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+
+    return totalGPUMemory > maxSafeSize;
+}
+
+// Rasterize mesh - wrapper that handles automatic tiling if needed
+async function rasterizeMesh(triangles, stepSize, filterMode, options = {}) {
+    const boundsOverride = options.bounds || options.min ? options : null;  // Support old and new format
+    const bounds = boundsOverride || options.meshBounds || calculateBounds(triangles);
+
+    // Check if tiling is needed
+    if (shouldUseTiling(bounds, stepSize)) {
+        console.log('[WebGPU Worker] Tiling required - switching to tiled rasterization');
+
+        // Calculate max safe size per tile
+        const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+        const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+        const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+
+        // Create tiles
+        const { tiles } = createTiles(bounds, stepSize, maxSafeSize);
+
+        // Rasterize each tile
+        const tileResults = [];
+        for (let i = 0; i < tiles.length; i++) {
+            const tileStart = performance.now();
+            console.log(`[WebGPU Worker] Processing tile ${i + 1}/${tiles.length}: ${tiles[i].id}`);
+            console.log(`[WebGPU Worker]   Tile bounds: min(${tiles[i].bounds.min.x.toFixed(2)}, ${tiles[i].bounds.min.y.toFixed(2)}) max(${tiles[i].bounds.max.x.toFixed(2)}, ${tiles[i].bounds.max.y.toFixed(2)})`);
+
+            const tileResult = await rasterizeMeshSingle(triangles, stepSize, filterMode, {
+                ...tiles[i].bounds,
+                rotationAngleDeg: options.rotationAngleDeg
+            });
+
+            const tileTime = performance.now() - tileStart;
+            console.log(`[WebGPU Worker]   Tile ${i + 1} complete: ${tileResult.pointCount} points in ${tileTime.toFixed(1)}ms`);
+
+            // Store tile bounds with result for coordinate conversion during stitching
+            tileResult.tileBounds = tiles[i].bounds;
+            tileResults.push(tileResult);
+        }
+
+        // Stitch tiles together (pass full bounds and step size for coordinate conversion)
+        return stitchTiles(tileResults, bounds, stepSize);
+    } else {
+        // Single-pass rasterization. Parsed mesh bounds go in as an override so calculateBounds is skipped;
+        // an override must have volume, so flat meshes keep the calculated path.
+        const meshBounds = !boundsOverride && options.meshBounds;
+        const hasVolume = meshBounds && meshBounds.min.x < meshBounds.max.x &&
+            meshBounds.min.y < meshBounds.max.y && meshBounds.min.z < meshBounds.max.z;
+        return await rasterizeMeshSingle(triangles, stepSize, filterMode, hasVolume ? { ...options, ...meshBounds } : options);
+    }
+}
+
+// Helper: Create height map from dense terrain points (Z-only array)
+// Terrain is ALWAYS dense (Z-only), never sparse
+function createHeightMapFromPoints(points, gridStep, bounds = null) {
+    if (!points || points.length === 0) {
+        throw new Error('No points provided');
+    }
+
+    // Calculate dimensions from bounds
+    if (!bounds) {
+        throw new Error('Bounds required for height map creation');
+    }
+
+    const minX = bounds.min.x;
+    const minY = bounds.min.y;
+    const minZ = bounds.min.z;
+    const maxX = bounds.max.x;
+    const maxY = bounds.max.y;
+    const maxZ = bounds.max.z;
+    const width = Math.ceil((maxX - minX) / gridStep) + 1;
+    const height = Math.ceil((maxY - minY) / gridStep) + 1;
+
+    // Terrain is ALWAYS dense (Z-only format from GPU rasterizer)
+    // console.log(`[WebGPU Worker] Terrain dense format: ${width}x${height} = ${points.length} cells`);
+
+    return {
+        grid: points,  // Dense Z-only array
+        width,
+        height,
+        minX,
+        minY,
+        minZ,
+        maxX,
+        maxY,
+        maxZ
+    };
+}
+
+// Helper: Create sparse tool representation
+// Points come from GPU as [gridX, gridY, Z] - pure integer grid coordinates for X/Y
+function createSparseToolFromPoints(points, gridStep) {
+    if (!points || points.length === 0) {
+        throw new Error('No tool points provided');
+    }
+
+    // Points are [gridX, gridY, Z] where gridX/gridY are grid indices (floats but integer values)
+    // Find bounds in grid space and tool tip Z
+    let minGridX = Infinity, minGridY = Infinity, minZ = Infinity;
+    let maxGridX = -Infinity, maxGridY = -Infinity;
+
+    for (let i = 0; i < points.length; i += 3) {
+        const gridX = points[i];      // Already a grid index
+        const gridY = points[i + 1];  // Already a grid index
+        const z = points[i + 2];
+
+        minGridX = Math.min(minGridX, gridX);
+        maxGridX = Math.max(maxGridX, gridX);
+        minGridY = Math.min(minGridY, gridY);
+        maxGridY = Math.max(maxGridY, gridY);
+        minZ = Math.min(minZ, z);
+    }
+
+    // Calculate tool center in grid coordinates (pure integer)
+    const width = Math.floor(maxGridX - minGridX) + 1;
+    const height = Math.floor(maxGridY - minGridY) + 1;
+    const centerX = Math.floor(minGridX) + Math.floor(width / 2);
+    const centerY = Math.floor(minGridY) + Math.floor(height / 2);
+
+    // Convert each point to offset from center (integer arithmetic only)
+    const xOffsets = [];
+    const yOffsets = [];
+    const zValues = [];
+
+    for (let i = 0; i < points.length; i += 3) {
+        const gridX = Math.floor(points[i]);      // Grid index (ensure integer)
+        const gridY = Math.floor(points[i + 1]);  // Grid index (ensure integer)
+        const z = points[i + 2];
+
+        // Calculate offset from tool center (pure integer arithmetic)
+        const xOffset = gridX - centerX;
+        const yOffset = gridY - centerY;
+        const zValue = z - minZ; // Z relative to tool tip
+
+        xOffsets.push(xOffset);
+        yOffsets.push(yOffset);
+        zValues.push(zValue);
+    }
+
+    return {
+        count: xOffsets.length,
+        xOffsets: new Int32Array(xOffsets),
+        yOffsets: new Int32Array(yOffsets),
+        zValues: new Float32Array(zValues),
+        referenceZ: minZ
+    };
+}
+
+// Generate toolpath for a single region (internal)
+async function generateToolpathSingle(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds = null, simplifyTolerance = null) {
+    const startTime = performance.now();
+    console.log('[WebGPU Worker] Generating toolpath...');
+    console.log(`[WebGPU Worker] Input: terrain ${terrainPoints.length/3} points, tool ${toolPoints.length/3} points, steps (${xStep}, ${yStep}), oobZ ${oobZ}, gridStep ${gridStep}`);
+
+    if (terrainBounds) {
+        console.log(`[WebGPU Worker] Using terrain bounds: min(${terrainBounds.min.x.toFixed(2)}, ${terrainBounds.min.y.toFixed(2)}, ${terrainBounds.min.z.toFixed(2)}) max(${terrainBounds.max.x.toFixed(2)}, ${terrainBounds.max.y.toFixed(2)}, ${terrainBounds.max.z.toFixed(2)})`);
+    }
+
+    try {
+        // Create height map from terrain points (use terrain bounds if provided)
+        const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+        console.log(`[WebGPU Worker] Created terrain map: ${terrainMapData.width}x${terrainMapData.height}`);
+
+        // Create sparse tool representation
+        const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+        console.log(`[WebGPU Worker] Created sparse tool: ${sparseToolData.count} points`);
+
+        // Run WebGPU compute
+        const result = await runToolpathCompute(
+            terrainMapData, sparseToolData, xStep, yStep, oobZ, startTime, simplifyTolerance
+        );
+
+        return result;
+    } catch (error) {
+        console.error('[WebGPU Worker] Error generating toolpath:', error);
+        throw error;
+    }
+}
+
+// Pack a sparse tool into the SparseToolPoint layout (x_offset, y_offset, z_value, padding) and upload it
+function uploadSparseTool(sparseToolData) {
+    const toolBufferData = new ArrayBuffer(sparseToolData.count * 16);
+    const toolBufferI32 = new Int32Array(toolBufferData);
+    const toolBufferF32 = new Float32Array(toolBufferData);
+
+    for (let i = 0; i < sparseToolData.count; i++) {
+        toolBufferI32[i * 4 + 0] = sparseToolData.xOffsets[i];
+        toolBufferI32[i * 4 + 1] = sparseToolData.yOffsets[i];
+        toolBufferF32[i * 4 + 2] = sparseToolData.zValues[i];
+        toolBufferF32[i * 4 + 3] = 0;
+    }
+
+    const toolBuffer = device.createBuffer({
+        size: toolBufferData.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(toolBuffer, 0, toolBufferData);
+    return toolBuffer;
+}
+
+// Encode a toolpath pass over a terrain buffer that is already on the GPU
+// tileWindow (optional) restricts the pass to a tile: {sampleOriginX, sampleOriginY, pointsPerLine,
+// numScanlines, bandStartY, bandEndY}, where terrainBuffer holds only global rows [bandStartY, bandEndY).
+// outputBuffer (optional) is reused instead of allocating a new one.
+// Returns the (resident) output buffer plus transient buffers to destroy once the work is submitted
+function encodeToolpathPass(commandEncoder, terrainBuffer, terrainWidth, terrainHeight, toolBuffer, toolCount, xStep, yStep, oobZ, tileWindow = null, outputBuffer = null) {
+    const pointsPerLine = tileWindow ? tileWindow.pointsPerLine : Math.ceil(terrainWidth / xStep);
+    const numScanlines = tileWindow ? tileWindow.numScanlines : Math.ceil(terrainHeight / yStep);
+    const outputSize = pointsPerLine * numScanlines;
+
+    if (!outputBuffer) {
+        outputBuffer = device.createBuffer({
+            size: outputSize * 4,
+            usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+        });
+    }
+
+    const uniformData = new Uint32Array([
+        terrainWidth,
+        terrainHeight,
+        toolCount,
+        xStep,
+        yStep,
+        0,
+        pointsPerLine,
+        numScanlines,
+        tileWindow ? tileWindow.sampleOriginX : 0,
+        tileWindow ? tileWindow.sampleOriginY : 0,
+        tileWindow ? tileWindow.bandStartY : 0,
+        tileWindow ? tileWindow.bandEndY : terrainHeight,
+    ]);
+    const uniformDataFloat = new Float32Array(uniformData.buffer);
+    uniformDataFloat[5] = oobZ;
+
+    const uniformBuffer = device.createBuffer({
+        size: uniformData.byteLength,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+    // Use cached pipeline
+    const bindGroup = device.createBindGroup({
+        layout: cachedToolpathPipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: terrainBuffer } },
+            { binding: 1, resource: { buffer: toolBuffer } },
+            { binding: 2, resource: { buffer: outputBuffer } },
+            { binding: 3, resource: { buffer: uniformBuffer } },
+        ],
+    });
+
+    const passEncoder = commandEncoder.beginComputePass();
+    passEncoder.setPipeline(cachedToolpathPipeline);
+    passEncoder.setBindGroup(0, bindGroup);
+
+    const workgroupsX = Math.ceil(pointsPerLine / 16);
+    const workgroupsY = Math.ceil(numScanlines / 16);
+    passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+    passEncoder.end();
+
+    return {
+        outputBuffer,
+        pointsPerLine,
+        numScanlines,
+        transientBuffers: [uniformBuffer]
+    };
+}
+
+// Copy a GPU buffer into a new staging buffer as part of an existing command encoder
+function encodeReadback(commandEncoder, sourceBuffer, size) {
+    const stagingBuffer = device.createBuffer({
+        size,
+        usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
+    });
+    commandEncoder.copyBufferToBuffer(sourceBuffer, 0, stagingBuffer, 0, size);
+    return stagingBuffer;
+}
+
+// Map a staging buffer filled by encodeReadback and return an owned Float32Array copy
+async function readStagingFloat32(stagingBuffer) {
+    await stagingBuffer.mapAsync(GPUMapMode.READ);
+    const result = new Float32Array(stagingBuffer.getMappedRange().slice(0));
+    stagingBuffer.unmap();
+    stagingBuffer.destroy();
+    return result;
+}
+
+// Simplify a dense toolpath held in pathBuffer (numScanlines x pointsPerLine) into per-scanline
+// polylines on the GPU, so only the kept vertices are read back. commandEncoder may already hold the
+// pass that fills pathBuffer; it is submitted here together with the count and scan passes.
+// Returns { vertices: Float32Array of (pointIdx, z) pairs, lineOffsets: Uint32Array(numScanlines + 1), vertexCount }
+async function simplifyToolpathOnGPU(commandEncoder, pathBuffer, pointsPerLine, numScanlines, tolerance) {
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    const totalWorkgroups = Math.ceil(numScanlines / 64);
+    const workgroupsX = Math.min(totalWorkgroups, maxWorkgroupsPerDim);
+    const workgroupsY = Math.ceil(totalWorkgroups / workgroupsX);
+
+    const createUniforms = (emitVertices) => {
+        const uniformData = new Uint32Array([pointsPerLine, numScanlines, 0, workgroupsX * 64, emitVertices, 0, 0, 0]);
+        new Float32Array(uniformData.buffer)[2] = tolerance;
+        const buffer = device.createBuffer({
+            size: uniformData.byteLength,
+            usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+        });
+        device.queue.writeBuffer(buffer, 0, uniformData);
+        return buffer;
+    };
+
+    const encodeWalk = (encoder, lineDataBuffer, verticesBuffer, uniformBuffer) => {
+        const bindGroup = device.createBindGroup({
+            layout: cachedToolpathSimplifyPipeline.getBindGroupLayout(0),
+            entries: [
+                { binding: 0, resource: { buffer: pathBuffer } },
+                { binding: 1, resource: { buffer: lineDataBuffer } },
+                { binding: 2, resource: { buffer: verticesBuffer } },
+                { binding: 3, resource: { buffer: uniformBuffer } },
+            ],
+        });
+        const passEncoder = encoder.beginComputePass();
+        passEncoder.setPipeline(cachedToolpathSimplifyPipeline);
+        passEncoder.setBindGroup(0, bindGroup);
+        passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+        passEncoder.end();
+    };
+
+    // Pass 1: count vertices per scanline, then scan counts into offsets
+    const countBuffer = device.createBuffer({
+        size: numScanlines * 4,
+        usage: GPUBufferUsage.STORAGE,
+    });
+    const offsetsBuffer = device.createBuffer({
+        size: (numScanlines + 1) * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
+    const placeholderVertices = device.createBuffer({
+        size: 8,
+        usage: GPUBufferUsage.STORAGE,
+    });
+    const countUniforms = createUniforms(0);
+    encodeWalk(commandEncoder, countBuffer, placeholderVertices, countUniforms);
+
+    const scanUniforms = device.createBuffer({
+        size: 16,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(scanUniforms, 0, new Uint32Array([numScanlines, 0, 0, 0]));
+    const scanBindGroup = device.createBindGroup({
+        layout: cachedPrefixSumPipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: countBuffer } },
+            { binding: 1, resource: { buffer: offsetsBuffer } },
+            { binding: 2, resource: { buffer: scanUniforms } },
+        ],
+    });
+    const scanPass = commandEncoder.beginComputePass();
+    scanPass.setPipeline(cachedPrefixSumPipeline);
+    scanPass.setBindGroup(0, scanBindGroup);
+    scanPass.dispatchWorkgroups(1);
+    scanPass.end();
 
-    // console.log(`[WebGPU Worker] Grid: ${gridWidth}x${gridHeight} = ${totalGridPoints.toLocaleString()} points`);
+    const offsetsStaging = encodeReadback(commandEncoder, offsetsBuffer, (numScanlines + 1) * 4);
+    device.queue.submit([commandEncoder.finish()]);
+    const lineOffsets = new Uint32Array((await readStagingFloat32(offsetsStaging)).buffer);
+    const vertexCount = lineOffsets[numScanlines];
 
-    // Calculate buffer size based on filter mode
-    // filterMode 0 (terrain): Dense Z-only output (1 float per grid cell)
-    // filterMode 1 (tool): Sparse X,Y,Z output (3 floats per grid cell)
-    const floatsPerPoint = filterMode === 0 ? 1 : 3;
-    const outputSize = totalGridPoints * floatsPerPoint * 4;
-    const maxBufferSize = device.limits.maxBufferSize || 268435456; // 256MB default
-    const modeStr = filterMode === 0 ? 'terrain (dense Z-only)' : 'tool (sparse XYZ)';
-    // console.log(`[WebGPU Worker] Output buffer size: ${(outputSize / 1024 / 1024).toFixed(2)} MB for ${modeStr} (max: ${(maxBufferSize / 1024 / 1024).toFixed(2)} MB)`);
+    // Pass 2: emit vertices into an exactly sized buffer and read back only those
+    const verticesBuffer = device.createBuffer({
+        size: Math.max(8, vertexCount * 8),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
+    const emitUniforms = createUniforms(1);
+    const emitEncoder = device.createCommandEncoder();
+    encodeWalk(emitEncoder, offsetsBuffer, verticesBuffer, emitUniforms);
+    const verticesStaging = encodeReadback(emitEncoder, verticesBuffer, Math.max(8, vertexCount * 8));
+    device.queue.submit([emitEncoder.finish()]);
+    const vertices = (await readStagingFloat32(verticesStaging)).subarray(0, vertexCount * 2);
+
+    countBuffer.destroy();
+    offsetsBuffer.destroy();
+    placeholderVertices.destroy();
+    verticesBuffer.destroy();
+    countUniforms.destroy();
+    emitUniforms.destroy();
+    scanUniforms.destroy();
+
+    return { vertices, lineOffsets, vertexCount };
+}
+
+// Concatenate simplified polylines of consecutive scanline bands (tiles) into one result
+function concatSimplifiedToolpaths(parts) {
+    let numScanlines = 0;
+    let vertexCount = 0;
+    for (const part of parts) {
+        numScanlines += part.lineOffsets.length - 1;
+        vertexCount += part.vertexCount;
+    }
+
+    const vertices = new Float32Array(vertexCount * 2);
+    const lineOffsets = new Uint32Array(numScanlines + 1);
+    let scanlineBase = 0;
+    let vertexBase = 0;
+    for (const part of parts) {
+        const partScanlines = part.lineOffsets.length - 1;
+        vertices.set(part.vertices.subarray(0, part.vertexCount * 2), vertexBase * 2);
+        for (let s = 1; s <= partScanlines; s++) {
+            lineOffsets[scanlineBase + s] = vertexBase + part.lineOffsets[s];
+        }
+        scanlineBase += partScanlines;
+        vertexBase += part.vertexCount;
+    }
+
+    return { vertices, lineOffsets, vertexCount };
+}
+
+// With simplifyTolerance set, the dense output stays on the GPU and only the simplified polylines
+// ({ vertices, lineOffsets, vertexCount }) are read back instead of pathData
+async function runToolpathCompute(terrainMapData, sparseToolData, xStep, yStep, oobZ, startTime, simplifyTolerance = null) {
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+
+    // Use WASM-generated terrain grid
+    const terrainBuffer = device.createBuffer({
+        size: terrainMapData.grid.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(terrainBuffer, 0, terrainMapData.grid);
+
+    // Use WASM-generated sparse tool
+    const toolBuffer = uploadSparseTool(sparseToolData);
+
+    const commandEncoder = device.createCommandEncoder();
+    const toolpath = encodeToolpathPass(
+        commandEncoder, terrainBuffer, terrainMapData.width, terrainMapData.height,
+        toolBuffer, sparseToolData.count, xStep, yStep, oobZ
+    );
+    const { pointsPerLine, numScanlines } = toolpath;
+    const outputSize = pointsPerLine * numScanlines;
+
+    console.log(`[WebGPU Worker] Output: ${pointsPerLine}x${numScanlines} = ${outputSize} points`);
+
+    if (simplifyTolerance !== null && simplifyTolerance !== undefined) {
+        const simplified = await simplifyToolpathOnGPU(
+            commandEncoder, toolpath.outputBuffer, pointsPerLine, numScanlines, simplifyTolerance
+        );
+
+        terrainBuffer.destroy();
+        toolBuffer.destroy();
+        toolpath.outputBuffer.destroy();
+        toolpath.transientBuffers.forEach(buffer => buffer.destroy());
+
+        const endTime = performance.now();
+        console.log(`[WebGPU Worker] ✅ Toolpath complete in ${(endTime - startTime).toFixed(1)}ms (simplified to ${simplified.vertexCount} of ${outputSize} points)`);
+
+        return {
+            ...simplified,
+            numScanlines,
+            pointsPerLine,
+            generationTime: endTime - startTime
+        };
+    }
+
+    const stagingBuffer = encodeReadback(commandEncoder, toolpath.outputBuffer, outputSize * 4);
+
+    device.queue.submit([commandEncoder.finish()]);
+    const result = await readStagingFloat32(stagingBuffer);
+
+    terrainBuffer.destroy();
+    toolBuffer.destroy();
+    toolpath.outputBuffer.destroy();
+    toolpath.transientBuffers.forEach(buffer => buffer.destroy());
+
+    const endTime = performance.now();
+    console.log(`[WebGPU Worker] ✅ Toolpath complete in ${(endTime - startTime).toFixed(1)}ms`);
+    console.log(`[WebGPU Worker] Output: ${result.length} values (${numScanlines} scanlines × ${pointsPerLine} points)`);
+
+    // Log sample of output for debugging
+    const sampleSize = Math.min(10, result.length);
+    console.log(`[WebGPU Worker] First ${sampleSize} values:`, Array.from(result.slice(0, sampleSize)));
+
+    return {
+        pathData: result,
+        numScanlines,
+        pointsPerLine,
+        generationTime: endTime - startTime
+    };
+}
+
+// Generate toolpath with tiling support (public API)
+// options.simplifyTolerance: return simplified polylines { vertices, lineOffsets, vertexCount } instead of pathData
+// options.shareTiles: when the job needs tiling, the tiles are not run here: the terrain and output are
+// placed in SharedArrayBuffers and returned as { tiledJob } for the caller to spread across workers
+async function generateToolpath(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds = null, options = {}) {
+    const { shareTiles = false, simplifyTolerance = null, rest = null, rasterAngle = null } = options;
+
+    // Calculate bounds if not provided
+    if (!terrainBounds) {
+        let minX = Infinity, minY = Infinity, minZ = Infinity;
+        let maxX = -Infinity, maxY = -Infinity, maxZ = -Infinity;
+        for (let i = 0; i < terrainPoints.length; i += 3) {
+            minX = Math.min(minX, terrainPoints[i]);
+            maxX = Math.max(maxX, terrainPoints[i]);
+            minY = Math.min(minY, terrainPoints[i + 1]);
+            maxY = Math.max(maxY, terrainPoints[i + 1]);
+            minZ = Math.min(minZ, terrainPoints[i + 2]);
+            maxZ = Math.max(maxZ, terrainPoints[i + 2]);
+        }
+        terrainBounds = {
+            min: { x: minX, y: minY, z: minZ },
+            max: { x: maxX, y: maxY, z: maxZ }
+        };
+    }
+
+    if (rasterAngle !== null) {
+        if (rest || simplifyTolerance !== null) {
+            throw new Error('rasterAngle cannot be combined with rest or simplifyTolerance');
+        }
+        // Angled passes sample the same dense heightmap; an array of angles (cross-hatch) shares one upload
+        const angles = Array.isArray(rasterAngle) ? rasterAngle : [rasterAngle];
+        const passes = await generateRotatedToolpaths(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds, angles);
+        return Array.isArray(rasterAngle) ? { passes } : passes[0];
+    }
+
+    if (rest) {
+        return await generateRestToolpath(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds, rest, simplifyTolerance ?? 0);
+    }
+
+    // Calculate tool dimensions for overlap
+    // Tool points are [gridX, gridY, Z] where X/Y are grid indices (not mm)
+    let toolMinX = Infinity, toolMaxX = -Infinity;
+    let toolMinY = Infinity, toolMaxY = -Infinity;
+    for (let i = 0; i < toolPoints.length; i += 3) {
+        toolMinX = Math.min(toolMinX, toolPoints[i]);
+        toolMaxX = Math.max(toolMaxX, toolPoints[i]);
+        toolMinY = Math.min(toolMinY, toolPoints[i + 1]);
+        toolMaxY = Math.max(toolMaxY, toolPoints[i + 1]);
+    }
+    // Tool dimensions in grid cells
+    const toolWidthCells = toolMaxX - toolMinX;
+    const toolHeightCells = toolMaxY - toolMinY;
+    // Convert to mm for logging
+    const toolWidthMm = toolWidthCells * gridStep;
+    const toolHeightMm = toolHeightCells * gridStep;
+
+    // Check if tiling is needed based on output grid size
+    const outputWidth = Math.ceil((terrainBounds.max.x - terrainBounds.min.x) / gridStep) + 1;
+    const outputHeight = Math.ceil((terrainBounds.max.y - terrainBounds.min.y) / gridStep) + 1;
+    const outputPoints = Math.ceil(outputWidth / xStep) * Math.ceil(outputHeight / yStep);
+    const outputMemory = outputPoints * 4; // 4 bytes per float
+
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+
+    if (outputMemory <= maxSafeSize) {
+        // No tiling needed
+        return await generateToolpathSingle(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds, simplifyTolerance);
+    }
+
+    // Tiling needed (terrain is ALWAYS dense)
+    const tilingStartTime = performance.now();
+    console.log('[WebGPU Worker] 🔲 Using tiled toolpath generation');
+    console.log(`[WebGPU Worker] Terrain: DENSE (${terrainPoints.length} cells = ${outputWidth}x${outputHeight})`);
+    console.log(`[WebGPU Worker] Tool dimensions: ${toolWidthMm.toFixed(2)}mm × ${toolHeightMm.toFixed(2)}mm (${toolWidthCells}×${toolHeightCells} cells)`);
+
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+    const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+    const pointsPerLine = Math.ceil(terrainMapData.width / xStep);
+    const numScanlines = Math.ceil(terrainMapData.height / yStep);
+
+    const tiles = planToolpathTiles(terrainMapData, sparseToolData, xStep, yStep, maxSafeSize);
+    console.log(`[WebGPU Worker] Created ${tiles.length} tiles`);
+
+    if (shareTiles && simplifyTolerance === null && tiles.length > 1 && typeof SharedArrayBuffer !== 'undefined') {
+        // One copy into shared memory here; pool workers then read the terrain and write their
+        // tiles' scanlines in place without any structured-clone copies or stitch pass
+        const sharedGrid = new Float32Array(new SharedArrayBuffer(terrainMapData.grid.length * 4));
+        sharedGrid.set(terrainMapData.grid);
+        return {
+            tiledJob: {
+                terrainMapData: { ...terrainMapData, grid: sharedGrid },
+                sparseToolData,
+                tiles,
+                xStep,
+                yStep,
+                oobZ,
+                pathData: new Float32Array(new SharedArrayBuffer(pointsPerLine * numScanlines * 4)),
+                numScanlines,
+                pointsPerLine,
+                planTime: performance.now() - tilingStartTime
+            }
+        };
+    }
+
+    // Each tile writes straight into its slice of the global result - no per-tile terrain copy or stitch pass.
+    // When simplifying, each tile's full-width scanlines are simplified on the GPU and concatenated instead.
+    const simplify = simplifyTolerance !== null && simplifyTolerance !== undefined;
+    const pathData = simplify ? null : new Float32Array(pointsPerLine * numScanlines);
+    const simplifiedTiles = await runToolpathTiles(terrainMapData, sparseToolData, xStep, yStep, oobZ, tiles, pathData, (tileIndex) => {
+        const percent = Math.round(((tileIndex + 1) / tiles.length) * 100);
+        self.postMessage({
+            type: 'toolpath-progress',
+            data: {
+                percent,
+                current: tileIndex + 1,
+                total: tiles.length,
+                layer: tileIndex + 1  // Using tile index as "layer" for consistency
+            }
+        });
+    }, simplifyTolerance);
+
+    const totalTime = performance.now() - tilingStartTime;
+    console.log(`[WebGPU Worker] ✅ Tiled toolpath complete: ${numScanlines}×${pointsPerLine} in ${totalTime.toFixed(1)}ms total`);
+
+    if (simplify) {
+        return {
+            ...concatSimplifiedToolpaths(simplifiedTiles),
+            numScanlines,
+            pointsPerLine,
+            generationTime: totalTime
+        };
+    }
+
+    return {
+        pathData,
+        numScanlines,
+        pointsPerLine,
+        generationTime: totalTime
+    };
+}
+
+// Terrain rows [start, end) the tool touches while evaluating output scanlines [sampleStartY, sampleEndY)
+function toolpathBandRows(sampleStartY, sampleEndY, yStep, sparseToolData, terrainHeight) {
+    let minYOffset = 0, maxYOffset = 0;
+    for (let i = 0; i < sparseToolData.count; i++) {
+        minYOffset = Math.min(minYOffset, sparseToolData.yOffsets[i]);
+        maxYOffset = Math.max(maxYOffset, sparseToolData.yOffsets[i]);
+    }
+    return {
+        bandStartY: Math.max(0, sampleStartY * yStep + minYOffset),
+        bandEndY: Math.min(terrainHeight, (sampleEndY - 1) * yStep + maxYOffset + 1),
+        toolRows: maxYOffset - minYOffset + 1
+    };
+}
+
+// Split the global toolpath output into tile windows that fit in maxMemoryBytes
+// Tiles are full-width bands of scanlines, so each tile maps to a contiguous slice of the global
+// output and its terrain band can be uploaded straight out of the global array without copying.
+// (A terrain band that fits always implies an output row fits, since pointsPerLine <= width.)
+function planToolpathTiles(terrainMapData, sparseToolData, xStep, yStep, maxMemoryBytes, maxTileScanlines = Infinity) {
+    const pointsPerLine = Math.ceil(terrainMapData.width / xStep);
+    const numScanlines = Math.ceil(terrainMapData.height / yStep);
+    const { toolRows } = toolpathBandRows(0, 1, yStep, sparseToolData, terrainMapData.height);
+
+    // Scanlines per tile are limited by both the output window and the terrain band it reads
+    const maxBandRows = Math.floor(maxMemoryBytes / (terrainMapData.width * 4));
+    if (maxBandRows < toolRows) {
+        throw new Error(`Terrain rows too wide to tile: ${terrainMapData.width} cells per row. Try a larger step size.`);
+    }
+    const scanlinesByTerrain = Math.floor((maxBandRows - toolRows) / yStep) + 1;
+    const scanlinesByOutput = Math.floor(maxMemoryBytes / (pointsPerLine * 4));
+    const tileScanlines = Math.max(1, Math.min(scanlinesByTerrain, scanlinesByOutput, numScanlines, maxTileScanlines));
+
+    const tiles = [];
+    for (let sampleStartY = 0; sampleStartY < numScanlines; sampleStartY += tileScanlines) {
+        const sampleEndY = Math.min(numScanlines, sampleStartY + tileScanlines);
+        const band = toolpathBandRows(sampleStartY, sampleEndY, yStep, sparseToolData, terrainMapData.height);
+        tiles.push({
+            id: `tile_${tiles.length}`,
+            sampleOriginX: 0,
+            sampleOriginY: sampleStartY,
+            pointsPerLine,
+            numScanlines: sampleEndY - sampleStartY,
+            bandStartY: band.bandStartY,
+            bandEndY: band.bandEndY
+        });
+    }
+
+    console.log(`[WebGPU Worker] Toolpath tiles: ${tiles.length} bands of ${tileScanlines} scanlines (output ${pointsPerLine}x${numScanlines})`);
+    return tiles;
+}
+
+// Run toolpath tile windows, writing each tile directly into its slice of pathData
+// The terrain is uploaded once when it fits in a single binding, otherwise streamed one band at a
+// time straight out of the global array. The sparse tool buffer is built once for all tiles.
+// With simplifyTolerance set, pathData is unused and the per-tile simplified polylines are returned.
+async function runToolpathTiles(terrainMapData, sparseToolData, xStep, yStep, oobZ, tiles, pathData, onTileComplete = null, simplifyTolerance = null) {
+    const simplifiedTiles = simplifyTolerance !== null ? new Array(tiles.length) : null;
+    const tileJob = await beginToolpathTiles({
+        terrainMapData, sparseToolData, xStep, yStep, oobZ, tiles, pathData,
+        consumeTile: simplifiedTiles ? simplifyTileConsumer(simplifiedTiles, simplifyTolerance) : null
+    });
+    try {
+        for (let i = 0; i < tiles.length; i++) {
+            await runToolpathTile(tileJob, i);
+            if (onTileComplete) {
+                onTileComplete(i, tiles[i]);
+            }
+        }
+    } finally {
+        endToolpathTiles(tileJob);
+    }
+    return simplifiedTiles;
+}
+
+// Tile consumer that simplifies each tile's scanlines on the GPU into results[tileIndex]
+// (tiles are full-width bands, so every tile scanline is a complete scanline)
+function simplifyTileConsumer(results, tolerance) {
+    return async (commandEncoder, outputBuffer, tile, tileIndex) => {
+        results[tileIndex] = await simplifyToolpathOnGPU(
+            commandEncoder, outputBuffer, tile.pointsPerLine, tile.numScanlines, tolerance
+        );
+    };
+}
+
+// Allocate the GPU resources shared by every tile of a tiled toolpath job
+// pathData receives global scanline (sampleOriginY - pathOriginY); pathOriginY defaults to 0 (global output).
+// consumeTile(commandEncoder, outputBuffer, tile, tileIndex), if set, replaces the readback: it must submit
+// commandEncoder and finish with outputBuffer before resolving.
+// streamTerrain forces band streaming even when the whole terrain would fit (used by pool workers,
+// which each only run a subset of the tiles and would otherwise each hold a full terrain copy)
+async function beginToolpathTiles(job, streamTerrain = false) {
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+
+    const { terrainMapData, sparseToolData, tiles } = job;
+    const terrainWidth = terrainMapData.width;
+    const terrainHeight = terrainMapData.height;
+
+    const deviceLimit = Math.min(deviceCapabilities.maxStorageBufferBindingSize, deviceCapabilities.maxBufferSize);
+    const residentTerrain = !streamTerrain && terrainWidth * terrainHeight * 4 <= deviceLimit;
+
+    let maxBandRows = 0;
+    let maxTileOutput = 0;
+    for (const tile of tiles) {
+        maxBandRows = Math.max(maxBandRows, tile.bandEndY - tile.bandStartY);
+        maxTileOutput = Math.max(maxTileOutput, tile.pointsPerLine * tile.numScanlines);
+    }
+
+    const terrainBuffer = device.createBuffer({
+        size: (residentTerrain ? terrainHeight : maxBandRows) * terrainWidth * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    if (residentTerrain) {
+        device.queue.writeBuffer(terrainBuffer, 0, terrainMapData.grid, 0, terrainWidth * terrainHeight);
+    }
+    console.log(`[WebGPU Worker] Tile terrain: ${residentTerrain ? 'uploaded once' : `streamed in bands of up to ${maxBandRows} rows`}`);
+
+    return {
+        ...job,
+        globalPointsPerLine: Math.ceil(terrainWidth / job.xStep),
+        residentTerrain,
+        uploadedBandStartY: -1,
+        terrainBuffer,
+        toolBuffer: uploadSparseTool(sparseToolData),
+        outputBuffer: device.createBuffer({
+            size: maxTileOutput * 4,
+            usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+        }),
+        stagingBuffer: device.createBuffer({
+            size: maxTileOutput * 4,
+            usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
+        })
+    };
+}
+
+// Run one tile of a tiled toolpath job and write its scanlines into the job's pathData
+async function runToolpathTile(tileJob, tileIndex) {
+    const tile = tileJob.tiles[tileIndex];
+    const { terrainMapData, sparseToolData, terrainBuffer, outputBuffer, stagingBuffer } = tileJob;
+    const terrainWidth = terrainMapData.width;
+    const terrainHeight = terrainMapData.height;
+    const tileStartTime = performance.now();
+
+    let tileWindow;
+    if (tileJob.residentTerrain) {
+        tileWindow = { ...tile, bandStartY: 0, bandEndY: terrainHeight };
+    } else {
+        tileWindow = tile;
+        if (tileJob.uploadedBandStartY !== tile.bandStartY) {
+            // Full-width rows are contiguous in the global grid, so this uploads a view without copying
+            device.queue.writeBuffer(
+                terrainBuffer, 0, terrainMapData.grid,
+                tile.bandStartY * terrainWidth, (tile.bandEndY - tile.bandStartY) * terrainWidth
+            );
+            tileJob.uploadedBandStartY = tile.bandStartY;
+        }
+    }
+
+    const tileOutputBytes = tile.pointsPerLine * tile.numScanlines * 4;
+    const commandEncoder = device.createCommandEncoder();
+    const toolpath = encodeToolpathPass(
+        commandEncoder, terrainBuffer, terrainWidth, terrainHeight,
+        tileJob.toolBuffer, sparseToolData.count, tileJob.xStep, tileJob.yStep, tileJob.oobZ, tileWindow, outputBuffer
+    );
+
+    if (tileJob.consumeTile) {
+        // The tile's output stays on the GPU and is handed to the job's consumer instead of read back
+        await tileJob.consumeTile(commandEncoder, outputBuffer, tile, tileIndex);
+        toolpath.transientBuffers.forEach(buffer => buffer.destroy());
+        const tileTime = performance.now() - tileStartTime;
+        console.log(`[WebGPU Worker] Tile ${tileIndex + 1}/${tileJob.tiles.length} complete (on GPU): ${tile.numScanlines}×${tile.pointsPerLine} in ${tileTime.toFixed(1)}ms`);
+        return tileTime;
+    }
+
+    commandEncoder.copyBufferToBuffer(outputBuffer, 0, stagingBuffer, 0, tileOutputBytes);
+    device.queue.submit([commandEncoder.finish()]);
+
+    await stagingBuffer.mapAsync(GPUMapMode.READ, 0, tileOutputBytes);
+    tileJob.pathData.set(
+        new Float32Array(stagingBuffer.getMappedRange(0, tileOutputBytes)),
+        (tile.sampleOriginY - (tileJob.pathOriginY || 0)) * tileJob.globalPointsPerLine
+    );
+    stagingBuffer.unmap();
+    toolpath.transientBuffers.forEach(buffer => buffer.destroy());
+
+    const tileTime = performance.now() - tileStartTime;
+    console.log(`[WebGPU Worker] Tile ${tileIndex + 1}/${tileJob.tiles.length} complete: ${tile.numScanlines}×${tile.pointsPerLine} in ${tileTime.toFixed(1)}ms`);
+    return tileTime;
+}
+
+function endToolpathTiles(tileJob) {
+    tileJob.terrainBuffer.destroy();
+    tileJob.toolBuffer.destroy();
+    tileJob.outputBuffer.destroy();
+    tileJob.stagingBuffer.destroy();
+}
+
+// Generate toolpaths for several tools over one terrain in a single dispatch (public API)
+// tools: [{ toolPositions, xStep, yStep, zFloor }]. Returns one result per tool in input order.
+async function generateToolpathBatch(terrainPoints, tools, gridStep, terrainBounds) {
+    const startTime = performance.now();
+
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+
+    if (!tools || tools.length === 0) {
+        throw new Error('No tools provided');
+    }
+
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+
+    // Lay out each tool's sparse points and output block back to back
+    const sparseTools = [];
+    const ranges = [];
+    let totalToolPoints = 0;
+    let totalOutputPoints = 0;
+    for (const tool of tools) {
+        const sparseToolData = createSparseToolFromPoints(tool.toolPositions, gridStep);
+        const pointsPerLine = Math.ceil(terrainMapData.width / tool.xStep);
+        const numScanlines = Math.ceil(terrainMapData.height / tool.yStep);
+        ranges.push({
+            toolOffset: totalToolPoints,
+            toolCount: sparseToolData.count,
+            xStep: tool.xStep,
+            yStep: tool.yStep,
+            pointsPerLine,
+            numScanlines,
+            outputOffset: totalOutputPoints,
+            oobZ: tool.zFloor
+        });
+        sparseTools.push(sparseToolData);
+        totalToolPoints += sparseToolData.count;
+        totalOutputPoints += pointsPerLine * numScanlines;
+    }
+
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+
+    if (totalOutputPoints * 4 > maxSafeSize || terrainPoints.byteLength > deviceLimit) {
+        // Combined output too large for one binding: run each tool through the (tiling) single-tool path
+        console.log(`[WebGPU Worker] Batch output too large (${(totalOutputPoints * 4 / 1024 / 1024).toFixed(1)}MB) - generating tools one by one`);
+        const results = [];
+        for (const tool of tools) {
+            results.push(await generateToolpath(terrainPoints, tool.toolPositions, tool.xStep, tool.yStep, tool.zFloor, gridStep, terrainBounds));
+        }
+        return { results, generationTime: performance.now() - startTime };
+    }
 
-    if (outputSize > maxBufferSize) {
-        throw new Error(`Output buffer too large: ${(outputSize / 1024 / 1024).toFixed(2)} MB exceeds device limit of ${(maxBufferSize / 1024 / 1024).toFixed(2)} MB. Try a larger step size.`);
+    // Concatenate sparse tools into one SparseToolPoint buffer
+    const merged = {
+        count: totalToolPoints,
+        xOffsets: new Int32Array(totalToolPoints),
+        yOffsets: new Int32Array(totalToolPoints),
+        zValues: new Float32Array(totalToolPoints)
+    };
+    for (let t = 0; t < sparseTools.length; t++) {
+        merged.xOffsets.set(sparseTools[t].xOffsets, ranges[t].toolOffset);
+        merged.yOffsets.set(sparseTools[t].yOffsets, ranges[t].toolOffset);
+        merged.zValues.set(sparseTools[t].zValues, ranges[t].toolOffset);
     }
 
-    const spatialGrid = buildSpatialGrid(triangles, bounds);
+    const terrainBuffer = device.createBuffer({
+        size: terrainMapData.grid.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(terrainBuffer, 0, terrainMapData.grid);
 
-    // Create buffers
-    const triangleBuffer = device.createBuffer({
-        size: triangles.byteLength,
+    const toolBuffer = uploadSparseTool(merged);
+
+    const rangeData = new Uint32Array(ranges.length * 8);
+    const rangeDataF32 = new Float32Array(rangeData.buffer);
+    ranges.forEach((range, r) => {
+        rangeData[r * 8 + 0] = range.toolOffset;
+        rangeData[r * 8 + 1] = range.toolCount;
+        rangeData[r * 8 + 2] = range.xStep;
+        rangeData[r * 8 + 3] = range.yStep;
+        rangeData[r * 8 + 4] = range.pointsPerLine;
+        rangeData[r * 8 + 5] = range.numScanlines;
+        rangeData[r * 8 + 6] = range.outputOffset;
+        rangeDataF32[r * 8 + 7] = range.oobZ;
+    });
+    const rangeBuffer = device.createBuffer({
+        size: rangeData.byteLength,
         usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
     });
-    device.queue.writeBuffer(triangleBuffer, 0, triangles);
+    device.queue.writeBuffer(rangeBuffer, 0, rangeData);
+
     const outputBuffer = device.createBuffer({
-        size: outputSize,
+        size: totalOutputPoints * 4,
         usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
     });
 
-    const validMaskBuffer = device.createBuffer({
-        size: totalGridPoints * 4,
+    // 1D workload folded into 2D so large batches stay under the per-dimension dispatch limit
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    const totalWorkgroups = Math.ceil(totalOutputPoints / 64);
+    const workgroupsX = Math.min(totalWorkgroups, maxWorkgroupsPerDim);
+    const workgroupsY = Math.ceil(totalWorkgroups / workgroupsX);
+
+    const uniformData = new Uint32Array([
+        terrainMapData.width,
+        terrainMapData.height,
+        ranges.length,
+        totalOutputPoints,
+        workgroupsX * 64,
+        0, 0, 0
+    ]);
+    const uniformBuffer = device.createBuffer({
+        size: uniformData.byteLength,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+    const bindGroup = device.createBindGroup({
+        layout: cachedToolpathBatchPipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: terrainBuffer } },
+            { binding: 1, resource: { buffer: toolBuffer } },
+            { binding: 2, resource: { buffer: outputBuffer } },
+            { binding: 3, resource: { buffer: uniformBuffer } },
+            { binding: 4, resource: { buffer: rangeBuffer } },
+        ],
+    });
+
+    const commandEncoder = device.createCommandEncoder();
+    const passEncoder = commandEncoder.beginComputePass();
+    passEncoder.setPipeline(cachedToolpathBatchPipeline);
+    passEncoder.setBindGroup(0, bindGroup);
+    passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+    passEncoder.end();
+
+    const stagingBuffer = encodeReadback(commandEncoder, outputBuffer, totalOutputPoints * 4);
+    device.queue.submit([commandEncoder.finish()]);
+    const allPaths = await readStagingFloat32(stagingBuffer);
+
+    terrainBuffer.destroy();
+    toolBuffer.destroy();
+    rangeBuffer.destroy();
+    outputBuffer.destroy();
+    uniformBuffer.destroy();
+
+    const endTime = performance.now();
+    console.log(`[WebGPU Worker] ✅ Batch toolpath complete: ${tools.length} tools, ${totalOutputPoints} points in ${(endTime - startTime).toFixed(1)}ms`);
+
+    // Per-tool results are views into one buffer so it is transferred once
+    const results = ranges.map(range => ({
+        pathData: allPaths.subarray(range.outputOffset, range.outputOffset + range.pointsPerLine * range.numScanlines),
+        numScanlines: range.numScanlines,
+        pointsPerLine: range.pointsPerLine,
+        generationTime: endTime - startTime
+    }));
+
+    return { results, generationTime: endTime - startTime };
+}
+
+// Create a prober that evaluates the tool at arbitrary output samples
+// probe(probes) takes a Uint32Array of (pointIdx, scanline) pairs and resolves to one Z per pair.
+// Terrain and tool stay resident between calls so refinement rounds only upload the probe list.
+async function createToolpathProber(terrainMapData, sparseToolData, xStep, yStep, oobZ, maxSafeSize) {
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+
+    const terrainBuffer = device.createBuffer({
+        size: terrainMapData.grid.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(terrainBuffer, 0, terrainMapData.grid);
+    const toolBuffer = uploadSparseTool(sparseToolData);
+
+    // 8 bytes of probe input + 4 bytes of output per probe
+    const maxProbesPerDispatch = Math.max(64, Math.floor(maxSafeSize / 8));
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+
+    const probeChunk = async (probes) => {
+        const probeCount = probes.length / 2;
+        const probeBuffer = device.createBuffer({
+            size: probes.byteLength,
+            usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+        });
+        device.queue.writeBuffer(probeBuffer, 0, probes);
+        const outputBuffer = device.createBuffer({
+            size: probeCount * 4,
+            usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+        });
+
+        // 1D workload folded into 2D so large probe lists stay under the per-dimension dispatch limit
+        const totalWorkgroups = Math.ceil(probeCount / 64);
+        const workgroupsX = Math.min(totalWorkgroups, maxWorkgroupsPerDim);
+        const workgroupsY = Math.ceil(totalWorkgroups / workgroupsX);
+
+        const uniformData = new Uint32Array([
+            terrainMapData.width,
+            terrainMapData.height,
+            sparseToolData.count,
+            xStep,
+            yStep,
+            0,
+            probeCount,
+            workgroupsX * 64
+        ]);
+        new Float32Array(uniformData.buffer)[5] = oobZ;
+        const uniformBuffer = device.createBuffer({
+            size: uniformData.byteLength,
+            usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+        });
+        device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+        const bindGroup = device.createBindGroup({
+            layout: cachedToolpathProbePipeline.getBindGroupLayout(0),
+            entries: [
+                { binding: 0, resource: { buffer: terrainBuffer } },
+                { binding: 1, resource: { buffer: toolBuffer } },
+                { binding: 2, resource: { buffer: outputBuffer } },
+                { binding: 3, resource: { buffer: uniformBuffer } },
+                { binding: 4, resource: { buffer: probeBuffer } },
+            ],
+        });
+
+        const commandEncoder = device.createCommandEncoder();
+        const passEncoder = commandEncoder.beginComputePass();
+        passEncoder.setPipeline(cachedToolpathProbePipeline);
+        passEncoder.setBindGroup(0, bindGroup);
+        passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+        passEncoder.end();
+
+        const stagingBuffer = encodeReadback(commandEncoder, outputBuffer, probeCount * 4);
+        device.queue.submit([commandEncoder.finish()]);
+        const z = await readStagingFloat32(stagingBuffer);
+
+        probeBuffer.destroy();
+        outputBuffer.destroy();
+        uniformBuffer.destroy();
+        return z;
+    };
+
+    return {
+        async probe(probes) {
+            const probeCount = probes.length / 2;
+            if (probeCount <= maxProbesPerDispatch) {
+                return probeChunk(probes);
+            }
+            const z = new Float32Array(probeCount);
+            for (let start = 0; start < probeCount; start += maxProbesPerDispatch) {
+                const end = Math.min(probeCount, start + maxProbesPerDispatch);
+                z.set(await probeChunk(probes.subarray(start * 2, end * 2)), start);
+            }
+            return z;
+        },
+        destroy() {
+            terrainBuffer.destroy();
+            toolBuffer.destroy();
+        }
+    };
+}
+
+// Generate an adaptively sampled planar toolpath (public API)
+// Each scanline is probed every coarseStride samples, then every interval whose midpoint or quarter
+// points deviate from the linear interpolation of its ends by more than tolerance (mm) is split.
+// Flat runs collapse to their end points. All intervals of a refinement round share one dispatch.
+// Returns variable-length polylines: vertices are (pointIdx, z) pairs, where pointIdx is the sample
+// index along the scanline (same units as the dense pathData), and scanline s owns vertices
+// [lineOffsets[s], lineOffsets[s + 1]).
+async function generateToolpathAdaptive(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds, tolerance, coarseStride = 16) {
+    const startTime = performance.now();
+
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+    const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+    const pointsPerLine = Math.ceil(terrainMapData.width / xStep);
+    const numScanlines = Math.ceil(terrainMapData.height / yStep);
+    coarseStride = Math.max(1, Math.floor(coarseStride));
+
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+
+    let prober;
+    if (terrainMapData.grid.byteLength <= maxSafeSize) {
+        prober = await createToolpathProber(terrainMapData, sparseToolData, xStep, yStep, oobZ, maxSafeSize);
+    } else {
+        // Terrain too large to keep resident: run the (tiled) dense path once and refine against it
+        console.log('[WebGPU Worker] Adaptive toolpath: terrain exceeds one binding, refining against the dense toolpath');
+        const dense = await generateToolpath(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds);
+        prober = {
+            async probe(probes) {
+                const z = new Float32Array(probes.length / 2);
+                for (let i = 0; i < z.length; i++) {
+                    z[i] = dense.pathData[probes[i * 2 + 1] * pointsPerLine + probes[i * 2]];
+                }
+                return z;
+            },
+            destroy() {}
+        };
+    }
+
+    // Kept vertices per scanline (unsorted until the end)
+    const lineX = Array.from({ length: numScanlines }, () => []);
+    const lineZ = Array.from({ length: numScanlines }, () => []);
+
+    // Coarse pass: every coarseStride samples plus the last sample of each scanline
+    const coarseX = [];
+    for (let x = 0; x < pointsPerLine; x += coarseStride) {
+        coarseX.push(x);
+    }
+    if (coarseX[coarseX.length - 1] !== pointsPerLine - 1) {
+        coarseX.push(pointsPerLine - 1);
+    }
+    const coarseProbes = new Uint32Array(coarseX.length * numScanlines * 2);
+    for (let s = 0; s < numScanlines; s++) {
+        for (let i = 0; i < coarseX.length; i++) {
+            const p = (s * coarseX.length + i) * 2;
+            coarseProbes[p] = coarseX[i];
+            coarseProbes[p + 1] = s;
+        }
+    }
+    const coarseZ = await prober.probe(coarseProbes);
+    let probeCount = coarseX.length * numScanlines;
+
+    // Pending intervals: (scanline, a, b) with end heights (za, zb) and, once known, the midpoint height zm
+    let pending = [];
+    for (let s = 0; s < numScanlines; s++) {
+        for (let i = 0; i < coarseX.length; i++) {
+            const z = coarseZ[s * coarseX.length + i];
+            lineX[s].push(coarseX[i]);
+            lineZ[s].push(z);
+            if (i > 0 && coarseX[i] - coarseX[i - 1] > 1) {
+                pending.push({ s, a: coarseX[i - 1], b: coarseX[i], za: coarseZ[s * coarseX.length + i - 1], zb: z, zm: NaN });
+            }
+        }
+    }
+
+    // An interval is accepted only if its midpoint and both quarter points lie within tolerance of the
+    // chord; a midpoint-only test misses kinks (e.g. flat-to-slope) where the midpoint happens to sit
+    // on the chord. When an interval is split, its quarter points are the children's midpoints.
+    let rounds = 0;
+    while (pending.length > 0) {
+        const probeX = [];
+        const probeS = [];
+        const slots = new Int32Array(pending.length * 3).fill(-1);
+        for (let i = 0; i < pending.length; i++) {
+            const { s, a, b, zm } = pending[i];
+            const m = (a + b) >> 1;
+            const quarters = [m, (a + m) >> 1, (m + b) >> 1];
+            for (let k = 0; k < 3; k++) {
+                const x = quarters[k];
+                if ((k === 0 && !Number.isNaN(zm)) || (k > 0 && (x === a || x === m || x === b))) {
+                    continue;
+                }
+                slots[i * 3 + k] = probeX.length;
+                probeX.push(x);
+                probeS.push(s);
+            }
+        }
+
+        const probes = new Uint32Array(probeX.length * 2);
+        for (let i = 0; i < probeX.length; i++) {
+            probes[i * 2] = probeX[i];
+            probes[i * 2 + 1] = probeS[i];
+        }
+        const probeZ = probes.length > 0 ? await prober.probe(probes) : new Float32Array(0);
+        probeCount += probeX.length;
+        rounds++;
+
+        const next = [];
+        for (let i = 0; i < pending.length; i++) {
+            const { s, a, b, za, zb } = pending[i];
+            const m = (a + b) >> 1;
+            const zm = slots[i * 3] >= 0 ? probeZ[slots[i * 3]] : pending[i].zm;
+            const q1 = (a + m) >> 1, q2 = (m + b) >> 1;
+            const zq1 = slots[i * 3 + 1] >= 0 ? probeZ[slots[i * 3 + 1]] : NaN;
+            const zq2 = slots[i * 3 + 2] >= 0 ? probeZ[slots[i * 3 + 2]] : NaN;
+
+            const chordError = (x, z) => Number.isNaN(z) ? 0 : Math.abs(z - (za + (zb - za) * (x - a) / (b - a)));
+            if (chordError(m, zm) <= tolerance && chordError(q1, zq1) <= tolerance && chordError(q2, zq2) <= tolerance) {
+                continue;
+            }
+            lineX[s].push(m);
+            lineZ[s].push(zm);
+            if (m - a > 1) next.push({ s, a, b: m, za, zb: zm, zm: zq1 });
+            if (b - m > 1) next.push({ s, a: m, b, za: zm, zb, zm: zq2 });
+        }
+        pending = next;
+    }
+
+    prober.destroy();
+
+    // Pack sorted polylines
+    const lineOffsets = new Uint32Array(numScanlines + 1);
+    for (let s = 0; s < numScanlines; s++) {
+        lineOffsets[s + 1] = lineOffsets[s] + lineX[s].length;
+    }
+    const vertexCount = lineOffsets[numScanlines];
+    const vertices = new Float32Array(vertexCount * 2);
+    for (let s = 0; s < numScanlines; s++) {
+        const order = lineX[s].map((_, i) => i).sort((i, j) => lineX[s][i] - lineX[s][j]);
+        let v = lineOffsets[s] * 2;
+        for (const i of order) {
+            vertices[v++] = lineX[s][i];
+            vertices[v++] = lineZ[s][i];
+        }
+    }
+
+    const generationTime = performance.now() - startTime;
+    const denseCount = pointsPerLine * numScanlines;
+    console.log(`[WebGPU Worker] ✅ Adaptive toolpath: ${vertexCount} vertices (dense ${denseCount}), ${probeCount} probes in ${rounds + 1} passes, ${generationTime.toFixed(1)}ms`);
+
+    return {
+        vertices,
+        lineOffsets,
+        numScanlines,
+        pointsPerLine,
+        vertexCount,
+        probeCount,
+        generationTime
+    };
+}
+
+// Extract Z-level roughing segments from an offset surface band already on the GPU
+// commandEncoder may hold the pass that fills offsetBuffer; it is submitted here (count + scan), then
+// the segments are emitted into an exactly sized buffer. Lines are indexed layer * numRows + row.
+async function extractZLevelSegmentsOnGPU(commandEncoder, offsetBuffer, pointsPerLine, numRows, rowOrigin, zLevelsBuffer, layerCount, allowance) {
+    const lineCount = layerCount * numRows;
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    const totalWorkgroups = Math.ceil(lineCount / 64);
+    const workgroupsX = Math.min(totalWorkgroups, maxWorkgroupsPerDim);
+    const workgroupsY = Math.ceil(totalWorkgroups / workgroupsX);
+
+    const createUniforms = (emitSegments) => {
+        const uniformData = new Uint32Array([pointsPerLine, numRows, layerCount, workgroupsX * 64, emitSegments, rowOrigin, 0, 0]);
+        new Float32Array(uniformData.buffer)[6] = allowance;
+        const buffer = device.createBuffer({
+            size: uniformData.byteLength,
+            usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+        });
+        device.queue.writeBuffer(buffer, 0, uniformData);
+        return buffer;
+    };
+
+    const encodeWalk = (encoder, lineDataBuffer, segmentsBuffer, uniformBuffer) => {
+        const bindGroup = device.createBindGroup({
+            layout: cachedZLevelSegmentsPipeline.getBindGroupLayout(0),
+            entries: [
+                { binding: 0, resource: { buffer: offsetBuffer } },
+                { binding: 1, resource: { buffer: lineDataBuffer } },
+                { binding: 2, resource: { buffer: segmentsBuffer } },
+                { binding: 3, resource: { buffer: uniformBuffer } },
+                { binding: 4, resource: { buffer: zLevelsBuffer } },
+            ],
+        });
+        const passEncoder = encoder.beginComputePass();
+        passEncoder.setPipeline(cachedZLevelSegmentsPipeline);
+        passEncoder.setBindGroup(0, bindGroup);
+        passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+        passEncoder.end();
+    };
+
+    const countBuffer = device.createBuffer({
+        size: lineCount * 4,
+        usage: GPUBufferUsage.STORAGE,
+    });
+    const offsetsBuffer = device.createBuffer({
+        size: (lineCount + 1) * 4,
         usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
     });
+    const placeholderSegments = device.createBuffer({
+        size: 8,
+        usage: GPUBufferUsage.STORAGE,
+    });
+    const countUniforms = createUniforms(0);
+    encodeWalk(commandEncoder, countBuffer, placeholderSegments, countUniforms);
 
-    const spatialCellOffsetsBuffer = device.createBuffer({
-        size: spatialGrid.cellOffsets.byteLength,
+    const scanUniforms = device.createBuffer({
+        size: 16,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(scanUniforms, 0, new Uint32Array([lineCount, 0, 0, 0]));
+    const scanPass = commandEncoder.beginComputePass();
+    scanPass.setPipeline(cachedPrefixSumPipeline);
+    scanPass.setBindGroup(0, device.createBindGroup({
+        layout: cachedPrefixSumPipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: countBuffer } },
+            { binding: 1, resource: { buffer: offsetsBuffer } },
+            { binding: 2, resource: { buffer: scanUniforms } },
+        ],
+    }));
+    scanPass.dispatchWorkgroups(1);
+    scanPass.end();
+
+    const offsetsStaging = encodeReadback(commandEncoder, offsetsBuffer, (lineCount + 1) * 4);
+    device.queue.submit([commandEncoder.finish()]);
+    const segmentOffsets = new Uint32Array((await readStagingFloat32(offsetsStaging)).buffer);
+    const segmentCount = segmentOffsets[lineCount];
+
+    const segmentsBuffer = device.createBuffer({
+        size: Math.max(8, segmentCount * 8),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
+    const emitUniforms = createUniforms(1);
+    const emitEncoder = device.createCommandEncoder();
+    encodeWalk(emitEncoder, offsetsBuffer, segmentsBuffer, emitUniforms);
+    const segmentsStaging = encodeReadback(emitEncoder, segmentsBuffer, Math.max(8, segmentCount * 8));
+    device.queue.submit([emitEncoder.finish()]);
+    const segments = new Uint32Array((await readStagingFloat32(segmentsStaging)).buffer, 0, segmentCount * 2);
+
+    countBuffer.destroy();
+    offsetsBuffer.destroy();
+    placeholderSegments.destroy();
+    segmentsBuffer.destroy();
+    countUniforms.destroy();
+    emitUniforms.destroy();
+    scanUniforms.destroy();
+
+    return { segments, segmentOffsets, segmentCount };
+}
+
+// Generate Z-level (waterline) zig-zag roughing for a list of layer heights in one job (public API)
+// The offset surface (tool tip Z over the terrain at xStep/yStep) is computed once per tile band and
+// stays on the GPU; every layer is classified against it in the same dispatch, so nothing is
+// re-rasterized or re-uploaded per layer. allowance leaves stock above the part.
+// Returns segments as (start, end) sample index pairs in cut order; layer k, scanline s owns
+// segments [segmentOffsets[k * numScanlines + s], segmentOffsets[k * numScanlines + s + 1]).
+async function generateZLevelRoughing(terrainPoints, toolPoints, xStep, yStep, gridStep, zLevels, terrainBounds, allowance = 0) {
+    const startTime = performance.now();
+    if (!zLevels || zLevels.length === 0) {
+        throw new Error('At least one Z level required');
+    }
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+    const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+    const pointsPerLine = Math.ceil(terrainMapData.width / xStep);
+    const numScanlines = Math.ceil(terrainMapData.height / yStep);
+    const layerCount = zLevels.length;
+
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+
+    // Samples below every layer stay below the floor, so any oobZ under the lowest layer works
+    const oobZ = Math.min(terrainMapData.minZ, ...zLevels) - 1000;
+    const tiles = planToolpathTiles(terrainMapData, sparseToolData, xStep, yStep, maxSafeSize);
+
+    const zLevelsData = new Float32Array(zLevels);
+    const zLevelsBuffer = device.createBuffer({
+        size: zLevelsData.byteLength,
         usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
     });
-    device.queue.writeBuffer(spatialCellOffsetsBuffer, 0, spatialGrid.cellOffsets);
+    device.queue.writeBuffer(zLevelsBuffer, 0, zLevelsData);
+
+    const parts = new Array(tiles.length);
+    const tileJob = await beginToolpathTiles({
+        terrainMapData, sparseToolData, xStep, yStep, oobZ, tiles,
+        consumeTile: async (commandEncoder, outputBuffer, tile, tileIndex) => {
+            parts[tileIndex] = await extractZLevelSegmentsOnGPU(
+                commandEncoder, outputBuffer, tile.pointsPerLine, tile.numScanlines, tile.sampleOriginY,
+                zLevelsBuffer, layerCount, allowance
+            );
+        }
+    });
+    try {
+        for (let t = 0; t < tiles.length; t++) {
+            await runToolpathTile(tileJob, t);
+        }
+    } finally {
+        endToolpathTiles(tileJob);
+        zLevelsBuffer.destroy();
+    }
 
-    const spatialTriangleIndicesBuffer = device.createBuffer({
-        size: spatialGrid.triangleIndices.byteLength,
+    // Tile parts are layer-major over their own rows; interleave them into layer-major global rows
+    let segmentCount = 0;
+    for (const part of parts) {
+        segmentCount += part.segmentCount;
+    }
+    const segments = new Uint32Array(segmentCount * 2);
+    const segmentOffsets = new Uint32Array(layerCount * numScanlines + 1);
+    let written = 0;
+    for (let layer = 0; layer < layerCount; layer++) {
+        for (let t = 0; t < tiles.length; t++) {
+            const { segments: partSegments, segmentOffsets: partOffsets } = parts[t];
+            const rows = tiles[t].numScanlines;
+            for (let row = 0; row < rows; row++) {
+                const line = layer * numScanlines + tiles[t].sampleOriginY + row;
+                const start = partOffsets[layer * rows + row];
+                const end = partOffsets[layer * rows + row + 1];
+                segmentOffsets[line] = written;
+                segments.set(partSegments.subarray(start * 2, end * 2), written * 2);
+                written += end - start;
+            }
+        }
+    }
+    segmentOffsets[layerCount * numScanlines] = written;
+
+    const generationTime = performance.now() - startTime;
+    console.log(`[WebGPU Worker] ✅ Z-level roughing: ${layerCount} layers, ${segmentCount} segments over ${numScanlines}×${pointsPerLine} in ${generationTime.toFixed(1)}ms`);
+
+    return {
+        segments,
+        segmentOffsets,
+        segmentCount,
+        zLevels: zLevelsData,
+        numScanlines,
+        pointsPerLine,
+        generationTime
+    };
+}
+
+// Raster frame for a scan angle (degrees from +X towards +Y) covering the whole terrain grid
+// Returns the grid position of sample (0, 0), unit scan/step directions and the output dimensions
+function rotatedRasterFrame(terrainWidth, terrainHeight, angleDegrees, xStep, yStep) {
+    const angle = angleDegrees * Math.PI / 180;
+    // Snap exact axis directions so 0/90/180/270 degree passes land on grid cells
+    const snap = (v) => Math.abs(v) < 1e-12 ? 0 : v;
+    const scanDir = { x: snap(Math.cos(angle)), y: snap(Math.sin(angle)) };
+    const stepDir = { x: -scanDir.y, y: scanDir.x };
+
+    let minAlong = Infinity, maxAlong = -Infinity, minAcross = Infinity, maxAcross = -Infinity;
+    for (const [x, y] of [[0, 0], [terrainWidth - 1, 0], [0, terrainHeight - 1], [terrainWidth - 1, terrainHeight - 1]]) {
+        const along = x * scanDir.x + y * scanDir.y;
+        const across = x * stepDir.x + y * stepDir.y;
+        minAlong = Math.min(minAlong, along);
+        maxAlong = Math.max(maxAlong, along);
+        minAcross = Math.min(minAcross, across);
+        maxAcross = Math.max(maxAcross, across);
+    }
+
+    return {
+        origin: {
+            x: minAlong * scanDir.x + minAcross * stepDir.x,
+            y: minAlong * scanDir.y + minAcross * stepDir.y
+        },
+        scanDir,
+        stepDir,
+        pointsPerLine: Math.floor((maxAlong - minAlong) / xStep + 1e-9) + 1,
+        numScanlines: Math.floor((maxAcross - minAcross) / yStep + 1e-9) + 1
+    };
+}
+
+// Generate planar toolpaths at arbitrary raster angles over one terrain upload (e.g. cross-hatch finishing)
+// The heightmap is never re-rasterized: each pass samples it along rotated scanlines. The tool footprint
+// stays in the world frame (it does not turn with the raster direction). Output rows are dispatched in bands that fit the memory budget.
+// Each result carries its frame so sample (i, s) maps to world XY:
+//   bounds.min + gridStep * (sampleOrigin + i * xStep * scanDirection + s * yStep * stepDirection)
+async function generateRotatedToolpaths(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds, angles) {
+    const startTime = performance.now();
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+    const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+    const { width, height } = terrainMapData;
+
+    const deviceLimit = Math.min(deviceCapabilities.maxStorageBufferBindingSize, deviceCapabilities.maxBufferSize);
+    if (width * height * 4 > deviceLimit) {
+        throw new Error(`Terrain too large for rotated rasters: ${width}x${height} cells. Try a larger grid step.`);
+    }
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const maxSafeSize = Math.min(configuredLimit, deviceCapabilities.maxStorageBufferBindingSize) * config.gpuMemorySafetyMargin;
+
+    const terrainBuffer = device.createBuffer({
+        size: width * height * 4,
         usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
     });
-    device.queue.writeBuffer(spatialTriangleIndicesBuffer, 0, spatialGrid.triangleIndices);
+    device.queue.writeBuffer(terrainBuffer, 0, terrainMapData.grid);
+
+    const toolData = new ArrayBuffer(sparseToolData.count * 16);
+    const toolDataI32 = new Int32Array(toolData);
+    const toolDataF32 = new Float32Array(toolData);
+    for (let i = 0; i < sparseToolData.count; i++) {
+        toolDataI32[i * 4] = sparseToolData.xOffsets[i];
+        toolDataI32[i * 4 + 1] = sparseToolData.yOffsets[i];
+        toolDataF32[i * 4 + 2] = sparseToolData.zValues[i];
+    }
+    const toolBuffer = device.createBuffer({
+        size: toolData.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(toolBuffer, 0, toolData);
+    const uniformBuffer = device.createBuffer({
+        size: 64,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+
+    const results = [];
+    try {
+        for (const angle of angles) {
+            const passStartTime = performance.now();
+            const frame = rotatedRasterFrame(width, height, angle, xStep, yStep);
+            const { pointsPerLine, numScanlines } = frame;
+
+            const bandScanlines = Math.max(1, Math.min(numScanlines, Math.floor(maxSafeSize / (pointsPerLine * 4))));
+            const outputBuffer = device.createBuffer({
+                size: bandScanlines * pointsPerLine * 4,
+                usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+            });
+            const bindGroup = device.createBindGroup({
+                layout: cachedToolpathRotatedPipeline.getBindGroupLayout(0),
+                entries: [
+                    { binding: 0, resource: { buffer: terrainBuffer } },
+                    { binding: 1, resource: { buffer: toolBuffer } },
+                    { binding: 2, resource: { buffer: outputBuffer } },
+                    { binding: 3, resource: { buffer: uniformBuffer } },
+                ],
+            });
+
+            const pathData = new Float32Array(pointsPerLine * numScanlines);
+            for (let scanlineStart = 0; scanlineStart < numScanlines; scanlineStart += bandScanlines) {
+                const bandCount = Math.min(bandScanlines, numScanlines - scanlineStart);
+                const uniformData = new Float32Array([
+                    0, 0, 0, 0, 0, 0, oobZ, xStep,
+                    yStep, frame.origin.x, frame.origin.y, frame.scanDir.x,
+                    frame.scanDir.y, frame.stepDir.x, frame.stepDir.y, 0
+                ]);
+                new Uint32Array(uniformData.buffer).set([width, height, sparseToolData.count, pointsPerLine, bandCount, scanlineStart]);
+                device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+                const commandEncoder = device.createCommandEncoder();
+                const passEncoder = commandEncoder.beginComputePass();
+                passEncoder.setPipeline(cachedToolpathRotatedPipeline);
+                passEncoder.setBindGroup(0, bindGroup);
+                passEncoder.dispatchWorkgroups(Math.ceil(pointsPerLine / 16), Math.ceil(bandCount / 16));
+                passEncoder.end();
+                const stagingBuffer = encodeReadback(commandEncoder, outputBuffer, bandCount * pointsPerLine * 4);
+                device.queue.submit([commandEncoder.finish()]);
+                pathData.set(await readStagingFloat32(stagingBuffer), scanlineStart * pointsPerLine);
+            }
+            outputBuffer.destroy();
+
+            results.push({
+                pathData,
+                numScanlines,
+                pointsPerLine,
+                rasterAngle: angle,
+                sampleOrigin: frame.origin,
+                scanDirection: frame.scanDir,
+                stepDirection: frame.stepDir,
+                generationTime: performance.now() - passStartTime
+            });
+        }
+    } finally {
+        terrainBuffer.destroy();
+        toolBuffer.destroy();
+        uniformBuffer.destroy();
+    }
+
+    const totalTime = performance.now() - startTime;
+    console.log(`[WebGPU Worker] ✅ Rotated rasters: ${angles.length} angle(s) [${angles.join(', ')}] over ${width}x${height} in ${totalTime.toFixed(1)}ms`);
+    return results;
+}
+
+// Offset surface (tool envelope) as a reusable product
+// The min-plus of terrain and tool is evaluated once at every grid cell (xStep = yStep = 1) and kept on
+// the GPU. Scan patterns are then a bilinear gather from it instead of a full collision evaluation.
+async function createOffsetSurface(terrainPoints, toolPoints, gridStep, terrainBounds, oobZ) {
+    const startTime = performance.now();
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+    disposeOffsetSurface();
+
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+    const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+    const { width, height } = terrainMapData;
+
+    const deviceLimit = Math.min(deviceCapabilities.maxStorageBufferBindingSize, deviceCapabilities.maxBufferSize);
+    if (width * height * 4 > deviceLimit) {
+        throw new Error(`Offset surface too large: ${width}x${height} cells. Try a larger grid step.`);
+    }
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const maxSafeSize = Math.min(configuredLimit, deviceCapabilities.maxStorageBufferBindingSize) * config.gpuMemorySafetyMargin;
+
+    const surfaceBuffer = device.createBuffer({
+        size: width * height * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC,
+    });
+
+    // Full-resolution tiles are copied into the resident surface on the GPU instead of read back
+    const tiles = planToolpathTiles(terrainMapData, sparseToolData, 1, 1, maxSafeSize);
+    const tileJob = await beginToolpathTiles({
+        terrainMapData, sparseToolData, xStep: 1, yStep: 1, oobZ, tiles,
+        consumeTile: async (commandEncoder, outputBuffer, tile) => {
+            commandEncoder.copyBufferToBuffer(
+                outputBuffer, 0, surfaceBuffer, tile.sampleOriginY * width * 4, tile.numScanlines * width * 4
+            );
+            device.queue.submit([commandEncoder.finish()]);
+        }
+    });
+    try {
+        for (let t = 0; t < tiles.length; t++) {
+            await runToolpathTile(tileJob, t);
+        }
+    } catch (error) {
+        surfaceBuffer.destroy();
+        throw error;
+    } finally {
+        endToolpathTiles(tileJob);
+    }
 
-    // Uniforms
-    const uniformData = new Float32Array([
-        bounds.min.x, bounds.min.y, bounds.min.z,
-        bounds.max.x, bounds.max.y, bounds.max.z,
-        stepSize,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0  // Extended for rotation_cos and rotation_sin
-    ]);
-    const uniformDataU32 = new Uint32Array(uniformData.buffer);
-    uniformDataU32[7] = gridWidth;
-    uniformDataU32[8] = gridHeight;
-    uniformDataU32[9] = triangles.length / 9;
-    uniformDataU32[10] = filterMode;
-    uniformDataU32[11] = spatialGrid.gridWidth;
-    uniformDataU32[12] = spatialGrid.gridHeight;
-    const uniformDataF32 = new Float32Array(uniformData.buffer);
-    uniformDataF32[13] = spatialGrid.cellSize;
+    residentOffsetSurface = {
+        surfaceBuffer,
+        width,
+        height,
+        gridStep,
+        minX: terrainBounds.min.x,
+        minY: terrainBounds.min.y,
+        oobZ
+    };
 
-    // Set rotation (identity by default: cos=1, sin=0)
-    const rotationAngleDeg = options.rotationAngleDeg ?? 0;
-    const rotationAngleRad = rotationAngleDeg * Math.PI / 180;
-    uniformDataF32[14] = Math.cos(rotationAngleRad);
-    uniformDataF32[15] = Math.sin(rotationAngleRad);
+    const generationTime = performance.now() - startTime;
+    console.log(`[WebGPU Worker] ✅ Offset surface: ${width}x${height} in ${generationTime.toFixed(1)}ms`);
+    return { width, height, generationTime };
+}
 
-    // Check for u32 overflow
-    const maxU32 = 4294967295;
-    if (gridWidth > maxU32 || gridHeight > maxU32) {
-        throw new Error(`Grid dimensions exceed u32 max: ${gridWidth}x${gridHeight}`);
+// Sample the resident offset surface with a scan pattern
+// { type: 'raster', xStep, yStep, rasterAngle } - returns the same layout as a (rotated) planar toolpath
+// { type: 'points', points } - world XY pairs (Float32Array); returns { z: Float32Array }
+async function sampleOffsetSurface(pattern) {
+    if (!residentOffsetSurface) {
+        throw new Error('No offset surface. Call createOffsetSurface first.');
     }
+    const startTime = performance.now();
+    const surface = residentOffsetSurface;
 
-    // console.log(`[WebGPU Worker] Uniforms: gridWidth=${gridWidth}, gridHeight=${gridHeight}, triangles=${triangles.length / 9}`);
+    const uniformData = new Float32Array(16);
+    const uniformDataU32 = new Uint32Array(uniformData.buffer);
+    let sampleCount;
+    let frame = null;
+    let pointData = null;
+
+    if (pattern.type === 'raster') {
+        const { xStep, yStep, rasterAngle = 0 } = pattern;
+        frame = rotatedRasterFrame(surface.width, surface.height, rasterAngle, xStep, yStep);
+        sampleCount = frame.pointsPerLine * frame.numScanlines;
+        uniformDataU32[3] = 1;
+        uniformDataU32[6] = frame.pointsPerLine;
+        uniformData.set([
+            frame.origin.x, frame.origin.y, frame.scanDir.x, frame.scanDir.y,
+            frame.stepDir.x, frame.stepDir.y, xStep, yStep
+        ], 8);
+    } else if (pattern.type === 'points') {
+        const points = pattern.points;
+        sampleCount = points.length / 2;
+        pointData = new Float32Array(points.length);
+        for (let i = 0; i < points.length; i += 2) {
+            pointData[i] = (points[i] - surface.minX) / surface.gridStep;
+            pointData[i + 1] = (points[i + 1] - surface.minY) / surface.gridStep;
+        }
+    } else {
+        throw new Error(`Unknown offset surface pattern: ${pattern.type}`);
+    }
+
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    const totalWorkgroups = Math.max(1, Math.ceil(sampleCount / 64));
+    const workgroupsX = Math.min(totalWorkgroups, maxWorkgroupsPerDim);
+    const workgroupsY = Math.ceil(totalWorkgroups / workgroupsX);
+
+    uniformDataU32[0] = surface.width;
+    uniformDataU32[1] = surface.height;
+    uniformDataU32[2] = sampleCount;
+    uniformData[4] = surface.oobZ;
+    uniformDataU32[5] = workgroupsX * 64;
 
     const uniformBuffer = device.createBuffer({
         size: uniformData.byteLength,
         usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
     });
     device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+    const pointsBuffer = device.createBuffer({
+        size: Math.max(8, pointData ? pointData.byteLength : 0),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    if (pointData && pointData.length > 0) {
+        device.queue.writeBuffer(pointsBuffer, 0, pointData);
+    }
+    const outputBuffer = device.createBuffer({
+        size: Math.max(4, sampleCount * 4),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
 
-    // Use cached pipeline
     const bindGroup = device.createBindGroup({
-        layout: cachedRasterizePipeline.getBindGroupLayout(0),
+        layout: cachedOffsetSurfaceGatherPipeline.getBindGroupLayout(0),
         entries: [
-            { binding: 0, resource: { buffer: triangleBuffer } },
-            { binding: 1, resource: { buffer: outputBuffer } },
-            { binding: 2, resource: { buffer: validMaskBuffer } },
+            { binding: 0, resource: { buffer: surface.surfaceBuffer } },
+            { binding: 1, resource: { buffer: pointsBuffer } },
+            { binding: 2, resource: { buffer: outputBuffer } },
             { binding: 3, resource: { buffer: uniformBuffer } },
-            { binding: 4, resource: { buffer: spatialCellOffsetsBuffer } },
-            { binding: 5, resource: { buffer: spatialTriangleIndicesBuffer } },
         ],
     });
-
-    // Dispatch compute shader
     const commandEncoder = device.createCommandEncoder();
     const passEncoder = commandEncoder.beginComputePass();
-    passEncoder.setPipeline(cachedRasterizePipeline);
+    passEncoder.setPipeline(cachedOffsetSurfaceGatherPipeline);
     passEncoder.setBindGroup(0, bindGroup);
+    passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+    passEncoder.end();
+    const stagingBuffer = encodeReadback(commandEncoder, outputBuffer, Math.max(4, sampleCount * 4));
+    device.queue.submit([commandEncoder.finish()]);
+    const z = (await readStagingFloat32(stagingBuffer)).subarray(0, sampleCount);
 
-    const workgroupsX = Math.ceil(gridWidth / 16);
-    const workgroupsY = Math.ceil(gridHeight / 16);
+    uniformBuffer.destroy();
+    pointsBuffer.destroy();
+    outputBuffer.destroy();
 
-    // Check dispatch limits
-    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
-    // console.log(`[WebGPU Worker] Dispatching ${workgroupsX}x${workgroupsY} workgroups (max per dim: ${maxWorkgroupsPerDim})`);
+    const generationTime = performance.now() - startTime;
+    if (frame) {
+        return {
+            pathData: z,
+            numScanlines: frame.numScanlines,
+            pointsPerLine: frame.pointsPerLine,
+            rasterAngle: pattern.rasterAngle ?? 0,
+            sampleOrigin: frame.origin,
+            scanDirection: frame.scanDir,
+            stepDirection: frame.stepDir,
+            generationTime
+        };
+    }
+    return { z, generationTime };
+}
 
-    if (workgroupsX > maxWorkgroupsPerDim || workgroupsY > maxWorkgroupsPerDim) {
-        throw new Error(`Workgroup dispatch too large: ${workgroupsX}x${workgroupsY} exceeds limit of ${maxWorkgroupsPerDim}. Try a larger step size.`);
+function disposeOffsetSurface() {
+    if (residentOffsetSurface) {
+        residentOffsetSurface.surfaceBuffer.destroy();
+        residentOffsetSurface = null;
     }
+}
 
-    passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
-    passEncoder.end();
+// Resident terrain for drop-cutter queries
+// The dense heightmap is uploaded once; queryToolZ then only uploads query positions (and the tool when
+// it changes) and runs a single dispatch, so a few thousand queries cost one small round trip.
+async function loadTerrain(terrainPoints, gridStep, terrainBounds) {
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+    disposeTerrain();
 
-    // Create staging buffers for readback
-    const stagingOutputBuffer = device.createBuffer({
-        size: outputSize,
-        usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
-    });
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+    const deviceLimit = Math.min(deviceCapabilities.maxStorageBufferBindingSize, deviceCapabilities.maxBufferSize);
+    if (terrainMapData.grid.byteLength > deviceLimit) {
+        throw new Error(`Terrain too large to keep resident: ${terrainMapData.width}x${terrainMapData.height} cells. Try a larger grid step.`);
+    }
 
-    const stagingValidMaskBuffer = device.createBuffer({
-        size: totalGridPoints * 4,
-        usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
+    const terrainBuffer = device.createBuffer({
+        size: terrainMapData.grid.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
     });
+    device.queue.writeBuffer(terrainBuffer, 0, terrainMapData.grid);
 
-    commandEncoder.copyBufferToBuffer(outputBuffer, 0, stagingOutputBuffer, 0, outputSize);
-    commandEncoder.copyBufferToBuffer(validMaskBuffer, 0, stagingValidMaskBuffer, 0, totalGridPoints * 4);
+    // Part cells stay on the CPU for contour patterns, which trace offsets of the part outline
+    const EMPTY_CELL = -1e10;
+    const partMask = new Uint8Array(terrainMapData.width * terrainMapData.height);
+    for (let i = 0; i < partMask.length; i++) {
+        partMask[i] = terrainMapData.grid[i] > EMPTY_CELL + 1 ? 1 : 0;
+    }
+
+    residentTerrain = {
+        terrainBuffer,
+        partMask,
+        width: terrainMapData.width,
+        height: terrainMapData.height,
+        gridStep,
+        minX: terrainBounds.min.x,
+        minY: terrainBounds.min.y,
+        // Query tool and per-call buffers, reused while they are large enough
+        toolPoints: null,
+        toolBuffer: null,
+        toolCount: 0,
+        capacity: 0,
+        stride: 1,
+        queryBuffer: null,
+        outputBuffer: null,
+        uniformBuffer: device.createBuffer({
+            size: 80,
+            usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+        })
+    };
+
+    console.log(`[WebGPU Worker] Terrain resident: ${terrainMapData.width}x${terrainMapData.height}`);
+    return { width: terrainMapData.width, height: terrainMapData.height };
+}
+
+// Densify a world-space XY polyline so no segment is longer than maxSegmentLength
+function densifyPolyline(polyline, maxSegmentLength) {
+    const out = [polyline[0], polyline[1]];
+    for (let i = 2; i < polyline.length; i += 2) {
+        const x0 = polyline[i - 2], y0 = polyline[i - 1];
+        const x1 = polyline[i], y1 = polyline[i + 1];
+        const steps = Math.max(1, Math.ceil(Math.hypot(x1 - x0, y1 - y0) / maxSegmentLength));
+        for (let k = 1; k <= steps; k++) {
+            const t = k / steps;
+            out.push(x0 + (x1 - x0) * t, y0 + (y1 - y0) * t);
+        }
+    }
+    return new Float32Array(out);
+}
+
+// Upload the query tool unless it matches the previous query's
+function ensureQueryTool(terrain, toolPoints) {
+    const sameTool = terrain.toolPoints && terrain.toolPoints.length === toolPoints.length &&
+        terrain.toolPoints.every((v, i) => v === toolPoints[i]);
+    if (sameTool) {
+        return;
+    }
+    if (terrain.toolBuffer) {
+        terrain.toolBuffer.destroy();
+    }
+    const sparseToolData = createSparseToolFromPoints(toolPoints, terrain.gridStep);
+    terrain.toolBuffer = uploadSparseTool(sparseToolData);
+    terrain.toolCount = sparseToolData.count;
+    terrain.toolPoints = Float32Array.from(toolPoints);
+}
+
+// World XY pairs to the query kernel's grid positions
+// Float32 world coordinates rarely land exactly on a cell; near-integer grid positions are snapped so
+// grid-aligned queries evaluate only their own cell
+function worldToQueryGrid(terrain, positions) {
+    const toGrid = (value, min) => {
+        const grid = (value - min) / terrain.gridStep;
+        const cell = Math.round(grid);
+        return Math.abs(grid - cell) < 1e-4 ? cell : grid;
+    };
+    const gridPositions = new Float32Array(positions.length);
+    for (let i = 0; i < positions.length; i += 2) {
+        gridPositions[i] = toGrid(positions[i], terrain.minX);
+        gridPositions[i + 1] = toGrid(positions[i + 1], terrain.minY);
+    }
+    return gridPositions;
+}
+
+// Run the query kernel over count samples against the resident terrain and read back the output
+// (stride floats per sample). queryPositions (grid XY pairs) feed mode 0; loopStarts feeds mode 2.
+async function dispatchToolQuery(terrain, oobZ, count, stride, mode = 0, queryPositions = null, patternUniforms = null, loopStarts = null) {
+    if (count > terrain.capacity || stride > terrain.stride) {
+        if (terrain.queryBuffer) {
+            terrain.queryBuffer.destroy();
+            terrain.outputBuffer.destroy();
+        }
+        terrain.capacity = Math.max(1024, count, terrain.capacity);
+        terrain.stride = Math.max(stride, terrain.stride);
+        terrain.queryBuffer = device.createBuffer({
+            size: terrain.capacity * 8,
+            usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+        });
+        terrain.outputBuffer = device.createBuffer({
+            size: terrain.capacity * terrain.stride * 4,
+            usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+        });
+    }
+
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    const totalWorkgroups = Math.max(1, Math.ceil(count / 64));
+    const workgroupsX = Math.min(totalWorkgroups, maxWorkgroupsPerDim);
+    const workgroupsY = Math.ceil(totalWorkgroups / workgroupsX);
+
+    const uniformData = new Float32Array(20);
+    if (patternUniforms) {
+        uniformData.set(patternUniforms, 8);
+    }
+    new Uint32Array(uniformData.buffer).set([
+        terrain.width, terrain.height, terrain.toolCount, count,
+        0, workgroupsX * 64, mode, loopStarts ? loopStarts.length - 1 : 0
+    ]);
+    uniformData[4] = oobZ;
+    device.queue.writeBuffer(terrain.uniformBuffer, 0, uniformData);
+    if (queryPositions && count > 0) {
+        device.queue.writeBuffer(terrain.queryBuffer, 0, queryPositions);
+    }
 
+    const loopStartsBuffer = device.createBuffer({
+        size: Math.max(4, loopStarts ? loopStarts.byteLength : 0),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    if (loopStarts) {
+        device.queue.writeBuffer(loopStartsBuffer, 0, loopStarts);
+    }
+
+    const bindGroup = device.createBindGroup({
+        layout: cachedToolQueryPipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: terrain.terrainBuffer } },
+            { binding: 1, resource: { buffer: terrain.toolBuffer } },
+            { binding: 2, resource: { buffer: terrain.outputBuffer } },
+            { binding: 3, resource: { buffer: terrain.uniformBuffer } },
+            { binding: 4, resource: { buffer: terrain.queryBuffer } },
+            { binding: 5, resource: { buffer: loopStartsBuffer } },
+        ],
+    });
+    const commandEncoder = device.createCommandEncoder();
+    const passEncoder = commandEncoder.beginComputePass();
+    passEncoder.setPipeline(cachedToolQueryPipeline);
+    passEncoder.setBindGroup(0, bindGroup);
+    passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+    passEncoder.end();
+    const stagingBuffer = encodeReadback(commandEncoder, terrain.outputBuffer, Math.max(4, count * stride * 4));
     device.queue.submit([commandEncoder.finish()]);
+    const output = (await readStagingFloat32(stagingBuffer)).subarray(0, count * stride);
 
-    // Wait for GPU to finish
-    await device.queue.onSubmittedWorkDone();
+    loopStartsBuffer.destroy();
+    return output;
+}
 
-    // Read back results
-    await stagingOutputBuffer.mapAsync(GPUMapMode.READ);
-    await stagingValidMaskBuffer.mapAsync(GPUMapMode.READ);
+// Tool-center Z at arbitrary world XY positions (drop-cutter) against the resident terrain
+// queries: Float32Array of XY pairs, or an array of XY polylines. Points resolve to { z: Float32Array };
+// polylines (optionally densified to maxSegmentLength) resolve to { polylines: [Float32Array of XYZ] }.
+async function queryToolZ(queries, toolPoints, oobZ, options = {}) {
+    if (!residentTerrain) {
+        throw new Error('No terrain. Call loadTerrain first.');
+    }
+    const terrain = residentTerrain;
+    const { maxSegmentLength = null } = options;
+
+    const polylines = Array.isArray(queries)
+        ? queries.map(polyline => maxSegmentLength ? densifyPolyline(polyline, maxSegmentLength) : polyline)
+        : null;
+    let positions = queries;
+    if (polylines) {
+        let total = 0;
+        for (const polyline of polylines) {
+            total += polyline.length;
+        }
+        positions = new Float32Array(total);
+        let offset = 0;
+        for (const polyline of polylines) {
+            positions.set(polyline, offset);
+            offset += polyline.length;
+        }
+    }
+    const queryCount = positions.length / 2;
 
-    const outputData = new Float32Array(stagingOutputBuffer.getMappedRange());
-    const validMaskData = new Uint32Array(stagingValidMaskBuffer.getMappedRange());
+    ensureQueryTool(terrain, toolPoints);
+    const z = await dispatchToolQuery(terrain, oobZ, queryCount, 1, 0, worldToQueryGrid(terrain, positions));
 
-    let result, pointCount;
+    if (!polylines) {
+        return { z };
+    }
+    let queryIndex = 0;
+    return {
+        polylines: polylines.map(polyline => {
+            const count = polyline.length / 2;
+            const xyz = new Float32Array(count * 3);
+            for (let i = 0; i < count; i++) {
+                xyz[i * 3] = polyline[i * 2];
+                xyz[i * 3 + 1] = polyline[i * 2 + 1];
+                xyz[i * 3 + 2] = z[queryIndex++];
+            }
+            return xyz;
+        })
+    };
+}
 
-    if (filterMode === 0) {
-        // Terrain: Dense output (Z-only), no compaction needed
-        // Copy the full array (already has NaN for empty cells)
-        result = new Float32Array(outputData);
-        pointCount = totalGridPoints;
+// Contour-parallel offsets of the part outline
+// The outline is the boundary between part cells and empty cells of the resident terrain. A signed
+// Euclidean distance field to it is thresholded at each offset and the iso-contours are traced with
+// marching squares into closed loops, which the query kernel then evaluates like any other positions.
+
+// 1D squared distance transform of f (Felzenszwalb & Huttenlocher) into d; v and z are scratch
+function squaredDistance1D(f, n, d, v, z) {
+    let k = 0;
+    v[0] = 0;
+    z[0] = -Infinity;
+    z[1] = Infinity;
+    for (let q = 1; q < n; q++) {
+        let s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = Infinity;
+    }
+    k = 0;
+    for (let q = 0; q < n; q++) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
 
-        // Count actual valid points for logging (sentinel value = -1e10)
-        const EMPTY_CELL = -1e10;
-        let validCount = 0;
-        for (let i = 0; i < totalGridPoints; i++) {
-            if (result[i] > EMPTY_CELL + 1) validCount++;  // Any value significantly above sentinel
+// Squared distance (cells) from every cell to the nearest cell where isTarget(i) holds
+function squaredDistanceTransform(width, height, isTarget) {
+    const INF = 1e20;
+    const grid = new Float64Array(width * height);
+    for (let i = 0; i < grid.length; i++) {
+        grid[i] = isTarget(i) ? 0 : INF;
+    }
+    const n = Math.max(width, height);
+    const f = new Float64Array(n), d = new Float64Array(n), v = new Int32Array(n), z = new Float64Array(n + 1);
+    for (let x = 0; x < width; x++) {
+        for (let y = 0; y < height; y++) {
+            f[y] = grid[y * width + x];
         }
-        // console.log(`[WebGPU Worker] Dense terrain: ${totalGridPoints} grid cells, ${validCount} with geometry (${(validCount/totalGridPoints*100).toFixed(1)}% coverage)`);
-    } else {
-        // Tool: Sparse output (X,Y,Z triplets), compact to remove invalid points
-        const validPoints = [];
-        for (let i = 0; i < totalGridPoints; i++) {
-            if (validMaskData[i] === 1) {
-                validPoints.push(
-                    outputData[i * 3],
-                    outputData[i * 3 + 1],
-                    outputData[i * 3 + 2]
-                );
+        squaredDistance1D(f, height, d, v, z);
+        for (let y = 0; y < height; y++) {
+            grid[y * width + x] = d[y];
+        }
+    }
+    for (let y = 0; y < height; y++) {
+        const row = y * width;
+        for (let x = 0; x < width; x++) {
+            f[x] = grid[row + x];
+        }
+        squaredDistance1D(f, width, d, v, z);
+        for (let x = 0; x < width; x++) {
+            grid[row + x] = d[x];
+        }
+    }
+    return grid;
+}
+
+// Signed distance (cells) to the part outline: positive inside the part, negative outside, zero halfway
+// between a part cell and an empty one. The grid is padded by pad empty cells on every side, so every
+// iso-contour above 0.5 - pad closes. Returns Float32Array((width + 2 pad) x (height + 2 pad))
+function partOutlineDistance(partMask, width, height, pad) {
+    const paddedWidth = width + 2 * pad;
+    const paddedHeight = height + 2 * pad;
+    const inside = new Uint8Array(paddedWidth * paddedHeight);
+    for (let y = 0; y < height; y++) {
+        inside.set(partMask.subarray(y * width, (y + 1) * width), (y + pad) * paddedWidth + pad);
+    }
+    const toOutside = squaredDistanceTransform(paddedWidth, paddedHeight, i => inside[i] === 0);
+    const toInside = squaredDistanceTransform(paddedWidth, paddedHeight, i => inside[i] === 1);
+    const field = new Float32Array(paddedWidth * paddedHeight);
+    for (let i = 0; i < field.length; i++) {
+        field[i] = inside[i] ? Math.sqrt(toOutside[i]) - 0.5 : 0.5 - Math.sqrt(toInside[i]);
+    }
+    return field;
+}
+
+// Closed iso-contours of field at level, as flat [x, y, ...] loops in field cells (not repeating the first
+// point). Loops keep field > level on their left: outer boundaries run counter-clockwise, holes clockwise.
+function traceContourLoops(field, width, height, level) {
+    // Crossing point of edge id: 2 (y width + x) for the edge from (x, y) to (x + 1, y), + 1 for (x, y + 1)
+    const edgePoint = (edge) => {
+        const cell = edge >> 1;
+        const x = cell % width, y = (cell - x) / width;
+        const a = field[cell];
+        const b = (edge & 1) ? field[cell + width] : field[cell + 1];
+        const t = (level - a) / (b - a);
+        return (edge & 1) ? [x, y + t] : [x + t, y];
+    };
+
+    // Each crossed edge starts one directed segment and ends another
+    const next = new Map();
+    for (let y = 0; y + 1 < height; y++) {
+        for (let x = 0; x + 1 < width; x++) {
+            const i = y * width + x;
+            // Corners and the edges leaving them, counter-clockwise from (x, y)
+            const corners = [field[i], field[i + 1], field[i + width + 1], field[i + width]];
+            const edges = [2 * i, 2 * (i + 1) + 1, 2 * (i + width), 2 * i + 1];
+            const crossings = [];
+            for (let c = 0; c < 4; c++) {
+                const from = corners[c] > level, to = corners[(c + 1) & 3] > level;
+                if (from !== to) {
+                    crossings.push({ edge: edges[c], leaving: from });
+                }
+            }
+            if (crossings.length === 0) {
+                continue;
+            }
+            // A segment runs from where the boundary walk leaves the inside to where it re-enters. In a saddle
+            // the cell center decides whether the inside corners connect (pair with the next crossing) or not.
+            const centerInside = (corners[0] + corners[1] + corners[2] + corners[3]) / 4 > level;
+            for (let c = 0; c < crossings.length; c++) {
+                if (!crossings[c].leaving) {
+                    continue;
+                }
+                const partner = crossings.length === 4 && centerInside
+                    ? crossings[(c + 1) % 4]
+                    : crossings[(c + crossings.length - 1) % crossings.length];
+                next.set(crossings[c].edge, partner.edge);
             }
         }
-        result = new Float32Array(validPoints);
-        pointCount = validPoints.length / 3;
     }
 
-    stagingOutputBuffer.unmap();
-    stagingValidMaskBuffer.unmap();
+    const loops = [];
+    for (const start of next.keys()) {
+        if (!next.has(start)) {
+            continue;
+        }
+        const loop = [];
+        let edge = start;
+        do {
+            loop.push(...edgePoint(edge));
+            const following = next.get(edge);
+            next.delete(edge);
+            edge = following;
+        } while (edge !== start && edge !== undefined);
+        loops.push(loop);
+    }
+    return loops;
+}
 
-    // Cleanup
-    triangleBuffer.destroy();
-    outputBuffer.destroy();
-    validMaskBuffer.destroy();
-    uniformBuffer.destroy();
-    spatialCellOffsetsBuffer.destroy();
-    spatialTriangleIndicesBuffer.destroy();
-    stagingOutputBuffer.destroy();
-    stagingValidMaskBuffer.destroy();
+// Resample a closed loop every spacing along its length from vertex first, ending back on it
+function resampleLoop(loop, first, spacing) {
+    const n = loop.length / 2;
+    const xs = new Float64Array(n + 1), ys = new Float64Array(n + 1), lengths = new Float64Array(n + 1);
+    for (let k = 0; k <= n; k++) {
+        const j = ((first + k) % n) * 2;
+        xs[k] = loop[j];
+        ys[k] = loop[j + 1];
+        lengths[k] = k === 0 ? 0 : lengths[k - 1] + Math.hypot(xs[k] - xs[k - 1], ys[k] - ys[k - 1]);
+    }
+    const count = Math.max(1, Math.ceil(lengths[n] / spacing));
+    const out = new Float64Array((count + 1) * 2);
+    let k = 0;
+    for (let i = 0; i <= count; i++) {
+        const target = lengths[n] * i / count;
+        while (k + 1 < n && lengths[k + 1] < target) {
+            k++;
+        }
+        const span = lengths[k + 1] - lengths[k];
+        const t = span > 0 ? Math.min(1, (target - lengths[k]) / span) : 0;
+        out[i * 2] = xs[k] + (xs[k + 1] - xs[k]) * t;
+        out[i * 2 + 1] = ys[k] + (ys[k + 1] - ys[k]) * t;
+    }
+    return out;
+}
 
-    const endTime = performance.now();
-    const conversionTime = endTime - startTime;
-    // console.log(`[WebGPU Worker] ✅ Rasterize complete: ${pointCount} points in ${conversionTime.toFixed(1)}ms`);
-    // console.log(`[WebGPU Worker] Bounds: min(${bounds.min.x.toFixed(2)}, ${bounds.min.y.toFixed(2)}, ${bounds.min.z.toFixed(2)}) max(${bounds.max.x.toFixed(2)}, ${bounds.max.y.toFixed(2)}, ${bounds.max.z.toFixed(2)})`);
+// Offset loops of the part outline, offset + k stepover inside it (negative offsets start outside),
+// outermost first. Each loop starts at its vertex closest to the end of the previous one.
+// Returns [Float64Array of grid XY, closing back on the first sample]
+function partContourLoops(terrain, offset, stepover, spacing) {
+    const { partMask, width, height, gridStep } = terrain;
+    const firstLevel = offset / gridStep;
+    const pad = Math.max(1, Math.ceil(0.5 - firstLevel) + 1);
+    const paddedWidth = width + 2 * pad;
+    const paddedHeight = height + 2 * pad;
+    const field = partOutlineDistance(partMask, width, height, pad);
+    let maxLevel = -Infinity;
+    for (let i = 0; i < field.length; i++) {
+        maxLevel = Math.max(maxLevel, field[i]);
+    }
 
-    // Verify result data integrity
-    if (filterMode === 0) {
-        // Terrain: Dense Z-only format
-        if (result.length > 0) {
-            const EMPTY_CELL = -1e10;
-            const firstZ = result[0] <= EMPTY_CELL + 1 ? 'EMPTY' : result[0].toFixed(3);
-            const lastZ = result[result.length-1] <= EMPTY_CELL + 1 ? 'EMPTY' : result[result.length-1].toFixed(3);
-            // console.log(`[WebGPU Worker] First Z: ${firstZ}, Last Z: ${lastZ}`);
+    const contours = [];
+    let lastX = 0, lastY = 0;
+    for (let k = 0; firstLevel + k * stepover / gridStep < maxLevel; k++) {
+        const level = firstLevel + k * stepover / gridStep;
+        for (const loop of traceContourLoops(field, paddedWidth, paddedHeight, level)) {
+            let first = 0, closest = Infinity;
+            for (let j = 0; j < loop.length; j += 2) {
+                const d = (loop[j] - pad - lastX) ** 2 + (loop[j + 1] - pad - lastY) ** 2;
+                if (d < closest) {
+                    closest = d;
+                    first = j / 2;
+                }
+            }
+            const samples = resampleLoop(loop, first, spacing / gridStep);
+            for (let j = 0; j < samples.length; j++) {
+                samples[j] -= pad;
+            }
+            lastX = samples[samples.length - 2];
+            lastY = samples[samples.length - 1];
+            contours.push(samples);
+        }
+    }
+    return contours;
+}
+
+// Spiral, rectangular pocket and contour toolpaths over the resident terrain
+// Spiral and pocket positions are generated on the GPU in cut order; contour loops are traced on the CPU.
+// Either way all samples are evaluated with the drop-cutter query kernel in one dispatch, so no
+// rectangular grid is computed or reordered. All lengths are in mm.
+// { type: 'spiral', pitch, spacing, center, radius } - Archimedean spiral outwards from center (default:
+//   terrain center) to radius (default: the farthest terrain corner), pitch apart between turns
+// { type: 'pocket', stepover, spacing, rect } - closed rectangular loops from rect (default: terrain
+//   bounds) inwards, stepover apart. These are insets of the rectangle, not offsets of the part outline.
+// { type: 'contour', stepover, spacing, offset } - closed offset loops of the part outline (the edge of
+//   the non-empty terrain cells), offset (default 0) inside it and then every stepover further in.
+//   A negative offset starts outside the part. Outer boundaries run counter-clockwise, holes clockwise.
+// Returns { polylines: [Float32Array of world XYZ], pointCount, generationTime }
+async function generatePatternToolpath(pattern, toolPoints, oobZ) {
+    if (!residentTerrain) {
+        throw new Error('No terrain. Call loadTerrain first.');
+    }
+    const startTime = performance.now();
+    const terrain = residentTerrain;
+    const gridStep = terrain.gridStep;
+    const maxX = (terrain.width - 1) * gridStep;
+    const maxY = (terrain.height - 1) * gridStep;
+    const spacing = pattern.spacing ?? gridStep;
+    if (!(spacing > 0)) {
+        throw new Error('Pattern spacing must be positive');
+    }
+
+    let mode, count, loopStarts = null, patternUniforms = null, contourXY = null;
+    if (pattern.type === 'spiral') {
+        if (!(pattern.pitch > 0)) {
+            throw new Error('Spiral pitch must be positive');
+        }
+        const cx = pattern.center ? pattern.center.x - terrain.minX : maxX / 2;
+        const cy = pattern.center ? pattern.center.y - terrain.minY : maxY / 2;
+        const radius = pattern.radius ?? Math.max(Math.hypot(cx, cy), Math.hypot(maxX - cx, cy), Math.hypot(cx, maxY - cy), Math.hypot(maxX - cx, maxY - cy));
+        const a = pattern.pitch / (2 * Math.PI);
+        const thetaMax = radius / a;
+        const totalLength = 0.5 * a * (thetaMax * Math.sqrt(1 + thetaMax * thetaMax) + Math.asinh(thetaMax));
+        mode = 1;
+        count = Math.floor(totalLength / spacing) + 1;
+        patternUniforms = [cx / gridStep, cy / gridStep, spacing / gridStep, a / gridStep];
+    } else if (pattern.type === 'pocket') {
+        if (!(pattern.stepover > 0)) {
+            throw new Error('Pocket stepover must be positive');
+        }
+        const rect = pattern.rect || { min: { x: terrain.minX, y: terrain.minY }, max: { x: terrain.minX + maxX, y: terrain.minY + maxY } };
+        const width = rect.max.x - rect.min.x;
+        const height = rect.max.y - rect.min.y;
+        const starts = [0];
+        for (let j = 0; width - 2 * j * pattern.stepover >= 0 && height - 2 * j * pattern.stepover >= 0; j++) {
+            const perimeter = 2 * (width + height - 4 * j * pattern.stepover);
+            starts.push(starts[j] + (perimeter > 0 ? Math.ceil(perimeter / spacing) + 1 : 1));
+        }
+        mode = 2;
+        loopStarts = new Uint32Array(starts);
+        count = starts[starts.length - 1];
+        patternUniforms = [
+            0, 0, spacing / gridStep, 0,
+            (rect.min.x - terrain.minX) / gridStep, (rect.min.y - terrain.minY) / gridStep,
+            (rect.max.x - terrain.minX) / gridStep, (rect.max.y - terrain.minY) / gridStep,
+            pattern.stepover / gridStep
+        ];
+    } else if (pattern.type === 'contour') {
+        if (!(pattern.stepover > 0)) {
+            throw new Error('Contour stepover must be positive');
         }
+        const loops = partContourLoops(terrain, pattern.offset ?? 0, pattern.stepover, spacing);
+        const starts = [0];
+        for (const loop of loops) {
+            starts.push(starts[starts.length - 1] + loop.length / 2);
+        }
+        mode = 0;
+        loopStarts = new Uint32Array(starts);
+        count = starts[starts.length - 1];
+        contourXY = new Float32Array(count * 2);
+        let o = 0;
+        for (const loop of loops) {
+            for (let j = 0; j < loop.length; j += 2) {
+                contourXY[o++] = terrain.minX + loop[j] * gridStep;
+                contourXY[o++] = terrain.minY + loop[j + 1] * gridStep;
+            }
+        }
+    } else {
+        throw new Error(`Unknown pattern type: ${pattern.type}`);
+    }
+
+    ensureQueryTool(terrain, toolPoints);
+    let toWorld;
+    if (contourXY) {
+        // Contour XY is already world space; the kernel only adds Z
+        const z = await dispatchToolQuery(terrain, oobZ, count, 1, 0, worldToQueryGrid(terrain, contourXY));
+        toWorld = (start, end) => {
+            const xyz = new Float32Array((end - start) * 3);
+            for (let i = start; i < end; i++) {
+                const o = (i - start) * 3;
+                xyz[o] = contourXY[i * 2];
+                xyz[o + 1] = contourXY[i * 2 + 1];
+                xyz[o + 2] = z[i];
+            }
+            return xyz;
+        };
     } else {
-        // Tool: Sparse X,Y,Z format
-        if (result.length > 0) {
-            const firstPoint = `(${result[0].toFixed(3)}, ${result[1].toFixed(3)}, ${result[2].toFixed(3)})`;
-            const lastIdx = result.length - 3;
-            const lastPoint = `(${result[lastIdx].toFixed(3)}, ${result[lastIdx+1].toFixed(3)}, ${result[lastIdx+2].toFixed(3)})`;
-            // console.log(`[WebGPU Worker] First point: ${firstPoint}, Last point: ${lastPoint}`);
+        const samples = await dispatchToolQuery(terrain, oobZ, count, 3, mode, null, patternUniforms, loopStarts);
+
+        // Grid XY back to world; one polyline for the spiral, one per pocket loop
+        toWorld = (start, end) => {
+            const xyz = new Float32Array((end - start) * 3);
+            for (let i = start; i < end; i++) {
+                const o = (i - start) * 3;
+                xyz[o] = terrain.minX + samples[i * 3] * gridStep;
+                xyz[o + 1] = terrain.minY + samples[i * 3 + 1] * gridStep;
+                xyz[o + 2] = samples[i * 3 + 2];
+            }
+            return xyz;
+        };
+    }
+    const polylines = [];
+    if (loopStarts) {
+        for (let j = 0; j + 1 < loopStarts.length; j++) {
+            polylines.push(toWorld(loopStarts[j], loopStarts[j + 1]));
         }
+    } else {
+        polylines.push(toWorld(0, count));
     }
 
-    return {
-        positions: result,
-        pointCount: pointCount,
-        bounds: bounds,
-        conversionTime: conversionTime,
-        gridWidth: gridWidth,
-        gridHeight: gridHeight,
-        isDense: filterMode === 0  // True for terrain (dense), false for tool (sparse)
-    };
+    const generationTime = performance.now() - startTime;
+    console.log(`[WebGPU Worker] ✅ ${pattern.type} toolpath: ${count} samples in ${polylines.length} polyline(s) in ${generationTime.toFixed(1)}ms`);
+    return { polylines, pointCount: count, generationTime };
 }
 
-// Create tiles for tiled rasterization
-function createTiles(bounds, stepSize, maxMemoryBytes) {
-    const width = bounds.max.x - bounds.min.x;
-    const height = bounds.max.y - bounds.min.y;
-    const aspectRatio = width / height;
+function disposeTerrain() {
+    if (residentTerrain) {
+        residentTerrain.terrainBuffer.destroy();
+        residentTerrain.uniformBuffer.destroy();
+        if (residentTerrain.toolBuffer) {
+            residentTerrain.toolBuffer.destroy();
+        }
+        if (residentTerrain.queryBuffer) {
+            residentTerrain.queryBuffer.destroy();
+            residentTerrain.outputBuffer.destroy();
+        }
+        residentTerrain = null;
+    }
+}
 
-    // Calculate how many grid points we can fit in one tile
-    // Terrain uses dense Z-only format: (gridW * gridH * 1 * 4) for output
-    // This is 4x more efficient than the old sparse format (16 bytes → 4 bytes per point)
-    const bytesPerPoint = 1 * 4; // 4 bytes per grid point (Z-only)
-    const maxPointsPerTile = Math.floor(maxMemoryBytes / bytesPerPoint);
-    console.log(`[WebGPU Worker] Dense terrain format: ${bytesPerPoint} bytes/point (was 16), can fit ${(maxPointsPerTile/1e6).toFixed(1)}M points per tile`);
+// Rest machining (planar): generate a toolpath for a new tool that only covers material left behind
+// by earlier operations. The remaining stock is either the resident stock (useStock) or built here by
+// sweeping the previous tool along its dense toolpath over the terrain grid; cells the previous tool
+// never reached count as uncut. Each tile is masked and simplified on the GPU, so only the kept
+// polylines are read back.
+// rest: { previous: {pathData, numScanlines, pointsPerLine, toolPositions, xStep, yStep}, useStock, threshold }
+// Returns { vertices, lineOffsets, vertexCount, numScanlines, pointsPerLine, generationTime } with NaN
+// vertices marking where the tool lifts out between rest regions
+async function generateRestToolpath(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds, rest, simplifyTolerance = 0) {
+    const startTime = performance.now();
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
+    const { previous = null, useStock = false, threshold = 0.01 } = rest;
 
-    // Calculate optimal tile grid dimensions while respecting aspect ratio
-    // We want: tileGridW * tileGridH <= maxPointsPerTile
-    // And: tileGridW / tileGridH ≈ aspectRatio
+    const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
+    const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+    const pointsPerLine = Math.ceil(terrainMapData.width / xStep);
+    const numScanlines = Math.ceil(terrainMapData.height / yStep);
 
-    let tileGridW, tileGridH;
-    if (aspectRatio >= 1) {
-        // Width >= Height
-        tileGridH = Math.floor(Math.sqrt(maxPointsPerTile / aspectRatio));
-        tileGridW = Math.floor(tileGridH * aspectRatio);
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+
+    let remaining;
+    let ownsRemaining = false;
+    if (useStock) {
+        if (!residentStock) {
+            throw new Error('No stock. Call createStock first.');
+        }
+        // Stock cells are addressed with the toolpath's grid step
+        if (residentStock.gridStep !== gridStep) {
+            throw new Error(`Rest machining grid step ${gridStep} does not match the stock grid step ${residentStock.gridStep}`);
+        }
+        remaining = {
+            ...residentStock,
+            originX: Math.round((terrainBounds.min.x - residentStock.minX) / gridStep),
+            originY: Math.round((terrainBounds.min.y - residentStock.minY) / gridStep)
+        };
+    } else if (previous) {
+        const width = terrainMapData.width;
+        const height = terrainMapData.height;
+        if (width * height * 4 > deviceLimit) {
+            throw new Error(`Rest machining stock too large: ${width}x${height} cells. Try a larger grid step.`);
+        }
+        remaining = {
+            width,
+            height,
+            originX: 0,
+            originY: 0,
+            stockBuffer: device.createBuffer({
+                size: width * height * 4,
+                usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+            }),
+            dirtyBuffer: device.createBuffer({
+                size: Math.ceil(height / STOCK_BAND_ROWS) * 4,
+                usage: GPUBufferUsage.STORAGE,
+            })
+        };
+        ownsRemaining = true;
+        device.queue.writeBuffer(remaining.stockBuffer, 0, new Float32Array(width * height).fill(3.402823466e+38));
+        sweepToolIntoStock(
+            remaining, previous.pathData, previous.numScanlines, previous.pointsPerLine,
+            createSparseToolFromPoints(previous.toolPositions, gridStep), previous.xStep, previous.yStep, 0, 0
+        );
     } else {
-        // Height > Width
-        tileGridW = Math.floor(Math.sqrt(maxPointsPerTile * aspectRatio));
-        tileGridH = Math.floor(tileGridW / aspectRatio);
+        throw new Error('Rest machining needs a previous toolpath or useStock');
     }
 
-    // Ensure we don't exceed limits
-    while (tileGridW * tileGridH * bytesPerPoint > maxMemoryBytes) {
-        if (tileGridW > tileGridH) {
-            tileGridW--;
-        } else {
-            tileGridH--;
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    const tiles = planToolpathTiles(terrainMapData, sparseToolData, xStep, yStep, maxSafeSize);
+    const parts = new Array(tiles.length);
+
+    const tileJob = await beginToolpathTiles({
+        terrainMapData, sparseToolData, xStep, yStep, oobZ, tiles,
+        consumeTile: async (commandEncoder, outputBuffer, tile, tileIndex) => {
+            const sampleCount = tile.pointsPerLine * tile.numScanlines;
+            const totalWorkgroups = Math.ceil(sampleCount / 64);
+            const workgroupsX = Math.min(totalWorkgroups, maxWorkgroupsPerDim);
+            const workgroupsY = Math.ceil(totalWorkgroups / workgroupsX);
+
+            const uniformData = new Uint32Array([
+                remaining.width, remaining.height, sparseToolData.count, xStep,
+                yStep, tile.pointsPerLine, tile.numScanlines, tile.sampleOriginY,
+                0, 0, 0, workgroupsX * 64
+            ]);
+            const uniformDataI32 = new Int32Array(uniformData.buffer);
+            uniformDataI32[8] = remaining.originX;
+            uniformDataI32[9] = remaining.originY;
+            new Float32Array(uniformData.buffer)[10] = threshold;
+            const uniformBuffer = device.createBuffer({
+                size: uniformData.byteLength,
+                usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+            });
+            device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+            const bindGroup = device.createBindGroup({
+                layout: cachedToolpathRestPipeline.getBindGroupLayout(0),
+                entries: [
+                    { binding: 0, resource: { buffer: outputBuffer } },
+                    { binding: 1, resource: { buffer: remaining.stockBuffer } },
+                    { binding: 2, resource: { buffer: tileJob.toolBuffer } },
+                    { binding: 3, resource: { buffer: uniformBuffer } },
+                ],
+            });
+            const passEncoder = commandEncoder.beginComputePass();
+            passEncoder.setPipeline(cachedToolpathRestPipeline);
+            passEncoder.setBindGroup(0, bindGroup);
+            passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
+            passEncoder.end();
+
+            parts[tileIndex] = await simplifyToolpathOnGPU(
+                commandEncoder, outputBuffer, tile.pointsPerLine, tile.numScanlines, simplifyTolerance
+            );
+            uniformBuffer.destroy();
+        }
+    });
+    try {
+        for (let t = 0; t < tiles.length; t++) {
+            await runToolpathTile(tileJob, t);
+        }
+    } finally {
+        endToolpathTiles(tileJob);
+        if (ownsRemaining) {
+            remaining.stockBuffer.destroy();
+            remaining.dirtyBuffer.destroy();
         }
     }
 
-    // Convert grid dimensions to world dimensions
-    const tileWidth = tileGridW * stepSize;
-    const tileHeight = tileGridH * stepSize;
+    const result = concatSimplifiedToolpaths(parts);
+    const generationTime = performance.now() - startTime;
+    console.log(`[WebGPU Worker] ✅ Rest toolpath: ${result.vertexCount} vertices over ${numScanlines}×${pointsPerLine} in ${generationTime.toFixed(1)}ms`);
 
-    // Calculate number of tiles needed
-    const tilesX = Math.ceil(width / tileWidth);
-    const tilesY = Math.ceil(height / tileHeight);
+    return {
+        ...result,
+        numScanlines,
+        pointsPerLine,
+        generationTime
+    };
+}
 
-    // Calculate actual tile dimensions (distribute evenly)
-    const actualTileWidth = width / tilesX;
-    const actualTileHeight = height / tilesY;
+// Rasterize terrain and generate its toolpath in one submission (public API)
+// The rasterize output buffer is bound directly as terrain_map, so the heightmap never leaves
+// the GPU unless options.returnHeightmap is set. Only the toolpath is read back.
+async function generateToolpathFromMesh(triangles, toolPoints, xStep, yStep, oobZ, gridStep, options = {}) {
+    const startTime = performance.now();
+    const { returnHeightmap = false } = options;
 
-    console.log(`[WebGPU Worker] Creating ${tilesX}x${tilesY} = ${tilesX * tilesY} tiles (${actualTileWidth.toFixed(2)}mm × ${actualTileHeight.toFixed(2)}mm each)`);
-    console.log(`[WebGPU Worker] Tile grid: ${Math.ceil(actualTileWidth / stepSize)}x${Math.ceil(actualTileHeight / stepSize)} points per tile`);
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
+    }
 
-    const tiles = [];
-    const overlap = stepSize * 2; // Overlap by 2 grid cells to ensure no gaps
+    const bounds = options.terrainBounds || calculateBounds(triangles);
+    if (bounds.min.x >= bounds.max.x || bounds.min.y >= bounds.max.y || bounds.min.z >= bounds.max.z) {
+        throw new Error(`Invalid bounds: min must be less than max. Got min(${bounds.min.x}, ${bounds.min.y}, ${bounds.min.z}) max(${bounds.max.x}, ${bounds.max.y}, ${bounds.max.z})`);
+    }
 
-    for (let ty = 0; ty < tilesY; ty++) {
-        for (let tx = 0; tx < tilesX; tx++) {
-            // Calculate base tile bounds (no overlap)
-            let tileMinX = bounds.min.x + (tx * actualTileWidth);
-            let tileMinY = bounds.min.y + (ty * actualTileHeight);
-            let tileMaxX = Math.min(bounds.max.x, tileMinX + actualTileWidth);
-            let tileMaxY = Math.min(bounds.max.y, tileMinY + actualTileHeight);
+    const gridWidth = Math.ceil((bounds.max.x - bounds.min.x) / gridStep) + 1;
+    const gridHeight = Math.ceil((bounds.max.y - bounds.min.y) / gridStep) + 1;
+    const outputMemory = Math.ceil(gridWidth / xStep) * Math.ceil(gridHeight / yStep) * 4;
 
-            // Add overlap (except at outer edges) - but DON'T extend beyond global bounds
-            if (tx > 0) tileMinX = Math.max(bounds.min.x, tileMinX - overlap);
-            if (ty > 0) tileMinY = Math.max(bounds.min.y, tileMinY - overlap);
-            if (tx < tilesX - 1) tileMaxX = Math.min(bounds.max.x, tileMaxX + overlap);
-            if (ty < tilesY - 1) tileMaxY = Math.min(bounds.max.y, tileMaxY + overlap);
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
 
-            tiles.push({
-                id: `tile_${tx}_${ty}`,
-                bounds: {
-                    min: { x: tileMinX, y: tileMinY, z: bounds.min.z },
-                    max: { x: tileMaxX, y: tileMaxY, z: bounds.max.z }
-                }
-            });
+    if (shouldUseTiling(bounds, gridStep) || outputMemory > maxSafeSize) {
+        // Too large for a single resident heightmap: tile in the worker, still without a main-thread round trip
+        console.log('[WebGPU Worker] Fused toolpath too large for one pass - using tiled rasterize + toolpath');
+        const terrain = await rasterizeMesh(triangles, gridStep, 0, { ...bounds });
+        const result = await generateToolpath(terrain.positions, toolPoints, xStep, yStep, oobZ, gridStep, terrain.bounds);
+        result.generationTime = performance.now() - startTime;
+        if (returnHeightmap) {
+            result.terrain = terrain;
         }
+        return result;
     }
 
-    return { tiles, tilesX, tilesY };
-}
+    const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
+    const mesh = uploadMesh(triangles, bounds);
+    const toolBuffer = uploadSparseTool(sparseToolData);
 
-// Stitch tiles from multiple rasterization passes
-function stitchTiles(tileResults, fullBounds, stepSize) {
-    if (tileResults.length === 0) {
-        throw new Error('No tile results to stitch');
-    }
+    const commandEncoder = device.createCommandEncoder();
+    const raster = encodeRasterizePass(commandEncoder, mesh, gridStep, 0, bounds);
+    const toolpath = encodeToolpathPass(
+        commandEncoder, raster.outputBuffer, raster.gridWidth, raster.gridHeight,
+        toolBuffer, sparseToolData.count, xStep, yStep, oobZ
+    );
+    const { pointsPerLine, numScanlines } = toolpath;
 
-    // Check if results are dense (terrain) or sparse (tool)
-    const isDense = tileResults[0].isDense;
+    const pathStaging = encodeReadback(commandEncoder, toolpath.outputBuffer, pointsPerLine * numScanlines * 4);
+    const terrainStaging = returnHeightmap
+        ? encodeReadback(commandEncoder, raster.outputBuffer, raster.gridWidth * raster.gridHeight * 4)
+        : null;
 
-    if (isDense) {
-        // DENSE TERRAIN STITCHING: Simple array copying (Z-only format)
-        console.log(`[WebGPU Worker] Stitching ${tileResults.length} dense terrain tiles...`);
+    device.queue.submit([commandEncoder.finish()]);
 
-        // Calculate global grid dimensions
-        const globalWidth = Math.ceil((fullBounds.max.x - fullBounds.min.x) / stepSize) + 1;
-        const globalHeight = Math.ceil((fullBounds.max.y - fullBounds.min.y) / stepSize) + 1;
-        const totalGridCells = globalWidth * globalHeight;
+    const pathData = await readStagingFloat32(pathStaging);
+    const terrainData = terrainStaging ? await readStagingFloat32(terrainStaging) : null;
 
-        // Allocate global dense grid (Z-only), initialize to sentinel value
-        const EMPTY_CELL = -1e10;
-        const globalGrid = new Float32Array(totalGridCells);
-        globalGrid.fill(EMPTY_CELL);
+    mesh.destroy();
+    toolBuffer.destroy();
+    raster.outputBuffer.destroy();
+    raster.validMaskBuffer.destroy();
+    toolpath.outputBuffer.destroy();
+    [...raster.transientBuffers, ...toolpath.transientBuffers].forEach(buffer => buffer.destroy());
 
-        console.log(`[WebGPU Worker] Global grid: ${globalWidth}x${globalHeight} = ${totalGridCells.toLocaleString()} cells`);
+    const endTime = performance.now();
+    console.log(`[WebGPU Worker] ✅ Fused toolpath complete: ${numScanlines}×${pointsPerLine} from ${raster.gridWidth}x${raster.gridHeight} terrain in ${(endTime - startTime).toFixed(1)}ms`);
 
-        // Copy each tile's Z-values to the correct position in global grid
-        for (const tile of tileResults) {
-            // Calculate tile's position in global grid
-            const tileOffsetX = Math.round((tile.tileBounds.min.x - fullBounds.min.x) / stepSize);
-            const tileOffsetY = Math.round((tile.tileBounds.min.y - fullBounds.min.y) / stepSize);
+    const result = {
+        pathData,
+        numScanlines,
+        pointsPerLine,
+        generationTime: endTime - startTime
+    };
 
-            const tileWidth = tile.gridWidth;
-            const tileHeight = tile.gridHeight;
+    if (terrainData) {
+        result.terrain = {
+            positions: terrainData,
+            pointCount: terrainData.length,
+            bounds,
+            gridWidth: raster.gridWidth,
+            gridHeight: raster.gridHeight,
+            isDense: true
+        };
+    }
 
-            // Copy Z-values row by row
-            for (let ty = 0; ty < tileHeight; ty++) {
-                const globalY = tileOffsetY + ty;
-                if (globalY >= globalHeight) continue;
+    return result;
+}
 
-                for (let tx = 0; tx < tileWidth; tx++) {
-                    const globalX = tileOffsetX + tx;
-                    if (globalX >= globalWidth) continue;
+function generateRadialScanline(data) {
+    const { stripPositions, stripBounds, toolPositions, xStep, zFloor, gridStep } = data;
+    const EMPTY_CELL = -1e10;
 
-                    const tileIdx = ty * tileWidth + tx;
-                    const globalIdx = globalY * globalWidth + globalX;
-                    const tileZ = tile.positions[tileIdx];
+    // console.log('[WebGPU Worker] Generating radial scanline...');
+    // console.log(`[WebGPU Worker] Strip: ${stripPositions.length} cells, Tool: ${toolPositions.length/3} points, xStep: ${xStep}`);
 
-                    // For overlapping cells, keep max Z (terrain surface)
-                    // Skip empty cells (sentinel value)
-                    if (tileZ > EMPTY_CELL + 1) {
-                        const existingZ = globalGrid[globalIdx];
-                        if (existingZ <= EMPTY_CELL + 1 || tileZ > existingZ) {
-                            globalGrid[globalIdx] = tileZ;
-                        }
-                    }
-                }
-            }
-        }
+    // Create height map from strip (dense Z-only format)
+    const stripMap = createHeightMapFromPoints(stripPositions, gridStep, stripBounds);
+    // console.log(`[WebGPU Worker] Strip map: ${stripMap.width}x${stripMap.height}`);
 
-        // Count valid cells (above sentinel value)
-        let validCount = 0;
-        for (let i = 0; i < totalGridCells; i++) {
-            if (globalGrid[i] > EMPTY_CELL + 1) validCount++;
-        }
+    // Create sparse tool representation
+    const sparseTool = createSparseToolFromPoints(toolPositions, gridStep);
+    // console.log(`[WebGPU Worker] Sparse tool: ${sparseTool.count} points`);
 
-        console.log(`[WebGPU Worker] ✅ Stitched: ${totalGridCells} total cells, ${validCount} with geometry (${(validCount/totalGridCells*100).toFixed(1)}% coverage)`);
+    // Find center row (y=0 in world space)
+    const centerY = Math.round((0 - stripMap.minY) / gridStep);
 
-        return {
-            positions: globalGrid,
-            pointCount: totalGridCells,
-            bounds: fullBounds,
-            gridWidth: globalWidth,
-            gridHeight: globalHeight,
-            isDense: true,
-            conversionTime: tileResults.reduce((sum, r) => sum + (r.conversionTime || 0), 0),
-            tileCount: tileResults.length
-        };
+    if (centerY < 0 || centerY >= stripMap.height) {
+        console.error(`[WebGPU Worker] Center row ${centerY} out of bounds [0, ${stripMap.height})`);
+        throw new Error('Center row out of strip bounds');
+    }
 
-    } else {
-        // SPARSE TOOL STITCHING: Keep existing deduplication logic (X,Y,Z triplets)
-        console.log(`[WebGPU Worker] Stitching ${tileResults.length} sparse tool tiles...`);
+    // console.log(`[WebGPU Worker] Center row: ${centerY} (y=0)`);
 
-        const pointMap = new Map();
+    // Calculate output dimensions
+    const outputWidth = Math.ceil(stripMap.width / xStep);
+    const scanline = new Float32Array(outputWidth);
 
-        for (const result of tileResults) {
-            const positions = result.positions;
+    // Process each output position along X-axis
+    for (let outX = 0; outX < outputWidth; outX++) {
+        const gridX = outX * xStep;
 
-            // Calculate offset from tile origin to global origin (in grid cells)
-            const tileOffsetX = Math.round((result.tileBounds.min.x - fullBounds.min.x) / stepSize);
-            const tileOffsetY = Math.round((result.tileBounds.min.y - fullBounds.min.y) / stepSize);
+        if (gridX >= stripMap.width) break;
 
-            // Convert each point from tile-local to global grid coordinates
-            for (let i = 0; i < positions.length; i += 3) {
-                const localGridX = positions[i];
-                const localGridY = positions[i + 1];
-                const z = positions[i + 2];
+        // Find maximum tool-terrain collision
+        // Note: Don't skip if center is empty - tool edges might still touch terrain
+        let maxZ = zFloor;
 
-                // Convert local grid indices to global grid indices
-                const globalGridX = localGridX + tileOffsetX;
-                const globalGridY = localGridY + tileOffsetY;
+        for (let i = 0; i < sparseTool.count; i++) {
+            const toolOffsetX = sparseTool.xOffsets[i];
+            const toolOffsetY = sparseTool.yOffsets[i];
+            const toolZ = sparseTool.zValues[i];
 
-                const key = `${globalGridX},${globalGridY}`;
-                const existing = pointMap.get(key);
+            // Calculate terrain lookup position
+            const terrainGridX = gridX + toolOffsetX;
+            const terrainGridY = centerY + toolOffsetY;
 
-                // Keep lowest Z value (for tool)
-                if (!existing || z < existing.z) {
-                    pointMap.set(key, { x: globalGridX, y: globalGridY, z });
-                }
+            // Check bounds
+            if (terrainGridX < 0 || terrainGridX >= stripMap.width ||
+                terrainGridY < 0 || terrainGridY >= stripMap.height) {
+                continue;
             }
-        }
 
-        // Convert Map to flat array
-        const finalPointCount = pointMap.size;
-        const allPositions = new Float32Array(finalPointCount * 3);
-        let writeOffset = 0;
+            // Get terrain height at this position
+            const idx = terrainGridY * stripMap.width + terrainGridX;
+            const terrainHeight = stripMap.grid[idx];
 
-        for (const point of pointMap.values()) {
-            allPositions[writeOffset++] = point.x;
-            allPositions[writeOffset++] = point.y;
-            allPositions[writeOffset++] = point.z;
-        }
+            if (terrainHeight === EMPTY_CELL) continue;
 
-        console.log(`[WebGPU Worker] ✅ Stitched: ${finalPointCount} unique sparse points`);
+            // Calculate tool center Z needed to just touch terrain
+            const toolCenterZ = terrainHeight - toolZ;
+            maxZ = Math.max(maxZ, toolCenterZ);
+        }
 
-        return {
-            positions: allPositions,
-            pointCount: finalPointCount,
-            bounds: fullBounds,
-            isDense: false,
-            conversionTime: tileResults.reduce((sum, r) => sum + (r.conversionTime || 0), 0),
-            tileCount: tileResults.length
-        };
+        scanline[outX] = maxZ;
     }
-}
 
-// Check if tiling is needed (only called for terrain, which uses dense format)
-function shouldUseTiling(bounds, stepSize) {
-    if (!config || !config.autoTiling) return false;
-    if (!deviceCapabilities) return false;
+    // console.log(`[WebGPU Worker] ✅ Radial scanline complete: ${outputWidth} points`);
+    // console.log(`[WebGPU Worker] First 10 values: ${Array.from(scanline.slice(0, 10)).map(v => v.toFixed(2)).join(',')}`);
 
-    const gridWidth = Math.ceil((bounds.max.x - bounds.min.x) / stepSize) + 1;
-    const gridHeight = Math.ceil((bounds.max.y - bounds.min.y) / stepSize) + 1;
-    const totalPoints = gridWidth * gridHeight;
+    return {
+        scanline
+    };
+}
 
-    // Terrain uses dense Z-only format: 1 float (4 bytes) per grid cell
-    const gpuOutputBuffer = totalPoints * 1 * 4;
-    const totalGPUMemory = gpuOutputBuffer;  // No mask needed for dense output
+// Strip rasterized at every radial angle: full X and Z, Y limited to the tool's reach around y = 0
+function radialStripBounds(terrainBounds, toolPositions, gridStep) {
+    let toolRadius = 0;
+    for (let i = 0; i < toolPositions.length; i += 3) {
+        toolRadius = Math.max(toolRadius, Math.abs(toolPositions[i + 1] * gridStep));
+    }
+    return {
+        min: { x: terrainBounds.min.x, y: -toolRadius, z: terrainBounds.min.z },
+        max: { x: terrainBounds.max.x, y: toolRadius, z: terrainBounds.max.z }
+    };
+}
 
-    // Use the smaller of configured limit or device capability
-    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
-    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
-    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+// Default rotation sector width for radial triangle binning
+const RADIAL_SECTOR_DEG = 1;
+
+// Spatial grid for radial jobs, binned by rotation sector as well as X
+// A triangle only reaches the strip |y'| <= reach for rotations that bring it near the Y = 0 plane:
+// with y' = r*cos(phi + theta), a point at radius r qualifies within asin(reach / r) of phi + theta = 90
+// or 270 degrees. Using the triangle's polar extent (closest radius, angular span) about the X axis gives
+// a conservative rotation interval pair, and each sector lists only the triangles whose intervals touch it.
+// Each sector holds one row of X cells (rotation moves triangles in Y, never in X); its cell offsets start
+// at a multiple of sectorStride so a rasterize pass can bind just that sector.
+function buildRadialSectorGrid(triangles, stripBounds, gridStep, sectorDeg, cellSize = 5.0) {
+    const sectorCount = Math.max(1, Math.ceil(360 / sectorDeg));
+    const sectorSize = 360 / sectorCount;
+    const gridWidth = Math.max(1, Math.ceil((stripBounds.max.x - stripBounds.min.x) / cellSize));
+    const offsetAlignment = (device.limits.minStorageBufferOffsetAlignment || 256) / 4;
+    const sectorStride = Math.ceil((gridWidth + 1) / offsetAlignment) * offsetAlignment;
+    const triangleCount = triangles.length / 9;
+    const toDeg = 180 / Math.PI;
 
-    return totalGPUMemory > maxSafeSize;
-}
+    // Raster rows reach up to one grid step past the strip bounds
+    const reach = Math.max(Math.abs(stripBounds.min.y), Math.abs(stripBounds.max.y)) + gridStep;
 
-// Rasterize mesh - wrapper that handles automatic tiling if needed
-async function rasterizeMesh(triangles, stepSize, filterMode, options = {}) {
-    const boundsOverride = options.bounds || options.min ? options : null;  // Support old and new format
-    const bounds = boundsOverride || calculateBounds(triangles);
+    const sectorStamp = new Uint32Array(sectorCount);
+    const sectorList = new Int32Array(sectorCount);
 
-    // Check if tiling is needed
-    if (shouldUseTiling(bounds, stepSize)) {
-        console.log('[WebGPU Worker] Tiling required - switching to tiled rasterization');
+    // Fills sectorList with the distinct sectors triangle t can reach; returns how many
+    const triangleSectors = (t) => {
+        const base = t * 9;
+        const y0 = triangles[base + 1], z0 = triangles[base + 2];
+        const y1 = triangles[base + 4], z1 = triangles[base + 5];
+        const y2 = triangles[base + 7], z2 = triangles[base + 8];
+
+        const rMin = distanceToTriangle2D(0, 0, y0, z0, y1, z1, y2, z2);
+        if (rMin <= reach) {
+            for (let i = 0; i < sectorCount; i++) sectorList[i] = i;
+            return sectorCount;
+        }
 
-        // Calculate max safe size per tile
-        const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
-        const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
-        const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+        const span = triangleAngularSpan(y0, z0, y1, z1, y2, z2);
+        const alpha = Math.asin(reach / rMin) * toDeg;
+        const start = 90 - span.end - alpha;
+        const end = 90 - span.start + alpha;
+        if (end - start >= 180) {
+            for (let i = 0; i < sectorCount; i++) sectorList[i] = i;
+            return sectorCount;
+        }
 
-        // Create tiles
-        const { tiles } = createTiles(bounds, stepSize, maxSafeSize);
+        let count = 0;
+        for (const shift of [0, 180]) {
+            const first = Math.floor((start + shift) / sectorSize);
+            const last = Math.floor((end + shift) / sectorSize);
+            for (let k = first; k <= last; k++) {
+                const sector = ((k % sectorCount) + sectorCount) % sectorCount;
+                if (sectorStamp[sector] !== t + 1) {
+                    sectorStamp[sector] = t + 1;
+                    sectorList[count++] = sector;
+                }
+            }
+        }
+        return count;
+    };
 
-        // Rasterize each tile
-        const tileResults = [];
-        for (let i = 0; i < tiles.length; i++) {
-            const tileStart = performance.now();
-            console.log(`[WebGPU Worker] Processing tile ${i + 1}/${tiles.length}: ${tiles[i].id}`);
-            console.log(`[WebGPU Worker]   Tile bounds: min(${tiles[i].bounds.min.x.toFixed(2)}, ${tiles[i].bounds.min.y.toFixed(2)}) max(${tiles[i].bounds.max.x.toFixed(2)}, ${tiles[i].bounds.max.y.toFixed(2)})`);
+    const cellRange = (t) => {
+        const base = t * 9;
+        const minX = Math.min(triangles[base], triangles[base + 3], triangles[base + 6]);
+        const maxX = Math.max(triangles[base], triangles[base + 3], triangles[base + 6]);
+        const first = Math.max(0, Math.min(gridWidth - 1, Math.floor((minX - stripBounds.min.x) / cellSize)));
+        const last = Math.max(0, Math.min(gridWidth - 1, Math.floor((maxX - stripBounds.min.x) / cellSize)));
+        return [first, last];
+    };
 
-            const tileResult = await rasterizeMeshSingle(triangles, stepSize, filterMode, {
-                ...tiles[i].bounds,
-                rotationAngleDeg: options.rotationAngleDeg
-            });
+    // Pass 1: count references per (sector, cell)
+    const cellCounts = new Uint32Array(sectorCount * gridWidth);
+    const sectorTriangleCounts = new Uint32Array(sectorCount);
+    for (let t = 0; t < triangleCount; t++) {
+        const [first, last] = cellRange(t);
+        const count = triangleSectors(t);
+        for (let i = 0; i < count; i++) {
+            const row = sectorList[i] * gridWidth;
+            for (let c = first; c <= last; c++) cellCounts[row + c]++;
+            sectorTriangleCounts[sectorList[i]]++;
+        }
+    }
 
-            const tileTime = performance.now() - tileStart;
-            console.log(`[WebGPU Worker]   Tile ${i + 1} complete: ${tileResult.pointCount} points in ${tileTime.toFixed(1)}ms`);
+    // Offsets are global into triangleIndices; each sector's run starts at sector * sectorStride
+    const cellOffsets = new Uint32Array(sectorCount * sectorStride);
+    const cursor = new Uint32Array(sectorCount * gridWidth);
+    let total = 0;
+    for (let sector = 0; sector < sectorCount; sector++) {
+        for (let c = 0; c < gridWidth; c++) {
+            cellOffsets[sector * sectorStride + c] = total;
+            cursor[sector * gridWidth + c] = total;
+            total += cellCounts[sector * gridWidth + c];
+        }
+        cellOffsets[sector * sectorStride + gridWidth] = total;
+    }
 
-            // Store tile bounds with result for coordinate conversion during stitching
-            tileResult.tileBounds = tiles[i].bounds;
-            tileResults.push(tileResult);
+    // Pass 2: fill
+    sectorStamp.fill(0);
+    const triangleIndices = new Uint32Array(total);
+    for (let t = 0; t < triangleCount; t++) {
+        const [first, last] = cellRange(t);
+        const count = triangleSectors(t);
+        for (let i = 0; i < count; i++) {
+            const row = sectorList[i] * gridWidth;
+            for (let c = first; c <= last; c++) triangleIndices[cursor[row + c]++] = t;
         }
+    }
 
-        // Stitch tiles together (pass full bounds and step size for coordinate conversion)
-        return stitchTiles(tileResults, bounds, stepSize);
-    } else {
-        // Single-pass rasterization
-        return await rasterizeMeshSingle(triangles, stepSize, filterMode, options);
+    return {
+        cellOffsets,
+        triangleIndices,
+        gridWidth,
+        gridHeight: 1,
+        cellSize,
+        sectorCount,
+        sectorSize,
+        sectorStride,
+        sectorTriangleCounts
+    };
+}
+
+// Polar angle range {start, end} in degrees (end - start < 180) of a YZ triangle that does not contain the X axis
+function triangleAngularSpan(y0, z0, y1, z1, y2, z2) {
+    const toDeg = 180 / Math.PI;
+    const phi0 = Math.atan2(z0, y0) * toDeg;
+    const wrap = (d) => d - 360 * Math.round(d / 360);
+    const d1 = wrap(Math.atan2(z1, y1) * toDeg - phi0);
+    const d2 = wrap(Math.atan2(z2, y2) * toDeg - phi0);
+    return { start: phi0 + Math.min(0, d1, d2), end: phi0 + Math.max(0, d1, d2) };
+}
+
+// Distance from (px, py) to a 2D triangle (0 inside)
+function distanceToTriangle2D(px, py, ax, ay, bx, by, cx, cy) {
+    const side = (x0, y0, x1, y1) => (x1 - x0) * (py - y0) - (y1 - y0) * (px - x0);
+    const s0 = side(ax, ay, bx, by), s1 = side(bx, by, cx, cy), s2 = side(cx, cy, ax, ay);
+    if ((s0 >= 0 && s1 >= 0 && s2 >= 0) || (s0 <= 0 && s1 <= 0 && s2 <= 0)) {
+        return 0;
     }
+    const segment = (x0, y0, x1, y1) => {
+        const dx = x1 - x0, dy = y1 - y0;
+        const lenSq = dx * dx + dy * dy;
+        const t = lenSq > 0 ? Math.max(0, Math.min(1, ((px - x0) * dx + (py - y0) * dy) / lenSq)) : 0;
+        return Math.hypot(px - (x0 + t * dx), py - (y0 + t * dy));
+    };
+    return Math.min(segment(ax, ay, bx, by), segment(bx, by, cx, cy), segment(cx, cy, ax, ay));
 }
 
-// Helper: Create height map from dense terrain points (Z-only array)
-// Terrain is ALWAYS dense (Z-only), never sparse
-function createHeightMapFromPoints(points, gridStep, bounds = null) {
-    if (!points || points.length === 0) {
-        throw new Error('No points provided');
+// Radial job: the mesh (with its sector grid) and sparse tool stay on the GPU while angle lists are run against them
+// data: {triangles, toolPositions, xStep, zFloor, gridStep, terrainBounds, sectorDeg}
+async function beginRadialJob(data) {
+    const { triangles, toolPositions, xStep, zFloor, gridStep, terrainBounds } = data;
+
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
+        }
     }
 
-    // Calculate dimensions from bounds
-    if (!bounds) {
-        throw new Error('Bounds required for height map creation');
+    const stripBounds = radialStripBounds(terrainBounds, toolPositions, gridStep);
+
+    if (shouldUseTiling(stripBounds, gridStep)) {
+        // Strip too large for one pass: angles are rasterized tiled and collided on the CPU
+        return { triangles, toolPositions, xStep, zFloor, gridStep, stripBounds, tiled: true };
     }
 
-    const minX = bounds.min.x;
-    const minY = bounds.min.y;
-    const minZ = bounds.min.z;
-    const maxX = bounds.max.x;
-    const maxY = bounds.max.y;
-    const maxZ = bounds.max.z;
-    const width = Math.ceil((maxX - minX) / gridStep) + 1;
-    const height = Math.ceil((maxY - minY) / gridStep) + 1;
+    // Each angle only binds the triangles of its rotation sector
+    const sectorGrid = buildRadialSectorGrid(triangles, stripBounds, gridStep, data.sectorDeg ?? RADIAL_SECTOR_DEG);
+    const mesh = uploadMesh(triangles, stripBounds, sectorGrid);
+    const meanSectorTriangles = sectorGrid.sectorTriangleCounts.reduce((a, b) => a + b, 0) / sectorGrid.sectorCount;
+    console.log(`[WebGPU Worker] Radial sectors: ${sectorGrid.sectorCount} x ${sectorGrid.sectorSize.toFixed(2)}°, ${meanSectorTriangles.toFixed(0)} of ${mesh.triangleCount} triangles per sector on average`);
 
-    // Terrain is ALWAYS dense (Z-only format from GPU rasterizer)
-    // console.log(`[WebGPU Worker] Terrain dense format: ${width}x${height} = ${points.length} cells`);
+    const sparseToolData = createSparseToolFromPoints(toolPositions, gridStep);
+    const toolBuffer = uploadSparseTool(sparseToolData);
+
+    const stripWidth = Math.ceil((stripBounds.max.x - stripBounds.min.x) / gridStep) + 1;
+    const stripRows = Math.ceil((stripBounds.max.y - stripBounds.min.y) / gridStep) + 1;
+    const centerY = Math.round((0 - stripBounds.min.y) / gridStep);
+    const pointsPerLine = Math.ceil(stripWidth / xStep);
+
+    // Scanline uniforms; the last field is set per angle
+    const uniformData = new Uint32Array([stripWidth, stripRows, sparseToolData.count, xStep, centerY, pointsPerLine, 0, 0]);
+    new Float32Array(uniformData.buffer)[6] = zFloor;
 
     return {
-        grid: points,  // Dense Z-only array
-        width,
-        height,
-        minX,
-        minY,
-        minZ,
-        maxX,
-        maxY,
-        maxZ
+        gridStep, stripBounds, sectorGrid, mesh, toolBuffer, uniformData, pointsPerLine,
+        stripBytes: stripWidth * stripRows * 4,
+        tiled: false
     };
 }
 
-// Helper: Create sparse tool representation
-// Points come from GPU as [gridX, gridY, Z] - pure integer grid coordinates for X/Y
-function createSparseToolFromPoints(points, gridStep) {
-    if (!points || points.length === 0) {
-        throw new Error('No tool points provided');
+// Run a list of angles on a radial job, reading back only the scanlines
+// The rasterize and scanline passes of the whole list are encoded into one submission (split only when the
+// strips would exceed the memory budget) and read back as one packed block. Returns { scanlines: Float32Array(angles x pointsPerLine), pointsPerLine, xOrigin }
+async function runRadialJobAngles(job, angles) {
+    const { gridStep, stripBounds } = job;
+
+    if (job.tiled) {
+        const scanlines = [];
+        for (const angle of angles) {
+            const strip = await rasterizeMesh(job.triangles, gridStep, 0, { ...stripBounds, rotationAngleDeg: angle });
+            scanlines.push(generateRadialScanline({
+                stripPositions: strip.positions,
+                stripBounds: strip.bounds,
+                toolPositions: job.toolPositions,
+                xStep: job.xStep,
+                zFloor: job.zFloor,
+                gridStep
+            }).scanline);
+        }
+        const pointsPerLine = scanlines.length > 0 ? scanlines[0].length : 0;
+        const result = new Float32Array(angles.length * pointsPerLine);
+        scanlines.forEach((scanline, i) => result.set(scanline, i * pointsPerLine));
+        return { scanlines: result, pointsPerLine, xOrigin: stripBounds.min.x };
     }
 
-    // Points are [gridX, gridY, Z] where gridX/gridY are grid indices (floats but integer values)
-    // Find bounds in grid space and tool tip Z
-    let minGridX = Infinity, minGridY = Infinity, minZ = Infinity;
-    let maxGridX = -Infinity, maxGridY = -Infinity;
-
-    for (let i = 0; i < points.length; i += 3) {
-        const gridX = points[i];      // Already a grid index
-        const gridY = points[i + 1];  // Already a grid index
-        const z = points[i + 2];
+    const { sectorGrid, mesh, pointsPerLine } = job;
+    const scanlines = new Float32Array(angles.length * pointsPerLine);
 
-        minGridX = Math.min(minGridX, gridX);
-        maxGridX = Math.max(maxGridX, gridX);
-        minGridY = Math.min(minGridY, gridY);
-        maxGridY = Math.max(maxGridY, gridY);
-        minZ = Math.min(minZ, z);
-    }
+    // All angles of a batch go into one submission with their strips resident at once,
+    // as many as fit the memory budget
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+    const anglesPerSubmit = Math.max(1, Math.floor(maxSafeSize / job.stripBytes));
 
-    // Calculate tool center in grid coordinates (pure integer)
-    const width = Math.floor(maxGridX - minGridX) + 1;
-    const height = Math.floor(maxGridY - minGridY) + 1;
-    const centerX = Math.floor(minGridX) + Math.floor(width / 2);
-    const centerY = Math.floor(minGridY) + Math.floor(height / 2);
+    for (let start = 0; start < angles.length; start += anglesPerSubmit) {
+        const batch = angles.slice(start, start + anglesPerSubmit);
+        const batchBuffer = device.createBuffer({
+            size: batch.length * pointsPerLine * 4,
+            usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+        });
+        const transientBuffers = [batchBuffer];
+
+        const commandEncoder = device.createCommandEncoder();
+        for (let i = 0; i < batch.length; i++) {
+            const sector = Math.min(sectorGrid.sectorCount - 1,
+                Math.floor((((batch[i] % 360) + 360) % 360) / sectorGrid.sectorSize));
+            const raster = encodeRasterizePass(commandEncoder, mesh, gridStep, 0, stripBounds, batch[i], sector);
+            transientBuffers.push(raster.outputBuffer, raster.validMaskBuffer, ...raster.transientBuffers);
+
+            const uniformData = job.uniformData.slice();
+            uniformData[7] = i * pointsPerLine;
+            const uniformBuffer = device.createBuffer({
+                size: uniformData.byteLength,
+                usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+            });
+            device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+            transientBuffers.push(uniformBuffer);
+
+            const bindGroup = device.createBindGroup({
+                layout: cachedRadialScanlinePipeline.getBindGroupLayout(0),
+                entries: [
+                    { binding: 0, resource: { buffer: raster.outputBuffer } },
+                    { binding: 1, resource: { buffer: job.toolBuffer } },
+                    { binding: 2, resource: { buffer: batchBuffer } },
+                    { binding: 3, resource: { buffer: uniformBuffer } },
+                ],
+            });
+            const passEncoder = commandEncoder.beginComputePass();
+            passEncoder.setPipeline(cachedRadialScanlinePipeline);
+            passEncoder.setBindGroup(0, bindGroup);
+            passEncoder.dispatchWorkgroups(Math.ceil(pointsPerLine / 64));
+            passEncoder.end();
+        }
 
-    // Convert each point to offset from center (integer arithmetic only)
-    const xOffsets = [];
-    const yOffsets = [];
-    const zValues = [];
+        const staging = encodeReadback(commandEncoder, batchBuffer, batch.length * pointsPerLine * 4);
+        device.queue.submit([commandEncoder.finish()]);
 
-    for (let i = 0; i < points.length; i += 3) {
-        const gridX = Math.floor(points[i]);      // Grid index (ensure integer)
-        const gridY = Math.floor(points[i + 1]);  // Grid index (ensure integer)
-        const z = points[i + 2];
+        scanlines.set(await readStagingFloat32(staging), start * pointsPerLine);
+        transientBuffers.forEach(buffer => buffer.destroy());
+    }
 
-        // Calculate offset from tool center (pure integer arithmetic)
-        const xOffset = gridX - centerX;
-        const yOffset = gridY - centerY;
-        const zValue = z - minZ; // Z relative to tool tip
+    return { scanlines, pointsPerLine, xOrigin: stripBounds.min.x };
+}
 
-        xOffsets.push(xOffset);
-        yOffsets.push(yOffset);
-        zValues.push(zValue);
+// Adaptive angular refinement: run a coarse set of angles, then keep bisecting each neighbouring pair
+// (including the wrap from the last angle back to the first) whose scanlines differ by more than tolerance
+// (mm) anywhere along X, until pairs agree or are minStep (degrees) apart. Only pairs touching an angle added
+// in the previous round are re-checked. Returns rows sorted by angle with their angle table.
+async function runRadialJobAdaptive(job, coarseStep, minStep, tolerance) {
+    const rows = new Map();
+    let pending = [];
+    for (let angle = 0; angle < 360; angle += coarseStep) {
+        pending.push(angle);
+    }
+    let pointsPerLine = 0;
+    let rounds = 0;
+
+    while (pending.length > 0) {
+        const result = await runRadialJobAngles(job, pending);
+        pointsPerLine = result.pointsPerLine;
+        pending.forEach((angle, i) => {
+            rows.set(angle, result.scanlines.subarray(i * pointsPerLine, (i + 1) * pointsPerLine));
+        });
+        rounds++;
+
+        const added = new Set(pending);
+        const sorted = [...rows.keys()].sort((a, b) => a - b);
+        pending = [];
+        for (let i = 0; i < sorted.length; i++) {
+            const a = sorted[i];
+            const b = i + 1 < sorted.length ? sorted[i + 1] : sorted[0] + 360;
+            const bAngle = i + 1 < sorted.length ? b : sorted[0];
+            if (!added.has(a) && !added.has(bAngle)) continue;
+            if ((b - a) / 2 < minStep) continue;
+
+            const rowA = rows.get(a), rowB = rows.get(bAngle);
+            let maxDiff = 0;
+            for (let x = 0; x < pointsPerLine; x++) {
+                maxDiff = Math.max(maxDiff, Math.abs(rowA[x] - rowB[x]));
+            }
+            if (maxDiff > tolerance) {
+                pending.push(((a + b) / 2) % 360);
+            }
+        }
     }
 
-    return {
-        count: xOffsets.length,
-        xOffsets: new Int32Array(xOffsets),
-        yOffsets: new Int32Array(yOffsets),
-        zValues: new Float32Array(zValues),
-        referenceZ: minZ
-    };
-}
+    const angles = [...rows.keys()].sort((a, b) => a - b);
+    const pathData = new Float32Array(angles.length * pointsPerLine);
+    angles.forEach((angle, i) => pathData.set(rows.get(angle), i * pointsPerLine));
 
-// Generate toolpath for a single region (internal)
-async function generateToolpathSingle(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds = null) {
-    const startTime = performance.now();
-    console.log('[WebGPU Worker] Generating toolpath...');
-    console.log(`[WebGPU Worker] Input: terrain ${terrainPoints.length/3} points, tool ${toolPoints.length/3} points, steps (${xStep}, ${yStep}), oobZ ${oobZ}, gridStep ${gridStep}`);
+    console.log(`[WebGPU Worker] Adaptive radial: ${angles.length} angles (${Math.ceil(360 / coarseStep)} coarse) in ${rounds} rounds`);
+    return { pathData, angles: new Float32Array(angles), pointsPerLine, numRotations: angles.length };
+}
 
-    if (terrainBounds) {
-        console.log(`[WebGPU Worker] Using terrain bounds: min(${terrainBounds.min.x.toFixed(2)}, ${terrainBounds.min.y.toFixed(2)}, ${terrainBounds.min.z.toFixed(2)}) max(${terrainBounds.max.x.toFixed(2)}, ${terrainBounds.max.y.toFixed(2)}, ${terrainBounds.max.z.toFixed(2)})`);
+function endRadialJob(job) {
+    if (job.tiled) {
+        return;
     }
+    job.mesh.destroy();
+    job.toolBuffer.destroy();
+}
 
-    try {
-        // Create height map from terrain points (use terrain bounds if provided)
-        const terrainMapData = createHeightMapFromPoints(terrainPoints, gridStep, terrainBounds);
-        console.log(`[WebGPU Worker] Created terrain map: ${terrainMapData.width}x${terrainMapData.height}`);
+// Cylindrical radius map
+// Instead of rasterizing a rotated strip per angle, one dispatch casts rays outward from the X axis over an
+// (X, angle) grid and keeps the outermost radius. Any number of rotations (and tools) are then collided
+// against the unwrapped map. This matches the strip rasterization for cross sections that are star-shaped
+// about the axis (every outward ray leaves the part once); deeper undercuts see only the outer skin.
 
-        // Create sparse tool representation
-        const sparseToolData = createSparseToolFromPoints(toolPoints, gridStep);
-        console.log(`[WebGPU Worker] Created sparse tool: ${sparseToolData.count} points`);
+const CYLINDER_SECTORS = 72;
 
-        // Run WebGPU compute
-        const result = await runToolpathCompute(
-            terrainMapData, sparseToolData, xStep, yStep, oobZ, startTime
-        );
+// Bin triangles by X cell and by the angular sectors their YZ projection spans (all sectors if it contains the axis)
+function buildCylinderGrid(triangles, minX, maxX, sectorCount, cellSize = 5.0) {
+    const cellsX = Math.max(1, Math.ceil((maxX - minX) / cellSize));
+    const sectorSize = 360 / sectorCount;
+    const triangleCount = triangles.length / 9;
+    const ranges = new Int32Array(triangleCount * 4);
 
-        return result;
-    } catch (error) {
-        console.error('[WebGPU Worker] Error generating toolpath:', error);
-        throw error;
+    const cellCounts = new Uint32Array(sectorCount * cellsX);
+    for (let t = 0; t < triangleCount; t++) {
+        const base = t * 9;
+        const minTX = Math.min(triangles[base], triangles[base + 3], triangles[base + 6]);
+        const maxTX = Math.max(triangles[base], triangles[base + 3], triangles[base + 6]);
+        const firstCell = Math.max(0, Math.min(cellsX - 1, Math.floor((minTX - minX) / cellSize)));
+        const lastCell = Math.max(0, Math.min(cellsX - 1, Math.floor((maxTX - minX) / cellSize)));
+
+        const y0 = triangles[base + 1], z0 = triangles[base + 2];
+        const y1 = triangles[base + 4], z1 = triangles[base + 5];
+        const y2 = triangles[base + 7], z2 = triangles[base + 8];
+        let firstSector = 0, sectorSpan = sectorCount;
+        if (distanceToTriangle2D(0, 0, y0, z0, y1, z1, y2, z2) > 0) {
+            const span = triangleAngularSpan(y0, z0, y1, z1, y2, z2);
+            firstSector = Math.floor(span.start / sectorSize);
+            sectorSpan = Math.min(sectorCount, Math.floor(span.end / sectorSize) - firstSector + 1);
+        }
+        ranges.set([firstCell, lastCell, firstSector, sectorSpan], t * 4);
+
+        for (let k = 0; k < sectorSpan; k++) {
+            const sector = (((firstSector + k) % sectorCount) + sectorCount) % sectorCount;
+            for (let c = firstCell; c <= lastCell; c++) cellCounts[sector * cellsX + c]++;
+        }
+    }
+
+    const cellOffsets = new Uint32Array(sectorCount * cellsX + 1);
+    for (let i = 0; i < sectorCount * cellsX; i++) {
+        cellOffsets[i + 1] = cellOffsets[i] + cellCounts[i];
+    }
+    const cursor = cellOffsets.slice(0, sectorCount * cellsX);
+    const triangleIndices = new Uint32Array(cellOffsets[sectorCount * cellsX]);
+    for (let t = 0; t < triangleCount; t++) {
+        const [firstCell, lastCell, firstSector, sectorSpan] = ranges.subarray(t * 4, t * 4 + 4);
+        for (let k = 0; k < sectorSpan; k++) {
+            const sector = (((firstSector + k) % sectorCount) + sectorCount) % sectorCount;
+            for (let c = firstCell; c <= lastCell; c++) triangleIndices[cursor[sector * cellsX + c]++] = t;
+        }
     }
+
+    return { cellOffsets, triangleIndices, cellsX, cellSize, sectorCount };
 }
 
-async function runToolpathCompute(terrainMapData, sparseToolData, xStep, yStep, oobZ, startTime) {
+// Rasterize the mesh into a radius map {mapBuffer, width, angleCount, gridStep, minX, maxRadius}
+// angleStep (degrees) defaults to about one grid step of arc at the part's largest radius
+async function rasterizeCylinderMap(triangles, gridStep, bounds, options = {}) {
     if (!isInitialized) {
         const success = await initWebGPU();
         if (!success) {
@@ -1159,529 +5407,970 @@ async function runToolpathCompute(terrainMapData, sparseToolData, xStep, yStep,
         }
     }
 
-    // Use WASM-generated terrain grid
-    const terrainBuffer = device.createBuffer({
-        size: terrainMapData.grid.byteLength,
-        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
-    });
-    device.queue.writeBuffer(terrainBuffer, 0, terrainMapData.grid);
-
-    // Use WASM-generated sparse tool
-    const toolBufferData = new ArrayBuffer(sparseToolData.count * 16);
-    const toolBufferI32 = new Int32Array(toolBufferData);
-    const toolBufferF32 = new Float32Array(toolBufferData);
-
-    for (let i = 0; i < sparseToolData.count; i++) {
-        toolBufferI32[i * 4 + 0] = sparseToolData.xOffsets[i];
-        toolBufferI32[i * 4 + 1] = sparseToolData.yOffsets[i];
-        toolBufferF32[i * 4 + 2] = sparseToolData.zValues[i];
-        toolBufferF32[i * 4 + 3] = 0;
+    const maxRadius = Math.max(
+        Math.hypot(bounds.min.y, bounds.min.z), Math.hypot(bounds.min.y, bounds.max.z),
+        Math.hypot(bounds.max.y, bounds.min.z), Math.hypot(bounds.max.y, bounds.max.z)
+    );
+    const angleCount = options.angleStep
+        ? Math.ceil(360 / options.angleStep)
+        : Math.max(CYLINDER_SECTORS, Math.ceil(2 * Math.PI * maxRadius / gridStep));
+    const width = Math.ceil((bounds.max.x - bounds.min.x) / gridStep) + 1;
+
+    const mapBytes = width * angleCount * 4;
+    const deviceLimit = Math.min(deviceCapabilities.maxStorageBufferBindingSize, deviceCapabilities.maxBufferSize);
+    if (mapBytes > deviceLimit) {
+        throw new Error(`Cylinder map too large: ${width}x${angleCount} cells. Try a larger grid step or angle step.`);
     }
 
-    const toolBuffer = device.createBuffer({
-        size: toolBufferData.byteLength,
+    const grid = buildCylinderGrid(triangles, bounds.min.x, bounds.max.x, CYLINDER_SECTORS);
+    const triangleBuffer = device.createBuffer({
+        size: triangles.byteLength,
         usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
     });
-    device.queue.writeBuffer(toolBuffer, 0, toolBufferData);
-
-    // Calculate output dimensions
-    const pointsPerLine = Math.ceil(terrainMapData.width / xStep);
-    const numScanlines = Math.ceil(terrainMapData.height / yStep);
-    const outputSize = pointsPerLine * numScanlines;
-
-    console.log(`[WebGPU Worker] Output: ${pointsPerLine}x${numScanlines} = ${outputSize} points`);
+    device.queue.writeBuffer(triangleBuffer, 0, triangles);
+    const offsetsBuffer = device.createBuffer({
+        size: grid.cellOffsets.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(offsetsBuffer, 0, grid.cellOffsets);
+    const indicesBuffer = device.createBuffer({
+        size: Math.max(4, grid.triangleIndices.byteLength),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(indicesBuffer, 0, grid.triangleIndices);
 
-    const outputBuffer = device.createBuffer({
-        size: outputSize * 4,
+    const mapBuffer = device.createBuffer({
+        size: mapBytes,
         usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
     });
 
-    const uniformData = new Uint32Array([
-        terrainMapData.width,
-        terrainMapData.height,
-        sparseToolData.count,
-        xStep,
-        yStep,
-        0,
-        pointsPerLine,
-        numScanlines,
-    ]);
-    const uniformDataFloat = new Float32Array(uniformData.buffer);
-    uniformDataFloat[5] = oobZ;
-
+    const uniformData = new Float32Array([bounds.min.x, gridStep, 0, 0, 2 * Math.PI / angleCount, grid.cellSize, 0, 0]);
+    const uniformDataU32 = new Uint32Array(uniformData.buffer);
+    uniformDataU32[2] = width;
+    uniformDataU32[3] = angleCount;
+    uniformDataU32[6] = grid.cellsX;
+    uniformDataU32[7] = grid.sectorCount;
     const uniformBuffer = device.createBuffer({
         size: uniformData.byteLength,
         usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
     });
     device.queue.writeBuffer(uniformBuffer, 0, uniformData);
 
-    // Use cached pipeline
     const bindGroup = device.createBindGroup({
-        layout: cachedToolpathPipeline.getBindGroupLayout(0),
+        layout: cachedCylinderRasterPipeline.getBindGroupLayout(0),
         entries: [
-            { binding: 0, resource: { buffer: terrainBuffer } },
-            { binding: 1, resource: { buffer: toolBuffer } },
-            { binding: 2, resource: { buffer: outputBuffer } },
-            { binding: 3, resource: { buffer: uniformBuffer } },
+            { binding: 0, resource: { buffer: triangleBuffer } },
+            { binding: 1, resource: { buffer: mapBuffer } },
+            { binding: 2, resource: { buffer: uniformBuffer } },
+            { binding: 3, resource: { buffer: offsetsBuffer } },
+            { binding: 4, resource: { buffer: indicesBuffer } },
         ],
     });
 
+    const workgroupsX = Math.ceil(width / 16);
+    const workgroupsY = Math.ceil(angleCount / 16);
+    const maxWorkgroupsPerDim = device.limits.maxComputeWorkgroupsPerDimension || 65535;
+    if (workgroupsX > maxWorkgroupsPerDim || workgroupsY > maxWorkgroupsPerDim) {
+        throw new Error(`Workgroup dispatch too large: ${workgroupsX}x${workgroupsY} exceeds limit of ${maxWorkgroupsPerDim}. Try a larger step size.`);
+    }
+
     const commandEncoder = device.createCommandEncoder();
     const passEncoder = commandEncoder.beginComputePass();
-    passEncoder.setPipeline(cachedToolpathPipeline);
+    passEncoder.setPipeline(cachedCylinderRasterPipeline);
     passEncoder.setBindGroup(0, bindGroup);
-
-    const workgroupsX = Math.ceil(pointsPerLine / 16);
-    const workgroupsY = Math.ceil(numScanlines / 16);
     passEncoder.dispatchWorkgroups(workgroupsX, workgroupsY);
     passEncoder.end();
-
-    const stagingBuffer = device.createBuffer({
-        size: outputSize * 4,
-        usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
-    });
-
-    commandEncoder.copyBufferToBuffer(outputBuffer, 0, stagingBuffer, 0, outputSize * 4);
-
     device.queue.submit([commandEncoder.finish()]);
-    await stagingBuffer.mapAsync(GPUMapMode.READ);
-
-    const outputData = new Float32Array(stagingBuffer.getMappedRange());
-    const result = new Float32Array(outputData);
-    stagingBuffer.unmap();
+    await device.queue.onSubmittedWorkDone();
 
-    terrainBuffer.destroy();
-    toolBuffer.destroy();
-    outputBuffer.destroy();
+    triangleBuffer.destroy();
+    offsetsBuffer.destroy();
+    indicesBuffer.destroy();
     uniformBuffer.destroy();
-    stagingBuffer.destroy();
 
-    const endTime = performance.now();
-    console.log(`[WebGPU Worker] ✅ Toolpath complete in ${(endTime - startTime).toFixed(1)}ms`);
-    console.log(`[WebGPU Worker] Output: ${result.length} values (${numScanlines} scanlines × ${pointsPerLine} points)`);
+    return { mapBuffer, width, angleCount, gridStep, minX: bounds.min.x, maxRadius };
+}
 
-    // Log sample of output for debugging
-    const sampleSize = Math.min(10, result.length);
-    console.log(`[WebGPU Worker] First ${sampleSize} values:`, Array.from(result.slice(0, sampleSize)));
+// Rasterize the mesh into the resident radius map, replacing any previous one
+async function createCylinderMap(triangles, gridStep, bounds, options = {}) {
+    const startTime = performance.now();
+    disposeCylinderMap();
+    residentCylinderMap = await rasterizeCylinderMap(triangles, gridStep, bounds, options);
+    const { width, angleCount } = residentCylinderMap;
 
-    return {
-        pathData: result,
-        numScanlines,
-        pointsPerLine,
-        generationTime: endTime - startTime
-    };
+    const generationTime = performance.now() - startTime;
+    console.log(`[WebGPU Worker] Cylinder map resident: ${width}x${angleCount} in ${generationTime.toFixed(1)}ms`);
+    return { width, angleCount, angleStep: 360 / angleCount, generationTime };
 }
 
-// Generate toolpath with tiling support (public API)
-async function generateToolpath(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds = null) {
-    // Calculate bounds if not provided
-    if (!terrainBounds) {
-        let minX = Infinity, minY = Infinity, minZ = Infinity;
-        let maxX = -Infinity, maxY = -Infinity, maxZ = -Infinity;
-        for (let i = 0; i < terrainPoints.length; i += 3) {
-            minX = Math.min(minX, terrainPoints[i]);
-            maxX = Math.max(maxX, terrainPoints[i]);
-            minY = Math.min(minY, terrainPoints[i + 1]);
-            maxY = Math.max(maxY, terrainPoints[i + 1]);
-            minZ = Math.min(minZ, terrainPoints[i + 2]);
-            maxZ = Math.max(maxZ, terrainPoints[i + 2]);
-        }
-        terrainBounds = {
-            min: { x: minX, y: minY, z: minZ },
-            max: { x: maxX, y: maxY, z: maxZ }
-        };
+// Radial toolpath against the resident radius map: one dispatch covers every rotation
+// Same output layout as generateRadialToolpath (numRotations x pointsPerLine tool center heights)
+// options.helical: one continuous path instead, sample i at A = i * xRotationStep degrees and
+// X = minX + i * xStep * gridStep / samplesPerTurn (xStep grid cells per turn)
+async function generateCylindricalToolpath(toolPositions, xRotationStep, xStep, zFloor, options = {}) {
+    if (!residentCylinderMap) {
+        throw new Error('No cylinder map. Call createCylinderMap() first.');
     }
+    return cylinderMapToolpath(residentCylinderMap, toolPositions, xRotationStep, xStep, zFloor, options);
+}
 
-    // Calculate tool dimensions for overlap
-    // Tool points are [gridX, gridY, Z] where X/Y are grid indices (not mm)
-    let toolMinX = Infinity, toolMaxX = -Infinity;
-    let toolMinY = Infinity, toolMaxY = -Infinity;
-    for (let i = 0; i < toolPoints.length; i += 3) {
-        toolMinX = Math.min(toolMinX, toolPoints[i]);
-        toolMaxX = Math.max(toolMaxX, toolPoints[i]);
-        toolMinY = Math.min(toolMinY, toolPoints[i + 1]);
-        toolMaxY = Math.max(toolMaxY, toolPoints[i + 1]);
+// One-off radial toolpath with a job-local radius map; the resident map is left untouched
+async function generateCylindricalRadialToolpath(triangles, toolPositions, xRotationStep, xStep, zFloor, gridStep, bounds, options = {}) {
+    const map = await rasterizeCylinderMap(triangles, gridStep, bounds, { angleStep: options.cylinderAngleStep });
+    try {
+        return await cylinderMapToolpath(map, toolPositions, xRotationStep, xStep, zFloor, { helical: options.helical });
+    } finally {
+        map.mapBuffer.destroy();
     }
-    // Tool dimensions in grid cells
-    const toolWidthCells = toolMaxX - toolMinX;
-    const toolHeightCells = toolMaxY - toolMinY;
-    // Convert to mm for logging
-    const toolWidthMm = toolWidthCells * gridStep;
-    const toolHeightMm = toolHeightCells * gridStep;
-
-    // Check if tiling is needed based on output grid size
-    const outputWidth = Math.ceil((terrainBounds.max.x - terrainBounds.min.x) / gridStep) + 1;
-    const outputHeight = Math.ceil((terrainBounds.max.y - terrainBounds.min.y) / gridStep) + 1;
-    const outputPoints = Math.ceil(outputWidth / xStep) * Math.ceil(outputHeight / yStep);
-    const outputMemory = outputPoints * 4; // 4 bytes per float
+}
 
-    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
-    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
-    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+// Collide the tool against a radius map, resident or job-local
+async function cylinderMapToolpath(map, toolPositions, xRotationStep, xStep, zFloor, options) {
+    const startTime = performance.now();
 
-    if (outputMemory <= maxSafeSize) {
-        // No tiling needed
-        return await generateToolpathSingle(terrainPoints, toolPoints, xStep, yStep, oobZ, gridStep, terrainBounds);
+    // Dense tool grid indexed by (xOffset, yOffset) relative to its minimum offsets
+    const sparseTool = createSparseToolFromPoints(toolPositions, map.gridStep);
+    let minOX = Infinity, maxOX = -Infinity, minOY = Infinity, maxOY = -Infinity;
+    for (let i = 0; i < sparseTool.count; i++) {
+        minOX = Math.min(minOX, sparseTool.xOffsets[i]);
+        maxOX = Math.max(maxOX, sparseTool.xOffsets[i]);
+        minOY = Math.min(minOY, sparseTool.yOffsets[i]);
+        maxOY = Math.max(maxOY, sparseTool.yOffsets[i]);
+    }
+    const toolWidth = maxOX - minOX + 1;
+    const toolHeight = maxOY - minOY + 1;
+    const toolGrid = new Float32Array(toolWidth * toolHeight).fill(-1e10);
+    for (let i = 0; i < sparseTool.count; i++) {
+        toolGrid[(sparseTool.yOffsets[i] - minOY) * toolWidth + (sparseTool.xOffsets[i] - minOX)] = sparseTool.zValues[i];
     }
 
-    // Tiling needed (terrain is ALWAYS dense)
-    const tilingStartTime = performance.now();
-    console.log('[WebGPU Worker] 🔲 Using tiled toolpath generation');
-    console.log(`[WebGPU Worker] Terrain: DENSE (${terrainPoints.length} cells = ${outputWidth}x${outputHeight})`);
-    console.log(`[WebGPU Worker] Tool dimensions: ${toolWidthMm.toFixed(2)}mm × ${toolHeightMm.toFixed(2)}mm (${toolWidthCells}×${toolHeightCells} cells)`);
+    // Helical output uses rows for turns and columns for the angles within a turn
+    const helical = !!options.helical;
+    const samplesPerTurn = Math.ceil(360 / xRotationStep);
+    const turns = Math.max(1, Math.ceil((map.width - 1) / xStep));
+    const numRotations = helical ? turns : samplesPerTurn;
+    const pointsPerLine = helical ? samplesPerTurn : Math.ceil(map.width / xStep);
 
-    // Create tiles with tool-size overlap (pass dimensions in grid cells)
-    const tiles = createToolpathTiles(terrainBounds, gridStep, xStep, yStep, toolWidthCells, toolHeightCells, maxSafeSize);
-    console.log(`[WebGPU Worker] Created ${tiles.length} tiles`);
+    const toolBuffer = device.createBuffer({
+        size: toolGrid.byteLength,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(toolBuffer, 0, toolGrid);
+    const outputBuffer = device.createBuffer({
+        size: numRotations * pointsPerLine * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC,
+    });
 
-    // Process each tile
-    const tileResults = [];
-    let totalTileTime = 0;
-    for (let i = 0; i < tiles.length; i++) {
-        const tile = tiles[i];
-        const tileStartTime = performance.now();
-        console.log(`[WebGPU Worker] Processing tile ${i + 1}/${tiles.length}...`);
+    const uniformData = new Uint32Array(16);
+    const uniformDataF32 = new Float32Array(uniformData.buffer);
+    const uniformDataI32 = new Int32Array(uniformData.buffer);
+    uniformData[0] = map.width;
+    uniformData[1] = map.angleCount;
+    uniformDataF32[2] = 2 * Math.PI / map.angleCount;
+    uniformDataF32[3] = map.gridStep;
+    uniformData[4] = toolWidth;
+    uniformData[5] = toolHeight;
+    uniformDataI32[6] = -minOX;
+    uniformDataI32[7] = -minOY;
+    uniformData[8] = xStep;
+    uniformData[9] = pointsPerLine;
+    uniformData[10] = numRotations;
+    uniformDataF32[11] = xRotationStep * Math.PI / 180;
+    uniformDataF32[12] = zFloor;
+    uniformData[13] = helical ? 1 : 0;
+    const uniformBuffer = device.createBuffer({
+        size: uniformData.byteLength,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    device.queue.writeBuffer(uniformBuffer, 0, uniformData);
 
-        // Report progress
-        const percent = Math.round(((i + 1) / tiles.length) * 100);
-        self.postMessage({
-            type: 'toolpath-progress',
-            data: {
-                percent,
-                current: i + 1,
-                total: tiles.length,
-                layer: i + 1  // Using tile index as "layer" for consistency
-            }
-        });
+    const bindGroup = device.createBindGroup({
+        layout: cachedCylinderToolpathPipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: map.mapBuffer } },
+            { binding: 1, resource: { buffer: toolBuffer } },
+            { binding: 2, resource: { buffer: outputBuffer } },
+            { binding: 3, resource: { buffer: uniformBuffer } },
+        ],
+    });
 
-        // Extract terrain sub-grid for this tile (terrain is ALWAYS dense)
-        const tileMinGridX = Math.floor((tile.bounds.min.x - terrainBounds.min.x) / gridStep);
-        const tileMaxGridX = Math.ceil((tile.bounds.max.x - terrainBounds.min.x) / gridStep);
-        const tileMinGridY = Math.floor((tile.bounds.min.y - terrainBounds.min.y) / gridStep);
-        const tileMaxGridY = Math.ceil((tile.bounds.max.y - terrainBounds.min.y) / gridStep);
+    const commandEncoder = device.createCommandEncoder();
+    const passEncoder = commandEncoder.beginComputePass();
+    passEncoder.setPipeline(cachedCylinderToolpathPipeline);
+    passEncoder.setBindGroup(0, bindGroup);
+    passEncoder.dispatchWorkgroups(Math.ceil(pointsPerLine / 16), Math.ceil(numRotations / 16));
+    passEncoder.end();
+    const staging = encodeReadback(commandEncoder, outputBuffer, numRotations * pointsPerLine * 4);
+    device.queue.submit([commandEncoder.finish()]);
 
-        const tileWidth = tileMaxGridX - tileMinGridX + 1;
-        const tileHeight = tileMaxGridY - tileMinGridY + 1;
-        const tileTerrainPoints = new Float32Array(tileWidth * tileHeight);
+    const pathData = await readStagingFloat32(staging);
+    toolBuffer.destroy();
+    outputBuffer.destroy();
+    uniformBuffer.destroy();
 
-        console.log(`[WebGPU Worker] Tile ${i+1} dense extraction: ${tileWidth}x${tileHeight} from global ${outputWidth}x${outputHeight}`);
+    const generationTime = performance.now() - startTime;
+    if (helical) {
+        console.log(`[WebGPU Worker] ✅ Helical toolpath: ${turns} turns × ${samplesPerTurn} points in ${generationTime.toFixed(1)}ms`);
+        return {
+            pathData, helical: true, numPoints: pathData.length, turns, samplesPerTurn,
+            rotationStepDegrees: xRotationStep, xAdvancePerTurn: xStep * map.gridStep, xOrigin: map.minX, generationTime
+        };
+    }
+    console.log(`[WebGPU Worker] ✅ Cylindrical toolpath: ${numRotations} rotations × ${pointsPerLine} points in ${generationTime.toFixed(1)}ms`);
+    return { pathData, numRotations, pointsPerLine, rotationStepDegrees: xRotationStep, generationTime };
+}
 
-        // Copy relevant sub-grid from full terrain
-        const EMPTY_CELL = -1e10;
-        tileTerrainPoints.fill(EMPTY_CELL);
+function disposeCylinderMap() {
+    if (residentCylinderMap) {
+        residentCylinderMap.mapBuffer.destroy();
+        residentCylinderMap = null;
+    }
+}
 
-        for (let ty = 0; ty < tileHeight; ty++) {
-            const globalY = tileMinGridY + ty;
-            if (globalY < 0 || globalY >= outputHeight) continue;
+// Resident stock model
+// A dense stock heightmap (EMPTY_CELL where there is no material) kept on the GPU between operations.
+// Each simulated toolpath lowers it in place; row bands that changed are tracked so readStock can
+// return only the regions touched since the last read.
 
-            for (let tx = 0; tx < tileWidth; tx++) {
-                const globalX = tileMinGridX + tx;
-                if (globalX < 0 || globalX >= outputWidth) continue;
+const STOCK_BAND_ROWS = 64;
 
-                const globalIdx = globalY * outputWidth + globalX;
-                const tileIdx = ty * tileWidth + tx;
-                tileTerrainPoints[tileIdx] = terrainPoints[globalIdx];
-            }
+// Create (or replace) the resident stock
+// shape 'box': flat at bounds.max.z; 'cylinder': radius about the X axis (y = 0, z = 0);
+// heights: a previous stock or heightmap (width x height Float32Array) to start from
+async function createStock(bounds, gridStep, options = {}) {
+    if (!isInitialized) {
+        const success = await initWebGPU();
+        if (!success) {
+            throw new Error('WebGPU not available');
         }
+    }
+    if (residentStock) {
+        disposeStock();
+    }
 
-        // Generate toolpath for this tile
-        const tileToolpathResult = await generateToolpathSingle(
-            tileTerrainPoints,
-            toolPoints,
-            xStep,
-            yStep,
-            oobZ,
-            gridStep,
-            tile.bounds
-        );
+    const EMPTY_CELL = -1e10;
+    const width = Math.ceil((bounds.max.x - bounds.min.x) / gridStep) + 1;
+    const height = Math.ceil((bounds.max.y - bounds.min.y) / gridStep) + 1;
+    const { shape = 'box', radius = null, heights = null } = options;
+    const deviceLimit = Math.min(deviceCapabilities.maxStorageBufferBindingSize, deviceCapabilities.maxBufferSize);
+    if (width * height * 4 > deviceLimit) {
+        throw new Error(`Stock too large to keep resident: ${width}x${height} cells. Try a larger grid step.`);
+    }
 
-        const tileTime = performance.now() - tileStartTime;
-        totalTileTime += tileTime;
+    let initial;
+    if (heights) {
+        if (heights.length !== width * height) {
+            throw new Error(`Stock heights must be ${width}x${height}, got ${heights.length} values`);
+        }
+        initial = heights;
+    } else if (shape === 'cylinder') {
+        const r = radius ?? Math.max(Math.abs(bounds.min.y), Math.abs(bounds.max.y), Math.abs(bounds.min.z), Math.abs(bounds.max.z));
+        initial = new Float32Array(width * height);
+        for (let y = 0; y < height; y++) {
+            const worldY = bounds.min.y + y * gridStep;
+            const z = Math.abs(worldY) <= r ? Math.sqrt(r * r - worldY * worldY) : EMPTY_CELL;
+            initial.fill(z, y * width, (y + 1) * width);
+        }
+    } else {
+        initial = new Float32Array(width * height).fill(bounds.max.z);
+    }
 
-        tileResults.push({
-            pathData: tileToolpathResult.pathData,
-            numScanlines: tileToolpathResult.numScanlines,
-            pointsPerLine: tileToolpathResult.pointsPerLine,
-            tile: tile
-        });
+    const stockBuffer = device.createBuffer({
+        size: width * height * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC,
+    });
+    device.queue.writeBuffer(stockBuffer, 0, initial);
 
-        console.log(`[WebGPU Worker] Tile ${i + 1}/${tiles.length} complete: ${tileToolpathResult.numScanlines}×${tileToolpathResult.pointsPerLine} in ${tileTime.toFixed(1)}ms`);
-    }
+    const bandCount = Math.ceil(height / STOCK_BAND_ROWS);
+    const dirtyBuffer = device.createBuffer({
+        size: Math.max(4, bandCount * 4),
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST,
+    });
+
+    residentStock = {
+        width,
+        height,
+        gridStep,
+        minX: bounds.min.x,
+        minY: bounds.min.y,
+        bandCount,
+        stockBuffer,
+        dirtyBuffer,
+        // CPU-side union of bands changed since the last readStock; a fresh stock is all dirty
+        dirtyBands: new Uint8Array(bandCount).fill(1)
+    };
 
-    console.log(`[WebGPU Worker] All tiles processed in ${totalTileTime.toFixed(1)}ms (avg ${(totalTileTime/tiles.length).toFixed(1)}ms per tile)`);
+    console.log(`[WebGPU Worker] Stock created: ${width}x${height} (${shape}${heights ? ', from heights' : ''})`);
+    return { width, height, bandRows: STOCK_BAND_ROWS };
+}
 
-    // Stitch tiles together, dropping overlap regions
-    const stitchStartTime = performance.now();
-    const stitchedResult = stitchToolpathTiles(tileResults, terrainBounds, gridStep, xStep, yStep);
-    const stitchTime = performance.now() - stitchStartTime;
+// Sweep a tool along a dense toolpath ({pathData, numScanlines, pointsPerLine}) and cut the stock
+// pathOrigin is the world XY of path sample (0, 0), i.e. the terrain bounds min used to generate it
+async function simulateStockToolpath(pathData, numScanlines, pointsPerLine, toolPoints, xStep, yStep, pathOrigin) {
+    if (!residentStock) {
+        throw new Error('No stock. Call createStock first.');
+    }
+    const startTime = performance.now();
+    const stock = residentStock;
+    const sparseToolData = createSparseToolFromPoints(toolPoints, stock.gridStep);
+    const originX = Math.round((pathOrigin.x - stock.minX) / stock.gridStep);
+    const originY = Math.round((pathOrigin.y - stock.minY) / stock.gridStep);
+    sweepToolIntoStock(stock, pathData, numScanlines, pointsPerLine, sparseToolData, xStep, yStep, originX, originY);
 
-    const totalTime = performance.now() - tilingStartTime;
-    console.log(`[WebGPU Worker] Stitching took ${stitchTime.toFixed(1)}ms`);
-    console.log(`[WebGPU Worker] ✅ Tiled toolpath complete: ${stitchedResult.numScanlines}×${stitchedResult.pointsPerLine} in ${totalTime.toFixed(1)}ms total`);
+    // Fold the GPU dirty flags into the CPU set and clear them for the next operation
+    const commandEncoder = device.createCommandEncoder();
+    const dirtyStaging = encodeReadback(commandEncoder, stock.dirtyBuffer, stock.bandCount * 4);
+    commandEncoder.clearBuffer(stock.dirtyBuffer);
+    device.queue.submit([commandEncoder.finish()]);
+    const dirtyFlags = new Uint32Array((await readStagingFloat32(dirtyStaging)).buffer);
 
-    // Update generation time to reflect total tiled time
-    stitchedResult.generationTime = totalTime;
+    let changedBands = 0;
+    for (let band = 0; band < stock.bandCount; band++) {
+        if (dirtyFlags[band]) {
+            stock.dirtyBands[band] = 1;
+            changedBands++;
+        }
+    }
 
-    return stitchedResult;
+    const generationTime = performance.now() - startTime;
+    console.log(`[WebGPU Worker] Stock simulated: ${numScanlines}×${pointsPerLine} path, ${changedBands}/${stock.bandCount} bands changed in ${generationTime.toFixed(1)}ms`);
+    return { changedBands, bandRows: STOCK_BAND_ROWS, generationTime };
 }
 
-// Create tiles for toolpath generation with overlap (using integer grid coordinates)
-// toolWidth and toolHeight are in grid cells (not mm)
-function createToolpathTiles(bounds, gridStep, xStep, yStep, toolWidthCells, toolHeightCells, maxMemoryBytes) {
-    // Calculate global grid dimensions
-    const globalGridWidth = Math.ceil((bounds.max.x - bounds.min.x) / gridStep) + 1;
-    const globalGridHeight = Math.ceil((bounds.max.y - bounds.min.y) / gridStep) + 1;
+// Encode and submit the sweep of pathData into stock ({width, height, stockBuffer, dirtyBuffer})
+// (originX, originY) is the stock cell of path sample (0, 0)
+function sweepToolIntoStock(stock, pathData, numScanlines, pointsPerLine, sparseToolData, xStep, yStep, originX, originY) {
+    const toolBuffer = uploadSparseTool(sparseToolData);
 
-    // Calculate tool overlap in grid cells (use radius = half diameter)
-    // Tool centered at tile boundary needs terrain extending half tool width beyond boundary
-    const toolOverlapX = Math.ceil(toolWidthCells / 2);
-    const toolOverlapY = Math.ceil(toolHeightCells / 2);
+    let minXOffset = 0, maxXOffset = 0, minYOffset = 0, maxYOffset = 0;
+    for (let i = 0; i < sparseToolData.count; i++) {
+        minXOffset = Math.min(minXOffset, sparseToolData.xOffsets[i]);
+        maxXOffset = Math.max(maxXOffset, sparseToolData.xOffsets[i]);
+        minYOffset = Math.min(minYOffset, sparseToolData.yOffsets[i]);
+        maxYOffset = Math.max(maxYOffset, sparseToolData.yOffsets[i]);
+    }
 
-    // Binary search for optimal tile size in grid cells
-    let low = Math.max(toolOverlapX, toolOverlapY) * 2; // At least 2x tool size
-    let high = Math.max(globalGridWidth, globalGridHeight);
-    let bestTileGridSize = high;
+    // Upload the path in scanline bands that fit the memory budget; each band only dispatches the
+    // stock rows its tool footprints can reach
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+    const bandScanlines = Math.max(1, Math.min(numScanlines, Math.floor(maxSafeSize / (pointsPerLine * 4))));
 
-    while (low <= high) {
-        const mid = Math.floor((low + high) / 2);
-        const outputW = Math.ceil(mid / xStep);
-        const outputH = Math.ceil(mid / yStep);
-        const memoryNeeded = outputW * outputH * 4;
+    const pathBuffer = device.createBuffer({
+        size: bandScanlines * pointsPerLine * 4,
+        usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST,
+    });
+    const uniformBuffer = device.createBuffer({
+        size: 64,
+        usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+    const bindGroup = device.createBindGroup({
+        layout: cachedStockSweepPipeline.getBindGroupLayout(0),
+        entries: [
+            { binding: 0, resource: { buffer: stock.stockBuffer } },
+            { binding: 1, resource: { buffer: toolBuffer } },
+            { binding: 2, resource: { buffer: pathBuffer } },
+            { binding: 3, resource: { buffer: uniformBuffer } },
+            { binding: 4, resource: { buffer: stock.dirtyBuffer } },
+        ],
+    });
 
-        if (memoryNeeded <= maxMemoryBytes) {
-            bestTileGridSize = mid;
-            low = mid + 1;
-        } else {
-            high = mid - 1;
+    for (let scanlineStart = 0; scanlineStart < numScanlines; scanlineStart += bandScanlines) {
+        const scanlineCount = Math.min(bandScanlines, numScanlines - scanlineStart);
+        const rowStart = Math.max(0, originY + scanlineStart * yStep + minYOffset);
+        const rowEnd = Math.min(stock.height, originY + (scanlineStart + scanlineCount - 1) * yStep + maxYOffset + 1);
+        if (rowEnd <= rowStart || originX + (pointsPerLine - 1) * xStep + maxXOffset < 0 || originX + minXOffset >= stock.width) {
+            continue;
         }
+
+        device.queue.writeBuffer(pathBuffer, 0, pathData, scanlineStart * pointsPerLine, scanlineCount * pointsPerLine);
+        const uniformData = new Uint32Array([
+            stock.width, stock.height, sparseToolData.count, xStep,
+            yStep, pointsPerLine, scanlineStart, scanlineCount,
+            0, 0, rowStart, rowEnd - rowStart,
+            STOCK_BAND_ROWS, 0, 0, 0
+        ]);
+        const uniformDataI32 = new Int32Array(uniformData.buffer);
+        uniformDataI32[8] = originX;
+        uniformDataI32[9] = originY;
+        device.queue.writeBuffer(uniformBuffer, 0, uniformData);
+
+        // Bands are submitted in order, so reusing the path and uniform buffers is safe
+        const commandEncoder = device.createCommandEncoder();
+        const passEncoder = commandEncoder.beginComputePass();
+        passEncoder.setPipeline(cachedStockSweepPipeline);
+        passEncoder.setBindGroup(0, bindGroup);
+        passEncoder.dispatchWorkgroups(Math.ceil(stock.width / 16), Math.ceil((rowEnd - rowStart) / 16));
+        passEncoder.end();
+        device.queue.submit([commandEncoder.finish()]);
     }
 
-    const tilesX = Math.ceil(globalGridWidth / bestTileGridSize);
-    const tilesY = Math.ceil(globalGridHeight / bestTileGridSize);
-    const coreGridWidth = Math.ceil(globalGridWidth / tilesX);
-    const coreGridHeight = Math.ceil(globalGridHeight / tilesY);
+    // Destroying after submit is safe: WebGPU keeps buffers alive until queued work using them completes
+    toolBuffer.destroy();
+    pathBuffer.destroy();
+    uniformBuffer.destroy();
+}
 
-    console.log(`[WebGPU Worker] Creating ${tilesX}×${tilesY} tiles (${coreGridWidth}×${coreGridHeight} cells core + ${toolOverlapX}×${toolOverlapY} cells overlap)`);
+// Read the stock back: only bands changed since the last read (dirtyOnly) or all of it.
+// Contiguous dirty bands are merged into one region. Returns { width, height, regions: [{rowStart, rowCount, heights}] }
+async function readStock(dirtyOnly = true) {
+    if (!residentStock) {
+        throw new Error('No stock. Call createStock first.');
+    }
+    const stock = residentStock;
 
-    const tiles = [];
-    for (let ty = 0; ty < tilesY; ty++) {
-        for (let tx = 0; tx < tilesX; tx++) {
-            // Core tile in grid coordinates
-            const coreGridStartX = tx * coreGridWidth;
-            const coreGridStartY = ty * coreGridHeight;
-            const coreGridEndX = Math.min((tx + 1) * coreGridWidth, globalGridWidth) - 1;
-            const coreGridEndY = Math.min((ty + 1) * coreGridHeight, globalGridHeight) - 1;
-
-            // Extended tile with overlap in grid coordinates
-            let extGridStartX = coreGridStartX;
-            let extGridStartY = coreGridStartY;
-            let extGridEndX = coreGridEndX;
-            let extGridEndY = coreGridEndY;
-
-            // Add overlap on sides that aren't at global boundary
-            if (tx > 0) extGridStartX -= toolOverlapX;
-            if (ty > 0) extGridStartY -= toolOverlapY;
-            if (tx < tilesX - 1) extGridEndX += toolOverlapX;
-            if (ty < tilesY - 1) extGridEndY += toolOverlapY;
-
-            // Clamp to global bounds
-            extGridStartX = Math.max(0, extGridStartX);
-            extGridStartY = Math.max(0, extGridStartY);
-            extGridEndX = Math.min(globalGridWidth - 1, extGridEndX);
-            extGridEndY = Math.min(globalGridHeight - 1, extGridEndY);
-
-            // Convert grid coordinates to world coordinates
-            const extMinX = bounds.min.x + extGridStartX * gridStep;
-            const extMinY = bounds.min.y + extGridStartY * gridStep;
-            const extMaxX = bounds.min.x + extGridEndX * gridStep;
-            const extMaxY = bounds.min.y + extGridEndY * gridStep;
-
-            const coreMinX = bounds.min.x + coreGridStartX * gridStep;
-            const coreMinY = bounds.min.y + coreGridStartY * gridStep;
-            const coreMaxX = bounds.min.x + coreGridEndX * gridStep;
-            const coreMaxY = bounds.min.y + coreGridEndY * gridStep;
+    const regions = [];
+    let band = 0;
+    while (band < stock.bandCount) {
+        if (dirtyOnly && !stock.dirtyBands[band]) {
+            band++;
+            continue;
+        }
+        const firstBand = band;
+        while (band < stock.bandCount && (!dirtyOnly || stock.dirtyBands[band])) {
+            band++;
+        }
+        const rowStart = firstBand * STOCK_BAND_ROWS;
+        const rowEnd = Math.min(stock.height, band * STOCK_BAND_ROWS);
+        regions.push({ rowStart, rowCount: rowEnd - rowStart });
+    }
 
-            tiles.push({
-                id: `tile_${tx}_${ty}`,
-                tx, ty,
-                tilesX, tilesY,
-                bounds: {
-                    min: { x: extMinX, y: extMinY, z: bounds.min.z },
-                    max: { x: extMaxX, y: extMaxY, z: bounds.max.z }
-                },
-                core: {
-                    gridStart: { x: coreGridStartX, y: coreGridStartY },
-                    gridEnd: { x: coreGridEndX, y: coreGridEndY },
-                    min: { x: coreMinX, y: coreMinY },
-                    max: { x: coreMaxX, y: coreMaxY }
-                }
+    if (regions.length > 0) {
+        const commandEncoder = device.createCommandEncoder();
+        const stagingBuffers = regions.map(region => {
+            const size = region.rowCount * stock.width * 4;
+            const stagingBuffer = device.createBuffer({
+                size,
+                usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
             });
+            commandEncoder.copyBufferToBuffer(stock.stockBuffer, region.rowStart * stock.width * 4, stagingBuffer, 0, size);
+            return stagingBuffer;
+        });
+        device.queue.submit([commandEncoder.finish()]);
+        for (let i = 0; i < regions.length; i++) {
+            regions[i].heights = await readStagingFloat32(stagingBuffers[i]);
         }
     }
 
-    return tiles;
+    stock.dirtyBands.fill(0);
+    return { width: stock.width, height: stock.height, regions };
 }
 
-// Stitch toolpath tiles together, dropping overlap regions (using integer grid coordinates)
-function stitchToolpathTiles(tileResults, globalBounds, gridStep, xStep, yStep) {
-    // Calculate global output dimensions
-    const globalWidth = Math.ceil((globalBounds.max.x - globalBounds.min.x) / gridStep) + 1;
-    const globalHeight = Math.ceil((globalBounds.max.y - globalBounds.min.y) / gridStep) + 1;
-    const globalPointsPerLine = Math.ceil(globalWidth / xStep);
-    const globalNumScanlines = Math.ceil(globalHeight / yStep);
+function disposeStock() {
+    if (residentStock) {
+        residentStock.stockBuffer.destroy();
+        residentStock.dirtyBuffer.destroy();
+        residentStock = null;
+    }
+}
 
-    console.log(`[WebGPU Worker] Stitching toolpath: global grid ${globalWidth}x${globalHeight}, output ${globalPointsPerLine}x${globalNumScanlines}`);
+// Streaming toolpath output
+// Chunks are produced one band (planar) or angle batch (radial) at a time as the consumer pulls,
+// so memory stays bounded by one chunk regardless of job size.
+// format 'gcode' emits UTF-8 G-code text; 'binary' emits raw little-endian Float32 rows in pathData
+// order, so concatenating the chunks reproduces pathData.
 
-    const result = new Float32Array(globalPointsPerLine * globalNumScanlines);
-    result.fill(NaN);
+function formatGcodeNumber(value, decimals) {
+    let text = value.toFixed(decimals);
+    if (text.includes('.')) {
+        text = text.replace(/\.?0+$/, '');
+    }
+    return text === '-0' ? '0' : text;
+}
 
-    // Fast path for 1x1 stepping: use bulk row copying
-    const use1x1FastPath = (xStep === 1 && yStep === 1);
+// Every scanline starts with its own retract, so the header only sets units, mode and feed
+function gcodeHeader(options) {
+    let text = '(raster-path toolpath)\nG21\nG90\n';
+    if (options.feedRate) {
+        text += `G1 F${formatGcodeNumber(options.feedRate, 1)}\n`;
+    }
+    return text;
+}
 
-    for (const tileResult of tileResults) {
-        const tile = tileResult.tile;
-        const tileData = tileResult.pathData;
+function gcodeFooter(options) {
+    return `G0 Z${formatGcodeNumber(options.safeZ, options.decimals)}\nM30\n`;
+}
 
-        // Use the pre-calculated integer grid coordinates from tile.core
-        const coreGridStartX = tile.core.gridStart.x;
-        const coreGridStartY = tile.core.gridStart.y;
-        const coreGridEndX = tile.core.gridEnd.x;
-        const coreGridEndY = tile.core.gridEnd.y;
+// One scanline as G-code: retract, rapid to the start, plunge, then feed through the points
+// xs/zs are sample indices and heights; a NaN height breaks the cut (retract, rapid to the next point)
+// prefix is the rapid positioning for the line (e.g. 'Y12.5' planar, 'A90' radial)
+function gcodeScanline(xs, zs, count, xOrigin, xSpacing, prefix, options) {
+    const { decimals } = options;
+    const safeZ = formatGcodeNumber(options.safeZ, decimals);
+    const lines = [];
+    let cutting = false;
+    for (let i = 0; i < count; i++) {
+        const z = zs[i];
+        if (Number.isNaN(z)) {
+            if (cutting) {
+                lines.push(`G0 Z${safeZ}`);
+                cutting = false;
+            }
+            continue;
+        }
+        const x = formatGcodeNumber(xOrigin + xs[i] * xSpacing, decimals);
+        const zText = formatGcodeNumber(z, decimals);
+        if (!cutting) {
+            lines.push(`G0 Z${safeZ}`, `G0 X${x} ${prefix}`, `G1 Z${zText}`);
+            cutting = true;
+        } else {
+            lines.push(`G1 X${x} Z${zText}`);
+        }
+    }
+    return lines.length > 0 ? lines.join('\n') + '\n' : '';
+}
 
-        // Calculate tile's extended grid coordinates
-        const extGridStartX = Math.round((tile.bounds.min.x - globalBounds.min.x) / gridStep);
-        const extGridStartY = Math.round((tile.bounds.min.y - globalBounds.min.y) / gridStep);
+function identityIndices(count) {
+    const indices = new Uint32Array(count);
+    for (let i = 0; i < count; i++) indices[i] = i;
+    return indices;
+}
 
-        let copiedCount = 0;
+// Planar stream: tiled toolpath bands of at most chunkScanlines scanlines, optionally simplified on the GPU
+async function* planarToolpathChunks(data, info) {
+    const { terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds } = data;
+    const format = data.format || 'gcode';
+    const chunkScanlines = data.chunkScanlines || 64;
+    const simplifyTolerance = format === 'gcode' ? (data.simplifyTolerance ?? null) : null;
+    const options = {
+        decimals: data.decimals ?? 3,
+        feedRate: data.feedRate ?? null,
+        safeZ: data.safeZ ?? terrainBounds.max.z + 5
+    };
 
-        // Calculate output coordinate ranges for this tile's core
-        // Core region in grid coordinates
-        const coreGridWidth = coreGridEndX - coreGridStartX + 1;
-        const coreGridHeight = coreGridEndY - coreGridStartY + 1;
+    const terrainMapData = createHeightMapFromPoints(terrainPositions, gridStep, terrainBounds);
+    const sparseToolData = createSparseToolFromPoints(toolPositions, gridStep);
+    const pointsPerLine = Math.ceil(terrainMapData.width / xStep);
+    const numScanlines = Math.ceil(terrainMapData.height / yStep);
+    info.numScanlines = numScanlines;
+    info.pointsPerLine = pointsPerLine;
 
-        // Core region in output coordinates (sampled by xStep/yStep)
-        const coreOutStartX = Math.floor(coreGridStartX / xStep);
-        const coreOutStartY = Math.floor(coreGridStartY / yStep);
-        const coreOutEndX = Math.floor(coreGridEndX / xStep);
-        const coreOutEndY = Math.floor(coreGridEndY / yStep);
-        const coreOutWidth = coreOutEndX - coreOutStartX + 1;
-        const coreOutHeight = coreOutEndY - coreOutStartY + 1;
+    const configuredLimit = config.maxGPUMemoryMB * 1024 * 1024;
+    const deviceLimit = deviceCapabilities.maxStorageBufferBindingSize;
+    const maxSafeSize = Math.min(configuredLimit, deviceLimit) * config.gpuMemorySafetyMargin;
+    const tiles = planToolpathTiles(terrainMapData, sparseToolData, xStep, yStep, maxSafeSize, chunkScanlines);
+
+    const maxTileScanlines = Math.max(...tiles.map(tile => tile.numScanlines));
+    const simplifiedTiles = simplifyTolerance !== null ? new Array(tiles.length) : null;
+    const tileJob = await beginToolpathTiles({
+        terrainMapData, sparseToolData, xStep, yStep, oobZ: zFloor, tiles,
+        pathData: new Float32Array(maxTileScanlines * pointsPerLine),
+        pathOriginY: 0,
+        consumeTile: simplifiedTiles ? simplifyTileConsumer(simplifiedTiles, simplifyTolerance) : null
+    });
 
-        // Tile's extended region start in grid coordinates
-        const extOutStartX = Math.floor(extGridStartX / xStep);
-        const extOutStartY = Math.floor(extGridStartY / yStep);
+    const encoder = new TextEncoder();
+    const xSpacing = xStep * gridStep;
+    const ySpacing = yStep * gridStep;
+    const denseIndices = identityIndices(pointsPerLine);
 
-        // Copy entire rows at once (works for all stepping values)
-        for (let outY = 0; outY < coreOutHeight; outY++) {
-            const globalOutY = coreOutStartY + outY;
-            const tileOutY = globalOutY - extOutStartY;
+    try {
+        if (format === 'gcode') {
+            yield encoder.encode(gcodeHeader(options));
+        }
 
-            if (globalOutY >= 0 && globalOutY < globalNumScanlines &&
-                tileOutY >= 0 && tileOutY < tileResult.numScanlines) {
+        for (let t = 0; t < tiles.length; t++) {
+            const tile = tiles[t];
+            tileJob.pathOriginY = tile.sampleOriginY;
+            await runToolpathTile(tileJob, t);
 
-                const globalRowStart = globalOutY * globalPointsPerLine + coreOutStartX;
-                const tileRowStart = tileOutY * tileResult.pointsPerLine + (coreOutStartX - extOutStartX);
+            if (format === 'binary') {
+                yield new Uint8Array(tileJob.pathData.slice(0, tile.numScanlines * pointsPerLine).buffer);
+                continue;
+            }
 
-                // Bulk copy entire row of output values
-                result.set(tileData.subarray(tileRowStart, tileRowStart + coreOutWidth), globalRowStart);
-                copiedCount += coreOutWidth;
+            let text = '';
+            for (let row = 0; row < tile.numScanlines; row++) {
+                const y = formatGcodeNumber(terrainMapData.minY + (tile.sampleOriginY + row) * ySpacing, options.decimals);
+                if (simplifiedTiles) {
+                    const part = simplifiedTiles[t];
+                    const start = part.lineOffsets[row];
+                    const count = part.lineOffsets[row + 1] - start;
+                    const xs = new Float32Array(count);
+                    const zs = new Float32Array(count);
+                    for (let v = 0; v < count; v++) {
+                        xs[v] = part.vertices[(start + v) * 2];
+                        zs[v] = part.vertices[(start + v) * 2 + 1];
+                    }
+                    text += gcodeScanline(xs, zs, count, terrainMapData.minX, xSpacing, `Y${y}`, options);
+                } else {
+                    const zs = tileJob.pathData.subarray(row * pointsPerLine, (row + 1) * pointsPerLine);
+                    text += gcodeScanline(denseIndices, zs, pointsPerLine, terrainMapData.minX, xSpacing, `Y${y}`, options);
+                }
+            }
+            if (simplifiedTiles) {
+                simplifiedTiles[t] = null;
             }
+            yield encoder.encode(text);
         }
 
-        console.log(`[WebGPU Worker]   Tile ${tile.id}: copied ${copiedCount} values`);
+        if (format === 'gcode') {
+            yield encoder.encode(gcodeFooter(options));
+        }
+    } finally {
+        endToolpathTiles(tileJob);
     }
+}
 
-    // Count how many output values are still NaN (gaps)
-    let nanCount = 0;
-    for (let i = 0; i < result.length; i++) {
-        if (isNaN(result[i])) nanCount++;
+// Radial stream: one chunk per batch of chunkAngles rotations, with A-axis words in G-code
+async function* radialToolpathChunks(data, info) {
+    const { triangles, toolPositions, xRotationStep, xStep, zFloor, gridStep, terrainBounds } = data;
+    const format = data.format || 'gcode';
+    const chunkAngles = data.chunkAngles || 8;
+
+    const angles = [];
+    for (let angle = 0; angle < 360; angle += xRotationStep) {
+        angles.push(angle);
     }
-    console.log(`[WebGPU Worker] Stitching complete: ${result.length} total values, ${nanCount} still NaN`);
+    info.numRotations = angles.length;
 
-    return {
-        pathData: result,
-        numScanlines: globalNumScanlines,
-        pointsPerLine: globalPointsPerLine,
-        generationTime: 0 // Sum from tiles if needed
+    // Default retract clears the part's largest radius about the X axis
+    const maxRadius = Math.max(
+        Math.abs(terrainBounds.min.y), Math.abs(terrainBounds.max.y),
+        Math.abs(terrainBounds.min.z), Math.abs(terrainBounds.max.z)
+    );
+    const options = {
+        decimals: data.decimals ?? 3,
+        feedRate: data.feedRate ?? null,
+        safeZ: data.safeZ ?? maxRadius + 5
     };
+
+    const encoder = new TextEncoder();
+    let denseIndices = null;
+    const job = await beginRadialJob({ triangles, toolPositions, xStep, zFloor, gridStep, terrainBounds });
+    try {
+        for (let start = 0; start < angles.length; start += chunkAngles) {
+            const batch = angles.slice(start, start + chunkAngles);
+            const batchResult = await runRadialJobAngles(job, batch);
+            const { xOrigin } = batchResult;
+            const scanlines = batch.map((angle, i) =>
+                batchResult.scanlines.subarray(i * batchResult.pointsPerLine, (i + 1) * batchResult.pointsPerLine));
+
+            if (!info.pointsPerLine) {
+                info.pointsPerLine = scanlines[0].length;
+            }
+
+            if (format === 'binary') {
+                yield new Uint8Array(batchResult.scanlines.buffer);
+                continue;
+            }
+
+            // The header rides with the first batch so pointsPerLine is known once the stream is started
+            let text = start === 0 ? gcodeHeader(options) : '';
+            batch.forEach((angle, i) => {
+                if (!denseIndices || denseIndices.length !== scanlines[i].length) {
+                    denseIndices = identityIndices(scanlines[i].length);
+                }
+                const a = formatGcodeNumber(angle, options.decimals);
+                text += gcodeScanline(denseIndices, scanlines[i], scanlines[i].length, xOrigin, xStep * gridStep, `A${a}`, options);
+            });
+            yield encoder.encode(text);
+        }
+
+        if (format === 'gcode') {
+            yield encoder.encode(gcodeFooter(options));
+        }
+    } finally {
+        endRadialJob(job);
+    }
 }
 
-function generateRadialScanline(data) {
-    const { stripPositions, stripBounds, toolPositions, xStep, zFloor, gridStep } = data;
-    const EMPTY_CELL = -1e10;
+// STL parsing
+// Chunks of any size are pushed as they arrive (a transferred file is one chunk). Binary records and ASCII
+// lines cut by a chunk boundary are carried into the next push, and bounds are accumulated in the same pass
+// so rasterization can skip calculateBounds.
 
-    // console.log('[WebGPU Worker] Generating radial scanline...');
-    // console.log(`[WebGPU Worker] Strip: ${stripPositions.length} cells, Tool: ${toolPositions.length/3} points, xStep: ${xStep}`);
+const STL_DETECT_BYTES = 512;
+const STL_ASCII_BYTES_PER_FACET = 200; // Initial ASCII allocation estimate when the file size is known
+const STL_POW10 = Array.from({ length: 23 }, (_, i) => Number('1e' + i)); // Exact doubles
 
-    // Create height map from strip (dense Z-only format)
-    const stripMap = createHeightMapFromPoints(stripPositions, gridStep, stripBounds);
-    // console.log(`[WebGPU Worker] Strip map: ${stripMap.width}x${stripMap.height}`);
+// byteLength (optional) is the total size when known up front; it caps the binary header's triangle count
+function createSTLParser(byteLength = 0) {
+    return {
+        byteLength,
+        format: null,
+        pending: null,
+        triangles: new Float32Array(0),
+        floatCount: 0,
+        headerRead: false,
+        headerTriangles: 0,
+        parsedTriangles: 0,
+        vertexCount: 0,
+        min: [Infinity, Infinity, Infinity],
+        max: [-Infinity, -Infinity, -Infinity],
+    };
+}
 
-    // Create sparse tool representation
-    const sparseTool = createSparseToolFromPoints(toolPositions, gridStep);
-    // console.log(`[WebGPU Worker] Sparse tool: ${sparseTool.count} points`);
+// Grow the triangle buffer geometrically so it can hold at least floatCount more floats
+function ensureSTLCapacity(parser, floatCount) {
+    const needed = parser.floatCount + floatCount;
+    if (needed <= parser.triangles.length) return;
+    const grown = new Float32Array(Math.max(needed, parser.triangles.length * 2, 9 * 1024));
+    grown.set(parser.triangles.subarray(0, parser.floatCount));
+    parser.triangles = grown;
+}
 
-    // Find center row (y=0 in world space)
-    const centerY = Math.round((0 - stripMap.minY) / gridStep);
+// ASCII files start with "solid", but so do some binary headers (even with "facet" in them). A file whose size
+// (byteLength, when known) is exactly 84 + 50 bytes per header triangle is binary; otherwise only text counts as
+// ASCII, and binary records (and the triangle count of fewer than 2^24) hold control bytes such as 0.
+function detectSTLFormat(bytes, byteLength = 0) {
+    if (byteLength && bytes.length >= 84) {
+        const count = new DataView(bytes.buffer, bytes.byteOffset, 84).getUint32(80, true);
+        if (84 + 50 * count === byteLength) return 'binary';
+    }
+    const head = bytes.subarray(0, STL_DETECT_BYTES);
+    if (!new TextDecoder().decode(head).trimStart().toLowerCase().startsWith('solid')) return 'binary';
+    for (const c of head) {
+        if (c < 9 || (c > 13 && c < 32) || c === 127) return 'binary';
+    }
+    return 'ascii';
+}
 
-    if (centerY < 0 || centerY >= stripMap.height) {
-        console.error(`[WebGPU Worker] Center row ${centerY} out of bounds [0, ${stripMap.height})`);
-        throw new Error('Center row out of strip bounds');
+function stlParserPush(parser, chunk) {
+    let bytes = chunk;
+    if (parser.pending) {
+        bytes = new Uint8Array(parser.pending.length + chunk.length);
+        bytes.set(parser.pending);
+        bytes.set(chunk, parser.pending.length);
+        parser.pending = null;
     }
 
-    // console.log(`[WebGPU Worker] Center row: ${centerY} (y=0)`);
+    if (!parser.format) {
+        if (bytes.length < STL_DETECT_BYTES && (!parser.byteLength || bytes.length < parser.byteLength)) {
+            parser.pending = bytes;
+            return;
+        }
+        parser.format = detectSTLFormat(bytes, parser.byteLength);
+        if (parser.format === 'ascii' && parser.byteLength) {
+            ensureSTLCapacity(parser, Math.ceil(parser.byteLength / STL_ASCII_BYTES_PER_FACET) * 9);
+        }
+    }
 
-    // Calculate output dimensions
-    const outputWidth = Math.ceil(stripMap.width / xStep);
-    const scanline = new Float32Array(outputWidth);
+    const consumed = parser.format === 'ascii' ? parseASCIISTLChunk(parser, bytes, false) : parseBinarySTLChunk(parser, bytes);
+    if (consumed < bytes.length) {
+        parser.pending = bytes.slice(consumed);
+    }
+}
 
-    // Process each output position along X-axis
-    for (let outX = 0; outX < outputWidth; outX++) {
-        const gridX = outX * xStep;
+// Parse whole 50-byte records (normal skipped) into the triangle buffer; returns the number of bytes consumed
+function parseBinarySTLChunk(parser, bytes) {
+    let offset = 0;
+    if (!parser.headerRead) {
+        if (bytes.length < 84) return 0;
+        parser.headerRead = true;
+        let count = new DataView(bytes.buffer, bytes.byteOffset, 84).getUint32(80, true);
+        if (parser.byteLength) {
+            count = Math.min(count, Math.floor((parser.byteLength - 84) / 50));
+        }
+        parser.headerTriangles = count;
+        // Without a known size the header count is not trusted for the initial allocation
+        ensureSTLCapacity(parser, (parser.byteLength ? count : Math.min(count, 1 << 20)) * 9);
+        offset = 84;
+    }
 
-        if (gridX >= stripMap.width) break;
+    const records = Math.min(Math.floor((bytes.length - offset) / 50), parser.headerTriangles - parser.parsedTriangles);
+    if (records <= 0) return parser.parsedTriangles >= parser.headerTriangles ? bytes.length : offset;
+    ensureSTLCapacity(parser, records * 9);
+
+    const out = parser.triangles;
+    let f = parser.floatCount;
+    let [minX, minY, minZ] = parser.min;
+    let [maxX, maxY, maxZ] = parser.max;
+
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    for (let i = 0; i < records; i++) {
+        let o = offset + i * 50 + 12;
+        for (let k = 0; k < 3; k++) {
+            const x = view.getFloat32(o, true), y = view.getFloat32(o + 4, true), z = view.getFloat32(o + 8, true);
+            out[f++] = x;
+            out[f++] = y;
+            out[f++] = z;
+            if (x < minX) minX = x;
+            if (x > maxX) maxX = x;
+            if (y < minY) minY = y;
+            if (y > maxY) maxY = y;
+            if (z < minZ) minZ = z;
+            if (z > maxZ) maxZ = z;
+            o += 12;
+        }
+    }
 
-        // Find maximum tool-terrain collision
-        // Note: Don't skip if center is empty - tool edges might still touch terrain
-        let maxZ = zFloor;
+    parser.floatCount = f;
+    parser.parsedTriangles += records;
+    parser.min = [minX, minY, minZ];
+    parser.max = [maxX, maxY, maxZ];
+    return parser.parsedTriangles >= parser.headerTriangles ? bytes.length : offset + records * 50;
+}
 
-        for (let i = 0; i < sparseTool.count; i++) {
-            const toolOffsetX = sparseTool.xOffsets[i];
-            const toolOffsetY = sparseTool.yOffsets[i];
-            const toolZ = sparseTool.zValues[i];
+function isSTLSpace(c) {
+    return c === 32 || c === 9 || c === 10 || c === 13;
+}
 
-            // Calculate terrain lookup position
-            const terrainGridX = gridX + toolOffsetX;
-            const terrainGridY = centerY + toolOffsetY;
+// Parse a decimal float at bytes[i] straight into out[index]; returns the index after the token
+// Digits past the 17th only shift the exponent, far below float32 precision. Tokens the fast path does not
+// cover (nan, inf) fall back to parseFloat.
+function parseASCIIFloat(bytes, i, end, out, index) {
+    const start = i;
+    let negative = false;
+    if (bytes[i] === 45 || bytes[i] === 43) { // - +
+        negative = bytes[i] === 45;
+        i++;
+    }
 
-            // Check bounds
-            if (terrainGridX < 0 || terrainGridX >= stripMap.width ||
-                terrainGridY < 0 || terrainGridY >= stripMap.height) {
-                continue;
+    let mantissa = 0, digits = 0, exponent = 0, c;
+    while (i < end && (c = bytes[i]) >= 48 && c <= 57) {
+        if (digits < 17) {
+            mantissa = mantissa * 10 + (c - 48);
+            if (mantissa > 0) digits++;
+        } else {
+            exponent++;
+        }
+        i++;
+    }
+    let seenDigits = i > start + (negative || bytes[start] === 43 ? 1 : 0);
+    if (i < end && bytes[i] === 46) { // .
+        i++;
+        while (i < end && (c = bytes[i]) >= 48 && c <= 57) {
+            if (digits < 17) {
+                mantissa = mantissa * 10 + (c - 48);
+                if (mantissa > 0) digits++;
+                exponent--;
             }
+            seenDigits = true;
+            i++;
+        }
+    }
+    if (seenDigits && i < end && (bytes[i] | 32) === 101) { // e E
+        i++;
+        let expNegative = false;
+        if (bytes[i] === 45 || bytes[i] === 43) {
+            expNegative = bytes[i] === 45;
+            i++;
+        }
+        let e = 0;
+        while (i < end && (c = bytes[i]) >= 48 && c <= 57) {
+            e = e * 10 + (c - 48);
+            i++;
+        }
+        exponent += expNegative ? -e : e;
+    }
 
-            // Get terrain height at this position
-            const idx = terrainGridY * stripMap.width + terrainGridX;
-            const terrainHeight = stripMap.grid[idx];
+    if (!seenDigits || (i < end && !isSTLSpace(bytes[i]))) {
+        while (i < end && !isSTLSpace(bytes[i])) i++;
+        out[index] = parseFloat(String.fromCharCode.apply(null, bytes.subarray(start, i)));
+        return i;
+    }
 
-            if (terrainHeight === EMPTY_CELL) continue;
+    let value;
+    if (exponent < 0) {
+        value = exponent >= -22 ? mantissa / STL_POW10[-exponent] : mantissa / Math.pow(10, -exponent);
+    } else {
+        value = exponent <= 22 ? mantissa * STL_POW10[exponent] : mantissa * Math.pow(10, exponent);
+    }
+    out[index] = negative ? -value : value;
+    return i;
+}
 
-            // Calculate tool center Z needed to just touch terrain
-            const toolCenterZ = terrainHeight - toolZ;
-            maxZ = Math.max(maxZ, toolCenterZ);
+// Scan complete lines byte by byte (no strings): every three vertex lines form a triangle. The last partial
+// line is left unconsumed and carried into the next chunk; returns the number of bytes consumed.
+function parseASCIISTLChunk(parser, bytes, final) {
+    const end = final ? bytes.length : bytes.lastIndexOf(10) + 1;
+    let out = parser.triangles;
+    let f = parser.floatCount;
+    let [minX, minY, minZ] = parser.min;
+    let [maxX, maxY, maxZ] = parser.max;
+
+    let i = 0;
+    while (i < end) {
+        const c = bytes[i];
+        if (isSTLSpace(c)) {
+            i++;
+            continue;
         }
 
-        scanline[outX] = maxZ;
+        // "vertex" as the first token of the line
+        if (c === 118 && i + 6 < end && bytes[i + 1] === 101 && bytes[i + 2] === 114 && bytes[i + 3] === 116 &&
+            bytes[i + 4] === 101 && bytes[i + 5] === 120 && isSTLSpace(bytes[i + 6])) {
+            i += 6;
+            if (f + 3 > out.length) {
+                parser.floatCount = f;
+                ensureSTLCapacity(parser, 3);
+                out = parser.triangles;
+            }
+            for (let k = 0; k < 3; k++) {
+                while (i < end && (bytes[i] === 32 || bytes[i] === 9)) i++;
+                i = parseASCIIFloat(bytes, i, end, out, f + k);
+            }
+            const x = out[f], y = out[f + 1], z = out[f + 2];
+            if (x < minX) minX = x;
+            if (x > maxX) maxX = x;
+            if (y < minY) minY = y;
+            if (y > maxY) maxY = y;
+            if (z < minZ) minZ = z;
+            if (z > maxZ) maxZ = z;
+            f += 3;
+            parser.vertexCount++;
+        }
+
+        while (i < end && bytes[i] !== 10) i++;
     }
 
-    // console.log(`[WebGPU Worker] ✅ Radial scanline complete: ${outputWidth} points`);
-    // console.log(`[WebGPU Worker] First 10 values: ${Array.from(scanline.slice(0, 10)).map(v => v.toFixed(2)).join(',')}`);
+    parser.floatCount = f;
+    parser.min = [minX, minY, minZ];
+    parser.max = [maxX, maxY, maxZ];
+    return end;
+}
+
+// Flush carried bytes and return {triangles, triangleCount, bounds}
+function stlParserFinish(parser) {
+    const rest = parser.pending || new Uint8Array(0);
+    parser.pending = null;
+    if (!parser.format) {
+        parser.format = detectSTLFormat(rest, parser.byteLength || rest.length);
+    }
+    if (parser.format === 'ascii') {
+        parseASCIISTLChunk(parser, rest, true);
+        // Drop a trailing incomplete triangle
+        parser.floatCount = Math.floor(parser.vertexCount / 3) * 9;
+    } else {
+        parseBinarySTLChunk(parser, rest);
+    }
 
+    const triangles = parser.floatCount === parser.triangles.length
+        ? parser.triangles
+        : parser.triangles.slice(0, parser.floatCount);
     return {
-        scanline
+        triangles,
+        triangleCount: triangles.length / 9,
+        bounds: {
+            min: { x: parser.min[0], y: parser.min[1], z: parser.min[2] },
+            max: { x: parser.max[0], y: parser.max[1], z: parser.max[2] }
+        }
     };
 }
 
+// Replies of requests whose caller waits on them. A request that throws is answered there with {error}
+// (and its stream or job id), so the caller's promise rejects instead of waiting on the generic 'error' message.
+const ERROR_REPLY_TYPES = {
+    'generate-toolpath': 'toolpath-complete',
+    'toolpath-tiles-begin': 'toolpath-tiles-ready',
+    'toolpath-tile': 'toolpath-tile-complete',
+    'radial-job-begin': 'radial-job-ready',
+    'radial-job-angles': 'radial-job-scanlines',
+    'radial-job-adaptive': 'radial-job-adaptive-complete',
+    'stock-create': 'stock-ready',
+    'stock-simulate': 'stock-simulated',
+    'stock-read': 'stock-data',
+    'terrain-load': 'terrain-loaded',
+    'tool-z-query': 'tool-z-result',
+    'generate-zlevel-roughing': 'zlevel-roughing-complete',
+    'generate-pattern-toolpath': 'pattern-toolpath-complete',
+    'cylinder-map-create': 'cylinder-map-ready',
+    'cylinder-toolpath': 'cylinder-toolpath-complete',
+    'cylinder-radial-toolpath': 'cylinder-toolpath-complete',
+};
+
 // Handle messages from main thread
 self.onmessage = async function(e) {
     const { type, data } = e.data;
@@ -1723,15 +6412,344 @@ self.onmessage = async function(e) {
                 }, [rasterResult.positions.buffer]);
                 break;
 
+            case 'stl-parse-begin':
+                stlParsers.set(data.streamId, createSTLParser(data.byteLength));
+                break;
+
+            case 'stl-parse-chunk':
+                // Chunks get no reply: a failure is kept on the parser and reported when the parse ends
+                const chunkParser = stlParsers.get(data.streamId);
+                if (chunkParser && !chunkParser.error) {
+                    try {
+                        stlParserPush(chunkParser, data.chunk);
+                    } catch (error) {
+                        chunkParser.error = error.message;
+                    }
+                }
+                break;
+
+            case 'stl-parse-cancel':
+                stlParsers.delete(data.streamId);
+                break;
+
+            case 'stl-parse-end':
+                const endParser = stlParsers.get(data.streamId);
+                stlParsers.delete(data.streamId);
+                const stlResponseType = data.rasterize ? 'rasterize-complete' : 'stl-parsed';
+                try {
+                    if (!endParser) {
+                        throw new Error('STL parse is not open');
+                    }
+                    if (endParser.error) {
+                        throw new Error(endParser.error);
+                    }
+                    const parsedSTL = stlParserFinish(endParser);
+                    if (data.rasterize) {
+                        // Parsed bounds stand in for calculateBounds ahead of binning and upload
+                        const { stepSize: stlStep, filterMode: stlFilter, boundsOverride: stlBounds } = data.rasterize;
+                        const stlRasterResult = await rasterizeMesh(parsedSTL.triangles, stlStep, stlFilter,
+                            stlBounds ? { ...stlBounds } : { meshBounds: parsedSTL.bounds });
+                        self.postMessage({
+                            type: stlResponseType,
+                            data: { ...stlRasterResult, streamId: data.streamId }
+                        }, [stlRasterResult.positions.buffer]);
+                    } else {
+                        self.postMessage({
+                            type: stlResponseType,
+                            data: { ...parsedSTL, streamId: data.streamId }
+                        }, [parsedSTL.triangles.buffer]);
+                    }
+                } catch (error) {
+                    self.postMessage({ type: stlResponseType, data: { streamId: data.streamId, error: error.message } });
+                }
+                break;
+
             case 'generate-toolpath':
-                const { terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds } = data;
+                const { terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds, shareTiles, simplifyTolerance, rest, rasterAngle } = data;
                 const toolpathResult = await generateToolpath(
-                    terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds
+                    terrainPositions, toolPositions, xStep, yStep, zFloor, gridStep, terrainBounds,
+                    { shareTiles, simplifyTolerance: simplifyTolerance ?? null, rest: rest ?? null, rasterAngle: rasterAngle ?? null }
                 );
+                // Shared tile jobs are backed by SharedArrayBuffers, which are shared rather than transferred
+                let toolpathTransfers = [];
+                if (toolpathResult.passes) {
+                    toolpathTransfers = toolpathResult.passes.map(pass => pass.pathData.buffer);
+                } else if (toolpathResult.vertices) {
+                    toolpathTransfers = [toolpathResult.vertices.buffer, toolpathResult.lineOffsets.buffer];
+                } else if (!toolpathResult.tiledJob) {
+                    toolpathTransfers = [toolpathResult.pathData.buffer];
+                }
                 self.postMessage({
                     type: 'toolpath-complete',
                     data: toolpathResult
-                }, [toolpathResult.pathData.buffer]);
+                }, toolpathTransfers);
+                break;
+
+            case 'toolpath-tiles-begin':
+                toolpathTileJobs.set(data.jobId, await beginToolpathTiles(data, true));
+                self.postMessage({ type: 'toolpath-tiles-ready', data: { jobId: data.jobId } });
+                break;
+
+            case 'toolpath-tile':
+                const tileJob = toolpathTileJobs.get(data.jobId);
+                if (!tileJob) {
+                    throw new Error('Toolpath tile job is not open');
+                }
+                const tileTime = await runToolpathTile(tileJob, data.tileIndex);
+                self.postMessage({
+                    type: 'toolpath-tile-complete',
+                    data: { jobId: data.jobId, tileIndex: data.tileIndex, tileTime }
+                });
+                break;
+
+            case 'toolpath-tiles-end':
+                const endedTileJob = toolpathTileJobs.get(data.jobId);
+                if (endedTileJob) {
+                    toolpathTileJobs.delete(data.jobId);
+                    endToolpathTiles(endedTileJob);
+                }
+                break;
+
+            case 'generate-toolpath-batch':
+                const batchResult = await generateToolpathBatch(
+                    data.terrainPositions, data.tools, data.gridStep, data.terrainBounds
+                );
+                // Results may share one buffer (single dispatch) or own separate ones (fallback)
+                const batchTransfers = [...new Set(batchResult.results.map(r => r.pathData.buffer))];
+                self.postMessage({
+                    type: 'toolpath-batch-complete',
+                    data: batchResult
+                }, batchTransfers);
+                break;
+
+            case 'generate-toolpath-from-mesh':
+                const meshToolpathResult = await generateToolpathFromMesh(
+                    data.triangles, data.toolPositions, data.xStep, data.yStep, data.zFloor, data.gridStep,
+                    { terrainBounds: data.terrainBounds, returnHeightmap: data.returnHeightmap }
+                );
+                const meshToolpathTransfers = [meshToolpathResult.pathData.buffer];
+                if (meshToolpathResult.terrain) {
+                    meshToolpathTransfers.push(meshToolpathResult.terrain.positions.buffer);
+                }
+                self.postMessage({
+                    type: 'toolpath-from-mesh-complete',
+                    data: meshToolpathResult
+                }, meshToolpathTransfers);
+                break;
+
+            case 'generate-zlevel-roughing':
+                const roughingResult = await generateZLevelRoughing(
+                    data.terrainPositions, data.toolPositions, data.xStep, data.yStep, data.gridStep,
+                    data.zLevels, data.terrainBounds, data.allowance ?? 0
+                );
+                self.postMessage({
+                    type: 'zlevel-roughing-complete',
+                    data: roughingResult
+                }, [roughingResult.segments.buffer, roughingResult.segmentOffsets.buffer, roughingResult.zLevels.buffer]);
+                break;
+
+            case 'generate-adaptive-toolpath':
+                const adaptiveResult = await generateToolpathAdaptive(
+                    data.terrainPositions, data.toolPositions, data.xStep, data.yStep, data.zFloor, data.gridStep,
+                    data.terrainBounds, data.tolerance, data.coarseStride
+                );
+                self.postMessage({
+                    type: 'adaptive-toolpath-complete',
+                    data: adaptiveResult
+                }, [adaptiveResult.vertices.buffer, adaptiveResult.lineOffsets.buffer]);
+                break;
+
+            case 'stock-create':
+                const stockInfo = await createStock(data.bounds, data.gridStep, data.options || {});
+                self.postMessage({ type: 'stock-ready', data: stockInfo });
+                break;
+
+            case 'stock-simulate':
+                const simulateResult = await simulateStockToolpath(
+                    data.pathData, data.numScanlines, data.pointsPerLine, data.toolPositions,
+                    data.xStep, data.yStep, data.pathOrigin
+                );
+                self.postMessage({ type: 'stock-simulated', data: simulateResult });
+                break;
+
+            case 'stock-read':
+                const stockData = await readStock(data.dirtyOnly ?? true);
+                self.postMessage({
+                    type: 'stock-data',
+                    data: stockData
+                }, stockData.regions.map(region => region.heights.buffer));
+                break;
+
+            case 'stock-dispose':
+                disposeStock();
+                break;
+
+            case 'offset-surface-create':
+                const offsetSurfaceInfo = await createOffsetSurface(
+                    data.terrainPositions, data.toolPositions, data.gridStep, data.terrainBounds, data.zFloor
+                );
+                self.postMessage({ type: 'offset-surface-ready', data: offsetSurfaceInfo });
+                break;
+
+            case 'offset-surface-sample':
+                const offsetSamples = await sampleOffsetSurface(data.pattern);
+                self.postMessage({
+                    type: 'offset-surface-samples',
+                    data: offsetSamples
+                }, [(offsetSamples.pathData || offsetSamples.z).buffer]);
+                break;
+
+            case 'offset-surface-dispose':
+                disposeOffsetSurface();
+                break;
+
+            case 'terrain-load':
+                const terrainInfo = await loadTerrain(data.terrainPositions, data.gridStep, data.terrainBounds);
+                self.postMessage({ type: 'terrain-loaded', data: terrainInfo });
+                break;
+
+            case 'tool-z-query':
+                const toolZResult = await queryToolZ(data.queries, data.toolPositions, data.zFloor, data.options || {});
+                self.postMessage({
+                    type: 'tool-z-result',
+                    data: toolZResult
+                }, toolZResult.z ? [toolZResult.z.buffer] : toolZResult.polylines.map(polyline => polyline.buffer));
+                break;
+
+            case 'generate-pattern-toolpath':
+                const patternResult = await generatePatternToolpath(data.pattern, data.toolPositions, data.zFloor);
+                self.postMessage({
+                    type: 'pattern-toolpath-complete',
+                    data: patternResult
+                }, patternResult.polylines.map(polyline => polyline.buffer));
+                break;
+
+            case 'terrain-dispose':
+                disposeTerrain();
+                break;
+
+            case 'toolpath-stream-start':
+                // Streams are independent: each has its own id and chunk iterator
+                const streamInfo = { streamId: data.streamId };
+                const streamChunks = data.mode === 'radial'
+                    ? radialToolpathChunks(data, streamInfo)
+                    : planarToolpathChunks(data, streamInfo);
+                // Produce the first chunk now so setup errors surface on start and the dimensions are known
+                try {
+                    streamChunks.pending = await streamChunks.next();
+                    toolpathStreams.set(data.streamId, streamChunks);
+                } catch (error) {
+                    streamInfo.error = error.message;
+                }
+                self.postMessage({ type: 'toolpath-stream-ready', data: streamInfo });
+                break;
+
+            case 'toolpath-stream-pull':
+                const pulledStream = toolpathStreams.get(data.streamId);
+                let streamStep;
+                try {
+                    if (!pulledStream) {
+                        streamStep = { done: true, error: 'Toolpath stream is not open' };
+                    } else if (pulledStream.pending) {
+                        streamStep = pulledStream.pending;
+                        pulledStream.pending = null;
+                    } else {
+                        streamStep = await pulledStream.next();
+                    }
+                } catch (error) {
+                    streamStep = { done: true, error: error.message };
+                }
+                if (streamStep.done) {
+                    toolpathStreams.delete(data.streamId);
+                }
+                self.postMessage({
+                    type: 'toolpath-stream-chunk',
+                    data: { streamId: data.streamId, chunk: streamStep.value || null, done: !!streamStep.done, error: streamStep.error }
+                }, streamStep.value ? [streamStep.value.buffer] : []);
+                break;
+
+            case 'toolpath-stream-cancel':
+                const cancelledStream = toolpathStreams.get(data.streamId);
+                if (cancelledStream) {
+                    toolpathStreams.delete(data.streamId);
+                    await cancelledStream.return();
+                }
+                break;
+
+            case 'radial-job-begin':
+                const radialJob = await beginRadialJob(data);
+                // Shared jobs write their rows straight into the caller's pathData (SharedArrayBuffer)
+                radialJob.pathData = data.pathData || null;
+                radialJobs.set(data.jobId, radialJob);
+                self.postMessage({ type: 'radial-job-ready', data: { jobId: data.jobId, pointsPerLine: radialJob.pointsPerLine } });
+                break;
+
+            case 'radial-job-angles':
+                const anglesJob = radialJobs.get(data.jobId);
+                if (!anglesJob) {
+                    throw new Error('Radial job is not open');
+                }
+                const radialScanlines = await runRadialJobAngles(anglesJob, data.angles);
+                if (anglesJob.pathData) {
+                    anglesJob.pathData.set(radialScanlines.scanlines, data.firstRow * radialScanlines.pointsPerLine);
+                    self.postMessage({
+                        type: 'radial-job-scanlines',
+                        data: { jobId: data.jobId, pointsPerLine: radialScanlines.pointsPerLine, firstRow: data.firstRow, rowCount: data.angles.length }
+                    });
+                } else {
+                    self.postMessage({
+                        type: 'radial-job-scanlines',
+                        data: { ...radialScanlines, jobId: data.jobId }
+                    }, [radialScanlines.scanlines.buffer]);
+                }
+                break;
+
+            case 'radial-job-adaptive':
+                const adaptiveJob = radialJobs.get(data.jobId);
+                if (!adaptiveJob) {
+                    throw new Error('Radial job is not open');
+                }
+                const adaptiveRadialResult = await runRadialJobAdaptive(adaptiveJob, data.coarseStep, data.minStep, data.tolerance);
+                self.postMessage({
+                    type: 'radial-job-adaptive-complete',
+                    data: { ...adaptiveRadialResult, jobId: data.jobId }
+                }, [adaptiveRadialResult.pathData.buffer, adaptiveRadialResult.angles.buffer]);
+                break;
+
+            case 'radial-job-end':
+                const endedRadialJob = radialJobs.get(data.jobId);
+                if (endedRadialJob) {
+                    radialJobs.delete(data.jobId);
+                    endRadialJob(endedRadialJob);
+                }
+                break;
+
+            case 'cylinder-map-create':
+                const cylinderInfo = await createCylinderMap(data.triangles, data.gridStep, data.terrainBounds, data.options || {});
+                self.postMessage({ type: 'cylinder-map-ready', data: cylinderInfo });
+                break;
+
+            case 'cylinder-toolpath':
+                const cylinderResult = await generateCylindricalToolpath(data.toolPositions, data.xRotationStep, data.xStep, data.zFloor, data.options || {});
+                self.postMessage({
+                    type: 'cylinder-toolpath-complete',
+                    data: cylinderResult
+                }, [cylinderResult.pathData.buffer]);
+                break;
+
+            case 'cylinder-map-dispose':
+                disposeCylinderMap();
+                break;
+
+            case 'cylinder-radial-toolpath':
+                const cylinderJobResult = await generateCylindricalRadialToolpath(
+                    data.triangles, data.toolPositions, data.xRotationStep, data.xStep, data.zFloor,
+                    data.gridStep, data.terrainBounds, data.options || {}
+                );
+                self.postMessage({
+                    type: 'cylinder-toolpath-complete',
+                    data: cylinderJobResult
+                }, [cylinderJobResult.pathData.buffer]);
                 break;
 
             case 'generate-radial-scanline':
@@ -1750,6 +6768,13 @@ self.onmessage = async function(e) {
         }
     } catch (error) {
         console.error('[WebGPU Worker] Error:', error);
+        if (ERROR_REPLY_TYPES[type]) {
+            self.postMessage({
+                type: ERROR_REPLY_TYPES[type],
+                data: { error: error.message, streamId: data?.streamId, jobId: data?.jobId }
+            });
+            return;
+        }
         self.postMessage({
             type: 'error',
             message: error.message,